@@ -4,6 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 O_SRCS += \
+../microsim/output/MSBinaryRawOut.o \
 ../microsim/output/MSDetectorControl.o \
 ../microsim/output/MSE2Collector.o \
 ../microsim/output/MSE3Collector.o \
@@ -19,6 +20,7 @@ O_SRCS += \
 ../microsim/output/MS_E2_ZS_CollectorOverLanes.o 
 
 CPP_SRCS += \
+../microsim/output/MSBinaryRawOut.cpp \
 ../microsim/output/MSDetectorControl.cpp \
 ../microsim/output/MSE2Collector.cpp \
 ../microsim/output/MSE3Collector.cpp \
@@ -34,6 +36,7 @@ CPP_SRCS += \
 ../microsim/output/MS_E2_ZS_CollectorOverLanes.cpp 
 
 OBJS += \
+./microsim/output/MSBinaryRawOut.o \
 ./microsim/output/MSDetectorControl.o \
 ./microsim/output/MSE2Collector.o \
 ./microsim/output/MSE3Collector.o \
@@ -49,6 +52,7 @@ OBJS += \
 ./microsim/output/MS_E2_ZS_CollectorOverLanes.o 
 
 CPP_DEPS += \
+./microsim/output/MSBinaryRawOut.d \
 ./microsim/output/MSDetectorControl.d \
 ./microsim/output/MSE2Collector.d \
 ./microsim/output/MSE3Collector.d \
@@ -4,6 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 O_SRCS += \
+../microsim/MSBinaryRouteLoader.o \
 ../microsim/MSCFModel.o \
 ../microsim/MSCORN.o \
 ../microsim/MSEdge.o \
@@ -16,6 +17,7 @@ O_SRCS += \
 ../microsim/MSInternalJunction.o \
 ../microsim/MSInternalLane.o \
 ../microsim/MSJunction.o \
+../microsim/MSKinematicStore.o \
 ../microsim/MSJunctionControl.o \
 ../microsim/MSJunctionLogic.o \
 ../microsim/MSLCM_DK2004.o \
@@ -34,6 +36,8 @@ O_SRCS += \
 ../microsim/MSRouteHandler.o \
 ../microsim/MSRouteLoader.o \
 ../microsim/MSRouteLoaderControl.o \
+../microsim/MSStepProfiler.o \
+../microsim/MSScenarioFork.o \
 ../microsim/MSStrip.o \
 ../microsim/MSStripChanger.o \
 ../microsim/MSVehicle.o \
@@ -43,6 +47,7 @@ O_SRCS += \
 ../microsim/MSVehicleType.o 
 
 CPP_SRCS += \
+../microsim/MSBinaryRouteLoader.cpp \
 ../microsim/MSCFModel.cpp \
 ../microsim/MSCORN.cpp \
 ../microsim/MSEdge.cpp \
@@ -55,6 +60,7 @@ CPP_SRCS += \
 ../microsim/MSInternalJunction.cpp \
 ../microsim/MSInternalLane.cpp \
 ../microsim/MSJunction.cpp \
+../microsim/MSKinematicStore.cpp \
 ../microsim/MSJunctionControl.cpp \
 ../microsim/MSJunctionLogic.cpp \
 ../microsim/MSLCM_DK2004.cpp \
@@ -73,6 +79,8 @@ CPP_SRCS += \
 ../microsim/MSRouteHandler.cpp \
 ../microsim/MSRouteLoader.cpp \
 ../microsim/MSRouteLoaderControl.cpp \
+../microsim/MSStepProfiler.cpp \
+../microsim/MSScenarioFork.cpp \
 ../microsim/MSStrip.cpp \
 ../microsim/MSStripChanger.cpp \
 ../microsim/MSVehicle.cpp \
@@ -82,6 +90,7 @@ CPP_SRCS += \
 ../microsim/MSVehicleType.cpp 
 
 OBJS += \
+./microsim/MSBinaryRouteLoader.o \
 ./microsim/MSCFModel.o \
 ./microsim/MSCORN.o \
 ./microsim/MSEdge.o \
@@ -94,6 +103,7 @@ OBJS += \
 ./microsim/MSInternalJunction.o \
 ./microsim/MSInternalLane.o \
 ./microsim/MSJunction.o \
+./microsim/MSKinematicStore.o \
 ./microsim/MSJunctionControl.o \
 ./microsim/MSJunctionLogic.o \
 ./microsim/MSLCM_DK2004.o \
@@ -112,6 +122,8 @@ OBJS += \
 ./microsim/MSRouteHandler.o \
 ./microsim/MSRouteLoader.o \
 ./microsim/MSRouteLoaderControl.o \
+./microsim/MSStepProfiler.o \
+./microsim/MSScenarioFork.o \
 ./microsim/MSStrip.o \
 ./microsim/MSStripChanger.o \
 ./microsim/MSVehicle.o \
@@ -121,6 +133,7 @@ OBJS += \
 ./microsim/MSVehicleType.o 
 
 CPP_DEPS += \
+./microsim/MSBinaryRouteLoader.d \
 ./microsim/MSCFModel.d \
 ./microsim/MSCORN.d \
 ./microsim/MSEdge.d \
@@ -133,6 +146,7 @@ CPP_DEPS += \
 ./microsim/MSInternalJunction.d \
 ./microsim/MSInternalLane.d \
 ./microsim/MSJunction.d \
+./microsim/MSKinematicStore.d \
 ./microsim/MSJunctionControl.d \
 ./microsim/MSJunctionLogic.d \
 ./microsim/MSLCM_DK2004.d \
@@ -151,6 +165,8 @@ CPP_DEPS += \
 ./microsim/MSRouteHandler.d \
 ./microsim/MSRouteLoader.d \
 ./microsim/MSRouteLoaderControl.d \
+./microsim/MSStepProfiler.d \
+./microsim/MSScenarioFork.d \
 ./microsim/MSStrip.d \
 ./microsim/MSStripChanger.d \
 ./microsim/MSVehicle.d \
@@ -4,5 +4,7 @@
 
 USER_OBJS :=
 
-LIBS := -lFOX-1.6 -lGLU -lxerces-c-3.1 -lxerces-c
+LIBS := -lFOX-1.6 -lGLU -lxerces-c-3.1 -lxerces-c -lpthread
+
+SUMO_LIBS := -lxerces-c-3.1 -lxerces-c -lpthread
 
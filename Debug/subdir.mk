@@ -4,13 +4,21 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../guisim_main.cpp 
+../benchmark_main.cpp \
+../guisim_main.cpp \
+../netstate2xml_main.cpp \
+../route2bin_main.cpp \
+../sumo_main.cpp 
 
 OBJS += \
 ./guisim_main.o 
 
 CPP_DEPS += \
-./guisim_main.d 
+./benchmark_main.d \
+./guisim_main.d \
+./netstate2xml_main.d \
+./route2bin_main.d \
+./sumo_main.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
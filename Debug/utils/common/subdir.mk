@@ -35,7 +35,8 @@ CPP_SRCS += \
 ../utils/common/StringTokenizer.cpp \
 ../utils/common/StringUtils.cpp \
 ../utils/common/SysUtils.cpp \
-../utils/common/SystemFrame.cpp 
+../utils/common/SystemFrame.cpp \
+../utils/common/WorkerPool.cpp 
 
 OBJS += \
 ./utils/common/FileHelpers.o \
@@ -52,7 +53,8 @@ OBJS += \
 ./utils/common/StringTokenizer.o \
 ./utils/common/StringUtils.o \
 ./utils/common/SysUtils.o \
-./utils/common/SystemFrame.o 
+./utils/common/SystemFrame.o \
+./utils/common/WorkerPool.o 
 
 CPP_DEPS += \
 ./utils/common/FileHelpers.d \
@@ -69,7 +71,8 @@ CPP_DEPS += \
 ./utils/common/StringTokenizer.d \
 ./utils/common/StringUtils.d \
 ./utils/common/SysUtils.d \
-./utils/common/SystemFrame.d 
+./utils/common/SystemFrame.d \
+./utils/common/WorkerPool.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
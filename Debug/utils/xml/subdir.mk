@@ -5,8 +5,10 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 O_SRCS += \
 ../utils/xml/GenericSAXHandler.o \
+../utils/xml/SAXBinaryCache.o \
 ../utils/xml/SAXWeightsHandler.o \
 ../utils/xml/SUMOSAXAttributes.o \
+../utils/xml/SUMOSAXAttributesImpl_Binary.o \
 ../utils/xml/SUMOSAXAttributesImpl_Xerces.o \
 ../utils/xml/SUMOSAXHandler.o \
 ../utils/xml/SUMOVehicleParserHelper.o \
@@ -15,8 +17,10 @@ O_SRCS += \
 
 CPP_SRCS += \
 ../utils/xml/GenericSAXHandler.cpp \
+../utils/xml/SAXBinaryCache.cpp \
 ../utils/xml/SAXWeightsHandler.cpp \
 ../utils/xml/SUMOSAXAttributes.cpp \
+../utils/xml/SUMOSAXAttributesImpl_Binary.cpp \
 ../utils/xml/SUMOSAXAttributesImpl_Xerces.cpp \
 ../utils/xml/SUMOSAXHandler.cpp \
 ../utils/xml/SUMOVehicleParserHelper.cpp \
@@ -25,8 +29,10 @@ CPP_SRCS += \
 
 OBJS += \
 ./utils/xml/GenericSAXHandler.o \
+./utils/xml/SAXBinaryCache.o \
 ./utils/xml/SAXWeightsHandler.o \
 ./utils/xml/SUMOSAXAttributes.o \
+./utils/xml/SUMOSAXAttributesImpl_Binary.o \
 ./utils/xml/SUMOSAXAttributesImpl_Xerces.o \
 ./utils/xml/SUMOSAXHandler.o \
 ./utils/xml/SUMOVehicleParserHelper.o \
@@ -35,8 +41,10 @@ OBJS += \
 
 CPP_DEPS += \
 ./utils/xml/GenericSAXHandler.d \
+./utils/xml/SAXBinaryCache.d \
 ./utils/xml/SAXWeightsHandler.d \
 ./utils/xml/SUMOSAXAttributes.d \
+./utils/xml/SUMOSAXAttributesImpl_Binary.d \
 ./utils/xml/SUMOSAXAttributesImpl_Xerces.d \
 ./utils/xml/SUMOSAXHandler.d \
 ./utils/xml/SUMOVehicleParserHelper.d \
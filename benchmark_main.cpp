@@ -0,0 +1,965 @@
+/****************************************************************************/
+/// @file    benchmark_main.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: benchmark_main.cpp $
+///
+// Main for the benchmarks of the simulation's core parts
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#ifdef HAVE_VERSION_H
+#include <version.h>
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include <new>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <microsim/MSNet.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSEmitControl.h>
+#include <microsim/MSEdgeWeightsStorage.h>
+#include <microsim/MSRoute.h>
+#include <microsim/MSRouteLoaderControl.h>
+#include <microsim/MSVehicle.h>
+#include <microsim/MSVehicleType.h>
+#include <microsim/MSVehicleControl.h>
+#include <microsim/MSVehicleTransfer.h>
+#include <microsim/MSEventControl.h>
+#include <microsim/MSGlobals.h>
+#include <microsim/MSFrame.h>
+#include <microsim/MSCFModel.h>
+#include <netload/NLEdgeControlBuilder.h>
+#include <netload/NLJunctionControlBuilder.h>
+#include <netload/NLSucceedingLaneBuilder.h>
+#include <netload/NLDetectorBuilder.h>
+#include <utils/options/Option.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/options/OptionsIO.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/SystemFrame.h>
+#include <utils/common/RandHelper.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/StringTokenizer.h>
+#include <utils/common/TplConvert.h>
+#include <utils/common/ToString.h>
+#include <utils/common/DijkstraRouterTT.h>
+#include <utils/common/AStarRouterTT.h>
+#include <utils/common/CHRouter.h>
+#include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/SUMOVehicleParameter.h>
+#include <utils/common/SUMOVTypeParameter.h>
+#include <utils/geom/Position2D.h>
+#include <utils/geom/Position2DVector.h>
+#include <utils/xml/SUMOXMLDefinitions.h>
+#include <utils/xml/XMLSubSys.h>
+
+// the allocation counter replaces the global operator new which collides
+//  with the leak checker; allocations are not counted when it is used
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif
+
+
+// ===========================================================================
+// allocation counting
+// ===========================================================================
+/// @brief The number of allocations done so far
+static unsigned long myAllocations = 0;
+
+#ifndef CHECK_MEMORY_LEAKS
+void *
+operator new(size_t size) throw(std::bad_alloc) {
+#ifdef __GNUC__
+    __sync_fetch_and_add(&myAllocations, 1);
+#else
+    ++myAllocations;
+#endif
+    void *p = malloc(size!=0 ? size : 1);
+    if (p==0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+
+void *
+operator new[](size_t size) throw(std::bad_alloc) {
+    return operator new(size);
+}
+
+
+void
+operator delete(void *p) throw() {
+    free(p);
+}
+
+
+void
+operator delete[](void *p) throw() {
+    free(p);
+}
+#endif
+
+
+// ===========================================================================
+// time measurement
+// ===========================================================================
+/// @brief Returns the wall clock time in nanoseconds
+long long
+getNanos() {
+#ifdef WIN32
+    LARGE_INTEGER val, freq;
+    QueryPerformanceCounter(&val);
+    QueryPerformanceFrequency(&freq);
+    return (long long)((double) val.QuadPart * 1e9 / (double) freq.QuadPart);
+#else
+    timeval current;
+    gettimeofday(&current, 0);
+    return (long long) current.tv_sec * 1000000000LL + (long long) current.tv_usec * 1000LL;
+#endif
+}
+
+
+/**
+ * @struct Measure
+ * @brief The duration and the allocations of a measured part
+ */
+struct Measure {
+    Measure() : nanos(0), allocations(0), calls(0) {}
+
+    /// @brief Starts measuring
+    void begin() {
+        myBeginAllocations = myAllocations;
+        myBeginNanos = getNanos();
+    }
+
+    /// @brief Stops measuring, adding the given number of calls
+    void end(unsigned long noCalls) {
+        nanos += getNanos() - myBeginNanos;
+        allocations += myAllocations - myBeginAllocations;
+        calls += noCalls;
+    }
+
+    /// @brief The measured duration [ns]
+    long long nanos;
+    /// @brief The measured allocations
+    unsigned long allocations;
+    /// @brief The number of measured calls (vehicles for step phases)
+    unsigned long calls;
+
+private:
+    long long myBeginNanos;
+    unsigned long myBeginAllocations;
+};
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class BenchmarkLane
+ * @brief A lane which makes the emission strip computation callable
+ */
+class BenchmarkLane : public MSLane {
+public:
+    BenchmarkLane(const std::string &id, SUMOReal maxSpeed, SUMOReal length, size_t stripWidth,
+                  MSEdge * const edge, unsigned int numericalID, const Position2DVector &shape,
+                  const std::vector<SUMOVehicleClass> &allowed,
+                  const std::vector<SUMOVehicleClass> &disallowed) throw()
+            : MSLane(id, maxSpeed, length, stripWidth, edge, numericalID, shape, allowed, disallowed) {}
+
+    using MSLane::getEmptyStartStripID;
+
+};
+
+
+/**
+ * @class BenchmarkEdgeControlBuilder
+ * @brief Builds BenchmarkLanes instead of MSLanes
+ */
+class BenchmarkEdgeControlBuilder : public NLEdgeControlBuilder {
+public:
+    MSLane *addLane(const std::string &id, SUMOReal maxSpeed, SUMOReal length,
+                    size_t stripWidth, bool isDepart, const Position2DVector &shape,
+                    const std::vector<SUMOVehicleClass> &allowed,
+                    const std::vector<SUMOVehicleClass> &disallowed) {
+        if (isDepart&&m_pDepartLane!=0) {
+            throw InvalidArgument("Lane's '" + id + "' edge already has a depart lane.");
+        }
+        BenchmarkLane *lane = new BenchmarkLane(id, maxSpeed, length, stripWidth, myActiveEdge,
+                                                myCurrentNumericalLaneID++, shape, allowed, disallowed);
+        m_pLaneStorage->push_back(lane);
+        if (isDepart) {
+            m_pDepartLane = lane;
+        }
+        myLanes.push_back(lane);
+        return lane;
+    }
+
+    /// @brief The built lanes
+    std::vector<BenchmarkLane*> myLanes;
+
+};
+
+
+/**
+ * @class BenchmarkNet
+ * @brief A network which performs the moving parts of a simulation step measured
+ */
+class BenchmarkNet : public MSNet {
+public:
+    /// @brief The measured phases of a step
+    enum Phase {
+        /// @brief MSEdgeControl::moveCritical (MSStrip::moveCritical)
+        PHASE_MOVE_CRITICAL = 0,
+        /// @brief MSEdgeControl::moveFirst (MSStrip::setCritical)
+        PHASE_SET_CRITICAL,
+        /// @brief MSEdgeControl::changeLanes (MSStripChanger::laneChange)
+        PHASE_LANE_CHANGE,
+        /// @brief The number of phases
+        PHASE_NUMBER
+    };
+
+    BenchmarkNet() throw(ProcessError)
+            : MSNet(new MSVehicleControl(), new MSEventControl(),
+                    new MSEventControl(), new MSEventControl()) {}
+
+    /** @brief Performs a simulation step without outputs and events
+     * @param[in, out] measures The measures of the phases (0 if the step shall not be measured)
+     */
+    void step(Measure *measures) {
+        const unsigned long vehicles = myVehicleControl->getRunningVehicleNo();
+        myEdges->patchActiveLanes();
+        if (measures!=0) {
+            measures[PHASE_MOVE_CRITICAL].begin();
+        }
+        myEdges->moveCritical(myStep);
+        if (measures!=0) {
+            measures[PHASE_MOVE_CRITICAL].end(vehicles);
+            measures[PHASE_SET_CRITICAL].begin();
+        }
+        myEdges->moveFirst(myStep);
+        if (measures!=0) {
+            measures[PHASE_SET_CRITICAL].end(vehicles);
+        }
+        if (MSGlobals::gCheck4Accidents) {
+            myEdges->detectCollisions(myStep);
+        }
+        if (measures!=0) {
+            measures[PHASE_LANE_CHANGE].begin();
+        }
+        myEdges->changeLanes(myStep);
+        if (measures!=0) {
+            measures[PHASE_LANE_CHANGE].end(vehicles);
+        }
+        if (MSGlobals::gCheck4Accidents) {
+            myEdges->detectCollisions(myStep);
+        }
+        myEmitter->emitVehicles(myStep);
+        MSVehicleTransfer::getInstance()->checkEmissions(myStep);
+        myStep += DELTA_T;
+    }
+
+    /// @brief Returns the name of the phase
+    static const char *getName(Phase phase) {
+        switch (phase) {
+        case PHASE_MOVE_CRITICAL:
+            return "MSStrip::moveCritical";
+        case PHASE_SET_CRITICAL:
+            return "MSStrip::setCritical";
+        case PHASE_LANE_CHANGE:
+            return "MSStripChanger::laneChange";
+        default:
+            return "";
+        }
+    }
+
+};
+
+
+/**
+ * @struct VehicleClass
+ * @brief A part of the vehicle mix
+ */
+struct VehicleClass {
+    /// @brief The type of the class' vehicles
+    MSVehicleType *type;
+    /// @brief The share of the vehicles
+    SUMOReal share;
+};
+
+
+/// @brief The car-following models and the names used within "bench.mix"
+static const std::pair<const char *, int> CF_MODELS[] = {
+    std::make_pair("Krauss", (int) SUMO_TAG_CF_KRAUSS),
+    std::make_pair("KraussOrig1", (int) SUMO_TAG_CF_KRAUSS_ORIG1),
+    std::make_pair("IDM", (int) SUMO_TAG_CF_IDM),
+    std::make_pair("PWagner2009", (int) SUMO_TAG_CF_PWAGNER2009),
+    std::make_pair("BKerner", (int) SUMO_TAG_CF_BKERNER),
+    std::make_pair("IITBNN", (int) SUMO_TAG_CF_IITBNN)
+};
+
+static const int CF_MODEL_NUMBER = 6;
+
+
+// ===========================================================================
+// functions
+// ===========================================================================
+/* -------------------------------------------------------------------------
+ * options
+ * ----------------------------------------------------------------------- */
+void
+fillBenchmarkOptions(OptionsCont &oc) {
+    oc.addOptionSubTopic("Benchmark");
+
+    oc.doRegister("bench.grid", new Option_Integer(5));
+    oc.addDescription("bench.grid", "Benchmark", "Build a grid of INT x INT junctions");
+
+    oc.doRegister("bench.lanes", new Option_Integer(2));
+    oc.addDescription("bench.lanes", "Benchmark", "Build INT lanes per edge");
+
+    oc.doRegister("bench.strips", new Option_Integer(4));
+    oc.addDescription("bench.strips", "Benchmark", "Build lanes of INT strips");
+
+    oc.doRegister("bench.lane-length", new Option_Float(200));
+    oc.addDescription("bench.lane-length", "Benchmark", "Build lanes of FLOAT m length");
+
+    oc.doRegister("bench.max-speed", new Option_Float((SUMOReal) 13.89));
+    oc.addDescription("bench.max-speed", "Benchmark", "Allow FLOAT m/s on all lanes");
+
+    oc.doRegister("bench.density", new Option_Float(100));
+    oc.addDescription("bench.density", "Benchmark", "Place FLOAT vehicles per km on each lane");
+
+    oc.doRegister("bench.mix", new Option_String("car:2:4.5:13.89:0.5:Krauss,bike:1:2:11.11:0.4:Krauss,bus:4:12:11.11:0.1:IDM"));
+    oc.addDescription("bench.mix", "Benchmark", "Use the vehicle classes STR (id:strips:length:maxSpeed:share[:model],...)");
+
+    oc.doRegister("bench.warmup", new Option_Integer(50));
+    oc.addDescription("bench.warmup", "Benchmark", "Perform INT unmeasured steps first");
+
+    oc.doRegister("bench.steps", new Option_Integer(200));
+    oc.addDescription("bench.steps", "Benchmark", "Measure INT steps");
+
+    oc.doRegister("bench.calls", new Option_Integer(1000000));
+    oc.addDescription("bench.calls", "Benchmark", "Measure INT calls of the strip and car-following methods");
+
+    oc.doRegister("bench.routes", new Option_Integer(1000));
+    oc.addDescription("bench.routes", "Benchmark", "Measure INT route computations");
+}
+
+
+int
+getCFModel(const std::string &name) throw(ProcessError) {
+    for (int i=0; i<CF_MODEL_NUMBER; ++i) {
+        if (name==CF_MODELS[i].first) {
+            return CF_MODELS[i].second;
+        }
+    }
+    throw ProcessError("Unknown car-following model '" + name + "'.");
+}
+
+
+MSVehicleType *
+buildVehicleType(const std::string &id, size_t strips, SUMOReal length, SUMOReal maxSpeed,
+                 int cfModel) throw(ProcessError) {
+    SUMOVTypeParameter pars;
+    pars.id = id;
+    pars.stripWidth = strips;
+    pars.length = length;
+    pars.maxSpeed = maxSpeed;
+    pars.cfModel = cfModel;
+    pars.setParameter |= VTYPEPARS_STRIPWIDTH_SET | VTYPEPARS_LENGTH_SET | VTYPEPARS_MAXSPEED_SET;
+    MSVehicleType *type = MSVehicleType::build(pars);
+    if (!MSNet::getInstance()->getVehicleControl().addVType(type)) {
+        delete type;
+        throw ProcessError("Another vehicle type with the id '" + id + "' exists.");
+    }
+    return type;
+}
+
+
+std::vector<VehicleClass>
+parseVehicleMix(const std::string &def, size_t laneStrips) throw(ProcessError) {
+    std::vector<VehicleClass> ret;
+    SUMOReal shares = 0;
+    StringTokenizer st(def, ",");
+    while (st.hasNext()) {
+        const std::string classDef = st.next();
+        std::vector<std::string> values = StringTokenizer(classDef, ":").getVector();
+        if (values.size()!=5&&values.size()!=6) {
+            throw ProcessError("Invalid vehicle class definition '" + classDef + "'.");
+        }
+        try {
+            const int strips = TplConvert<char>::_2int(values[1].c_str());
+            if (strips<1||strips>(int) laneStrips) {
+                throw ProcessError("The vehicles of class '" + values[0] + "' do not fit into a lane.");
+            }
+            VehicleClass vc;
+            vc.share = TplConvert<char>::_2SUMOReal(values[4].c_str());
+            vc.type = buildVehicleType(values[0], strips,
+                                       TplConvert<char>::_2SUMOReal(values[2].c_str()),
+                                       TplConvert<char>::_2SUMOReal(values[3].c_str()),
+                                       getCFModel(values.size()==6 ? values[5] : "Krauss"));
+            shares += vc.share;
+            ret.push_back(vc);
+        } catch (NumberFormatException &) {
+            throw ProcessError("Invalid vehicle class definition '" + classDef + "'.");
+        } catch (EmptyData &) {
+            throw ProcessError("Invalid vehicle class definition '" + classDef + "'.");
+        }
+    }
+    if (ret.size()==0||shares<=0) {
+        throw ProcessError("The vehicle mix is empty.");
+    }
+    return ret;
+}
+
+
+/* -------------------------------------------------------------------------
+ * network building
+ * ----------------------------------------------------------------------- */
+std::string
+getNodeID(int x, int y) {
+    return "n" + toString(x) + "_" + toString(y);
+}
+
+
+std::string
+getEdgeID(int x1, int y1, int x2, int y2) {
+    return "e" + toString(x1) + "_" + toString(y1) + "_" + toString(x2) + "_" + toString(y2);
+}
+
+
+std::string
+getLaneID(const std::string &edgeID, int index) {
+    return edgeID + "_" + toString(index);
+}
+
+
+/** @brief Builds a grid of edges connected by unregulated junctions
+ *
+ * Each pair of neighboured junctions is connected by an edge in each
+ *  direction. The lanes of an edge are connected to all lanes of the
+ *  following edges, except for turning around.
+ */
+void
+buildNetwork(BenchmarkNet &net, BenchmarkEdgeControlBuilder &eb, OptionsCont &oc) throw(ProcessError) {
+    const int size = oc.getInt("bench.grid");
+    const int lanes = oc.getInt("bench.lanes");
+    const int strips = oc.getInt("bench.strips");
+    const SUMOReal length = oc.getFloat("bench.lane-length");
+    const SUMOReal maxSpeed = oc.getFloat("bench.max-speed");
+    if (size<2||lanes<1||strips<1||length<=0||maxSpeed<=0) {
+        throw ProcessError("Invalid network definition.");
+    }
+    const int dx[] = { 1, 0, -1, 0 };
+    const int dy[] = { 0, 1, 0, -1 };
+    const std::vector<SUMOVehicleClass> allowed;
+    const std::vector<SUMOVehicleClass> disallowed;
+    NLDetectorBuilder db(net);
+    NLJunctionControlBuilder jb(net, oc);
+    NLSucceedingLaneBuilder sb(jb);
+    try {
+        // edges
+        for (int x=0; x<size; ++x) {
+            for (int y=0; y<size; ++y) {
+                for (int d=0; d<4; ++d) {
+                    const int x2 = x + dx[d];
+                    const int y2 = y + dy[d];
+                    if (x2<0||x2>=size||y2<0||y2>=size) {
+                        continue;
+                    }
+                    const std::string id = getEdgeID(x, y, x2, y2);
+                    eb.beginEdgeParsing(id, MSEdge::EDGEFUNCTION_NORMAL);
+                    for (int l=0; l<lanes; ++l) {
+                        // lanes are placed right of their edge's axis
+                        const SUMOReal offset = (SUMOReal) 3.2 * (SUMOReal)(l + 1);
+                        Position2DVector shape;
+                        shape.push_back(Position2D(x*length + dy[d]*offset, y*length - dx[d]*offset));
+                        shape.push_back(Position2D(x2*length + dy[d]*offset, y2*length - dx[d]*offset));
+                        MSLane *lane = eb.addLane(getLaneID(id, l), maxSpeed, length, strips, l==0, shape, allowed, disallowed);
+                        if (!MSLane::dictionary(lane->getID(), lane)) {
+                            throw ProcessError("Another lane with the id '" + lane->getID() + "' exists.");
+                        }
+                    }
+                    eb.closeEdge();
+                }
+            }
+        }
+        // junctions and connections
+        for (int x=0; x<size; ++x) {
+            for (int y=0; y<size; ++y) {
+                jb.openJunction(getNodeID(x, y), "", "unregulated", x*length, y*length, Position2DVector());
+                for (int d=0; d<4; ++d) {
+                    const int x1 = x - dx[d];
+                    const int y1 = y - dy[d];
+                    if (x1<0||x1>=size||y1<0||y1>=size) {
+                        continue;
+                    }
+                    const std::string from = getEdgeID(x1, y1, x, y);
+                    for (int l=0; l<lanes; ++l) {
+                        jb.addIncomingLane(MSLane::dictionary(getLaneID(from, l)));
+                    }
+                    for (int l=0; l<lanes; ++l) {
+                        sb.openSuccLane(getLaneID(from, l));
+                        for (int turn=-1; turn<2; ++turn) {
+                            const int d2 = (d + turn + 4) % 4;
+                            const int x2 = x + dx[d2];
+                            const int y2 = y + dy[d2];
+                            if (x2<0||x2>=size||y2<0||y2>=size) {
+                                continue;
+                            }
+                            const MSLink::LinkDirection dir = turn==0
+                                                              ? MSLink::LINKDIR_STRAIGHT
+                                                              : turn<0 ? MSLink::LINKDIR_RIGHT : MSLink::LINKDIR_LEFT;
+                            const std::string to = getEdgeID(x, y, x2, y2);
+                            for (int l2=0; l2<lanes; ++l2) {
+                                sb.addSuccLane(false, getLaneID(to, l2), "", -1, dir, MSLink::LINKSTATE_MAJOR, false);
+                            }
+                        }
+                        sb.closeSuccLane();
+                    }
+                }
+                jb.closeJunction();
+            }
+        }
+    } catch (InvalidArgument &e) {
+        throw ProcessError(e.what());
+    }
+    // close the network as NLBuilder::buildNet does
+    jb.closeJunctions(db);
+    MSEdgeControl *edges = eb.build();
+    MSJunctionControl *junctions = jb.build();
+    MSRouteLoaderControl *routeLoaders = new MSRouteLoaderControl(net, oc.getInt("route-steps"), MSRouteLoaderControl::LoaderVector());
+    MSTLLogicControl *tlc = jb.buildTLLogics();
+    MSFrame::buildStreams();
+    std::vector<SUMOTime> stateDumpTimes;
+    std::vector<std::string> stateDumpFiles;
+    net.closeBuilding(edges, junctions, routeLoaders, tlc, stateDumpTimes, stateDumpFiles);
+}
+
+
+/** @brief Returns the edges of the block the given edge borders on its left side
+ *
+ * The edges are returned in driving order, beginning with the given edge.
+ *  An empty vector is returned if the edge is at the grid's border.
+ */
+MSEdgeVector
+getBlock(int x, int y, int d, int size) {
+    const int dx[] = { 1, 0, -1, 0 };
+    const int dy[] = { 0, 1, 0, -1 };
+    MSEdgeVector ret;
+    for (int i=0; i<4; ++i) {
+        const int x2 = x + dx[d];
+        const int y2 = y + dy[d];
+        if (x<0||x>=size||y<0||y>=size||x2<0||x2>=size||y2<0||y2>=size) {
+            return MSEdgeVector();
+        }
+        ret.push_back(MSEdge::dictionary(getEdgeID(x, y, x2, y2)));
+        x = x2;
+        y = y2;
+        d = (d + 1) % 4;
+    }
+    return ret;
+}
+
+
+/* -------------------------------------------------------------------------
+ * vehicle placement
+ * ----------------------------------------------------------------------- */
+MSVehicle *
+placeVehicle(const std::string &id, const MSEdgeVector &edges, MSVehicleType *type,
+             BenchmarkLane *lane, SUMOReal pos, size_t strip) throw(ProcessError) {
+    MSRoute *route = new MSRoute("!" + id, edges, false, RGBColor::getDefaultColor(),
+                                 std::vector<SUMOVehicleParameter::Stop>());
+    if (!MSRoute::dictionary(route->getID(), route)) {
+        delete route;
+        throw ProcessError("Another route with the id '" + route->getID() + "' exists.");
+    }
+    SUMOVehicleParameter *pars = new SUMOVehicleParameter();
+    pars->id = id;
+    pars->vtypeid = type->getID();
+    pars->depart = MSNet::getInstance()->getCurrentTimeStep();
+    MSVehicleControl &vc = MSNet::getInstance()->getVehicleControl();
+    MSVehicle *veh = vc.buildVehicle(pars, route, type);
+    vc.addVehicle(id, veh);
+    veh->onTryEmit();
+    if (!lane->isEmissionSuccess(veh, 0, pos, false, strip)) {
+        vc.deleteVehicle(veh);
+        return 0;
+    }
+    veh->onDepart();
+    return veh;
+}
+
+
+/** @brief Places one probe vehicle per car-following model on the grid's border
+ *
+ * The border edges are not used by the vehicle mix; the probes are placed
+ *  standing and leave the network at the end of their edge.
+ */
+std::vector<MSVehicle*>
+placeProbes(OptionsCont &oc) throw(ProcessError) {
+    const SUMOReal length = oc.getFloat("bench.lane-length");
+    // the bottom row's westward edges are at the border
+    MSEdgeVector edges;
+    edges.push_back(MSEdge::dictionary(getEdgeID(1, 0, 0, 0)));
+    BenchmarkLane *lane = static_cast<BenchmarkLane*>(edges[0]->getLanes()[0]);
+    std::vector<MSVehicle*> ret;
+    for (int i=0; i<CF_MODEL_NUMBER; ++i) {
+        const std::string id = std::string("probe_") + CF_MODELS[i].first;
+        MSVehicleType *type = buildVehicleType(id, 1, 1, oc.getFloat("bench.max-speed"), CF_MODELS[i].second);
+        const SUMOReal pos = length * (SUMOReal)(CF_MODEL_NUMBER - i) / (SUMOReal)(CF_MODEL_NUMBER + 1);
+        MSVehicle *veh = placeVehicle(id, edges, type, lane, pos, 0);
+        if (veh==0) {
+            throw ProcessError("Could not place the probe vehicle '" + id + "'; the lanes are too short.");
+        }
+        ret.push_back(veh);
+    }
+    return ret;
+}
+
+
+/** @brief Fills the lanes of the grid's blocks with vehicles of the mix
+ *
+ * Each vehicle drives around the block its first edge borders on the left
+ *  for the whole benchmark, so that the density stays the same.
+ */
+unsigned int
+placeVehicles(const std::vector<VehicleClass> &mix, OptionsCont &oc, unsigned int &refused) throw(ProcessError) {
+    const int size = oc.getInt("bench.grid");
+    const int lanes = oc.getInt("bench.lanes");
+    const SUMOReal length = oc.getFloat("bench.lane-length");
+    const SUMOReal distance = oc.getFloat("bench.max-speed") * STEPS2TIME(DELTA_T)
+                              * (SUMOReal)(oc.getInt("bench.warmup") + oc.getInt("bench.steps"));
+    const int rounds = (int)(distance / (4 * length)) + 2;
+    const int number = (int)(oc.getFloat("bench.density") * length / (SUMOReal) 1000. + (SUMOReal) .5);
+    SUMOReal shares = 0;
+    for (std::vector<VehicleClass>::const_iterator i=mix.begin(); i!=mix.end(); ++i) {
+        shares += (*i).share;
+    }
+    unsigned int placed = 0;
+    refused = 0;
+    for (int x=0; x<size; ++x) {
+        for (int y=0; y<size; ++y) {
+            for (int d=0; d<4; ++d) {
+                const MSEdgeVector block = getBlock(x, y, d, size);
+                if (block.size()==0) {
+                    continue;
+                }
+                MSEdgeVector edges;
+                for (int r=0; r<rounds; ++r) {
+                    copy(block.begin(), block.end(), back_inserter(edges));
+                }
+                for (int l=0; l<lanes; ++l) {
+                    BenchmarkLane *lane = static_cast<BenchmarkLane*>(block[0]->getLanes()[l]);
+                    for (int n=0; n<number; ++n) {
+                        // choose the class
+                        SUMOReal r = RandHelper::rand(shares);
+                        std::vector<VehicleClass>::const_iterator vc = mix.begin();
+                        while (r>=(*vc).share&&vc+1!=mix.end()) {
+                            r -= (*vc).share;
+                            ++vc;
+                        }
+                        // place from the lane's end backwards
+                        const SUMOReal pos = length * (SUMOReal)(number - n) / (SUMOReal) number;
+                        const size_t strip = lane->getEmptyStartStripID((*vc).type->getStripWidth());
+                        const std::string id = "v" + toString(placed + refused);
+                        if (placeVehicle(id, edges, (*vc).type, lane, pos, strip)!=0) {
+                            ++placed;
+                        } else {
+                            ++refused;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return placed;
+}
+
+
+/* -------------------------------------------------------------------------
+ * measurements
+ * ----------------------------------------------------------------------- */
+void
+report(const std::string &name, const Measure &m, const std::string &unit, unsigned long steps) {
+    std::cout << "  " << std::left << std::setw(32) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << (m.calls!=0 ? (double) m.nanos / (double) m.calls : 0.) << " ns/" << unit;
+    if (steps!=0) {
+        std::cout << std::setw(12) << (double) m.allocations / (double) steps << " allocations/step";
+    } else {
+        std::cout << std::setw(12) << (m.calls!=0 ? (double) m.allocations / (double) m.calls : 0.) << " allocations/" << unit;
+    }
+    std::cout << std::endl;
+}
+
+
+/** @brief Measures the car-following models' safe speed computation
+ *
+ * Each model is called with the same random speeds and gaps, once per
+ *  vehicle and once for all vehicles using the batch interface.
+ */
+void
+measureCFModels(const std::vector<MSVehicle*> &probes, OptionsCont &oc) {
+    const unsigned long calls = oc.getInt("bench.calls");
+    const size_t BATCH = 1024;
+    const SUMOReal maxSpeed = oc.getFloat("bench.max-speed");
+    std::vector<SUMOReal> speeds(BATCH), gaps(BATCH), predSpeeds(BATCH), vSafes(BATCH);
+    for (size_t i=0; i<BATCH; ++i) {
+        speeds[i] = RandHelper::rand(maxSpeed);
+        gaps[i] = RandHelper::rand((SUMOReal) 100.);
+        predSpeeds[i] = RandHelper::rand(maxSpeed);
+    }
+    std::cout << "car-following models (" << calls << " calls):" << std::endl;
+    for (std::vector<MSVehicle*>::const_iterator i=probes.begin(); i!=probes.end(); ++i) {
+        const MSCFModel &model = (*i)->getCarFollowModel();
+        const std::string name = (*i)->getVehicleType().getID().substr(6);
+        std::vector<const MSVehicle*> vehs(BATCH, *i);
+        volatile SUMOReal sum = 0;
+        Measure single;
+        single.begin();
+        for (unsigned long c=0; c<calls; ++c) {
+            const size_t j = c % BATCH;
+            sum += model.ffeV(*i, speeds[j], gaps[j], predSpeeds[j]);
+        }
+        single.end(calls);
+        Measure batch;
+        batch.begin();
+        for (unsigned long c=0; c<calls; c+=BATCH) {
+            const size_t n = MIN2((unsigned long) BATCH, calls - c);
+            model.ffeVBatch(&vehs[0], &speeds[0], &gaps[0], &predSpeeds[0], &vSafes[0], n);
+            sum += vSafes[0];
+        }
+        batch.end(calls);
+        report("MSCFModel_" + name + "::ffeV", single, "call", 0);
+        report("MSCFModel_" + name + "::ffeVBatch", batch, "call", 0);
+    }
+}
+
+
+/// @brief Measures the choice of the emission strips on all lanes
+void
+measureEmptyStartStrip(const std::vector<BenchmarkLane*> &lanes, const std::vector<VehicleClass> &mix, OptionsCont &oc) {
+    const unsigned long calls = oc.getInt("bench.calls");
+    volatile size_t sum = 0;
+    Measure m;
+    m.begin();
+    for (unsigned long c=0; c<calls; ++c) {
+        sum += lanes[c % lanes.size()]->getEmptyStartStripID(mix[c % mix.size()].type->getStripWidth());
+    }
+    m.end(calls);
+    std::cout << "lanes (" << calls << " calls):" << std::endl;
+    report("MSLane::getEmptyStartStripID", m, "call", 0);
+}
+
+
+/// @brief Measures the route computation between random edges
+void
+measureRouter(const MSVehicle *probe, OptionsCont &oc) {
+    const unsigned long routes = oc.getInt("bench.routes");
+    const std::vector<MSEdge*> &edges = MSNet::getInstance()->getEdgeControl().getEdges();
+    MSEdgeWeightsStorage empty;
+    MSNet::EdgeWeightsProxi proxi(empty, MSNet::getInstance()->getWeightsStorage());
+    DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSNet::EdgeWeightsProxi>
+    router(MSEdge::dictSize(), true, &proxi, &MSNet::EdgeWeightsProxi::getTravelTime);
+    std::vector<std::pair<const MSEdge*, const MSEdge*> > pairs;
+    for (unsigned long i=0; i<routes; ++i) {
+        pairs.push_back(std::make_pair(edges[RandHelper::rand(edges.size())], edges[RandHelper::rand(edges.size())]));
+    }
+    std::vector<const MSEdge*> into;
+    into.reserve(edges.size());
+    Measure m;
+    m.begin();
+    for (unsigned long i=0; i<routes; ++i) {
+        into.clear();
+        router.compute(pairs[i].first, pairs[i].second, probe, 0, into);
+    }
+    m.end(routes);
+    std::cout << "routing (" << routes << " routes on " << edges.size() << " edges):" << std::endl;
+    report("DijkstraRouterTT::compute", m, "route", 0);
+    if (oc.getString("device.routing.algorithm")=="CH") {
+        CHRouter<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSNet::EdgeWeightsProxi>
+        ch(MSEdge::dictSize(), true, &proxi, &MSNet::EdgeWeightsProxi::getTravelTime);
+        Measure build;
+        build.begin();
+        ch.buildHierarchy(probe, 0);
+        build.end(1);
+        Measure cm;
+        cm.begin();
+        for (unsigned long i=0; i<routes; ++i) {
+            into.clear();
+            ch.compute(pairs[i].first, pairs[i].second, probe, 0, into);
+        }
+        cm.end(routes);
+        report("CHRouter::buildHierarchy", build, "build", 0);
+        report("CHRouter::compute", cm, "route", 0);
+    }
+    const int landmarkNo = oc.getInt("device.routing.landmarks");
+    if (landmarkNo<=0) {
+        return;
+    }
+    // without stored weights, the proxi's travel times are the lower bounds
+    std::vector<SUMOReal> lowerBounds(MSEdge::dictSize(), 0);
+    for (std::vector<MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
+        const MSLane * const lane = (*i)->getLanes()[0];
+        lowerBounds[(*i)->getNumericalID()] = lane->getLength() / lane->getMaxSpeed();
+    }
+    Measure build;
+    build.begin();
+    LandmarkLookupTable<MSEdge> lookup(MSEdge::dictSize(), lowerBounds, (unsigned int) landmarkNo);
+    build.end(1);
+    AStarRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSNet::EdgeWeightsProxi>
+    astar(MSEdge::dictSize(), true, &proxi, &MSNet::EdgeWeightsProxi::getTravelTime, &lookup);
+    Measure am;
+    am.begin();
+    for (unsigned long i=0; i<routes; ++i) {
+        into.clear();
+        astar.compute(pairs[i].first, pairs[i].second, probe, 0, into);
+    }
+    am.end(routes);
+    report("LandmarkLookupTable (" + toString(lookup.size()) + " landmarks)", build, "table", 0);
+    report("AStarRouterTT::compute", am, "route", 0);
+    // both routers shall find routes of the same effort
+    unsigned long differing = 0;
+    std::vector<const MSEdge*> check;
+    for (unsigned long i=0; i<routes; ++i) {
+        into.clear();
+        check.clear();
+        router.compute(pairs[i].first, pairs[i].second, probe, 0, into);
+        astar.compute(pairs[i].first, pairs[i].second, probe, 0, check);
+        if (fabs(router.recomputeCosts(into, probe, 0) - astar.recomputeCosts(check, probe, 0)) > 0.001) {
+            ++differing;
+        }
+    }
+    if (differing!=0) {
+        WRITE_WARNING(toString(differing) + " routes computed using landmarks differ in their effort from the ones of DijkstraRouterTT.");
+    }
+}
+
+
+/// @brief Measures the phases of the simulation steps
+void
+measureSteps(BenchmarkNet &net, OptionsCont &oc) {
+    const int warmup = oc.getInt("bench.warmup");
+    const int steps = oc.getInt("bench.steps");
+    for (int i=0; i<warmup; ++i) {
+        net.step(0);
+    }
+    Measure measures[BenchmarkNet::PHASE_NUMBER];
+    Measure total;
+    for (int i=0; i<steps; ++i) {
+        const unsigned long vehicles = net.getVehicleControl().getRunningVehicleNo();
+        total.begin();
+        net.step(measures);
+        total.end(vehicles);
+    }
+    std::cout << "steps (" << steps << " steps, " << std::fixed << std::setprecision(1)
+              << (steps!=0 ? (double) total.calls / (double) steps : 0.) << " vehicles in mean):" << std::endl;
+    for (int i=0; i<BenchmarkNet::PHASE_NUMBER; ++i) {
+        report(BenchmarkNet::getName((BenchmarkNet::Phase) i), measures[i], "vehicle", steps);
+    }
+    report("step", total, "vehicle", steps);
+}
+
+
+/* -------------------------------------------------------------------------
+ * main
+ * ----------------------------------------------------------------------- */
+int
+main(int argc, char **argv) {
+    OptionsCont &oc = OptionsCont::getOptions();
+    // give some application descriptions
+    oc.setApplicationDescription("Benchmarks the simulation's core parts on synthetic networks.");
+#ifdef WIN32
+    oc.setApplicationName("sumo-bench.exe", "SUMO sumo-bench Version " + (std::string)VERSION_STRING);
+#else
+    oc.setApplicationName("sumo-bench", "SUMO sumo-bench Version " + (std::string)VERSION_STRING);
+#endif
+    int ret = 0;
+    BenchmarkNet *net = 0;
+    try {
+        // initialise subsystems
+        XMLSubSys::init(false);
+        MSFrame::fillOptions();
+        fillBenchmarkOptions(oc);
+        OptionsIO::getOptions(true, argc, argv);
+        if (oc.processMetaOptions(false)) {
+            SystemFrame::close();
+            return 0;
+        }
+        MsgHandler::initOutputOptions();
+        RandHelper::initRandGlobal();
+        MSFrame::setMSGlobals(oc);
+        // build the network and the vehicles
+        net = new BenchmarkNet();
+        BenchmarkEdgeControlBuilder eb;
+        buildNetwork(*net, eb, oc);
+        const std::vector<MSVehicle*> probes = placeProbes(oc);
+        const std::vector<VehicleClass> mix = parseVehicleMix(oc.getString("bench.mix"), oc.getInt("bench.strips"));
+        unsigned int refused = 0;
+        const unsigned int placed = placeVehicles(mix, oc, refused);
+        std::cout << "network: " << oc.getInt("bench.grid") << "x" << oc.getInt("bench.grid") << " junctions, "
+                  << net->getEdgeControl().getEdges().size() << " edges, " << eb.myLanes.size() << " lanes of "
+                  << oc.getInt("bench.strips") << " strips, " << placed << " vehicles placed, "
+                  << refused << " refused" << std::endl;
+        // measure the parts in isolation; the probes are used before they leave the network
+        measureCFModels(probes, oc);
+        measureEmptyStartStrip(eb.myLanes, mix, oc);
+        measureRouter(probes[0], oc);
+        measureSteps(*net, oc);
+    } catch (ProcessError &e) {
+        if (std::string(e.what())!=std::string("Process Error") && std::string(e.what())!=std::string("")) {
+            MsgHandler::getErrorInstance()->inform(e.what());
+        }
+        MsgHandler::getErrorInstance()->inform("Quitting (on error).", false);
+        ret = 1;
+#ifndef _DEBUG
+    } catch (std::exception &e) {
+        MsgHandler::getErrorInstance()->inform("Quitting (on unknown error).", false);
+        ret = 1;
+#endif
+    }
+    delete net;
+    SystemFrame::close();
+    return ret;
+}
+
+
+
+/****************************************************************************/
+
@@ -121,6 +121,12 @@ GUILoadThread::run() {
         submitEndAndCleanup(net, simStartTime, simEndTime);
         return 0;
     }
+    if (oc.isSet("fork.variants")) {
+        // the windows would be copied into each variant
+        MsgHandler::getErrorInstance()->inform("Variants cannot be forked from the gui.");
+        submitEndAndCleanup(net, simStartTime, simEndTime);
+        return 0;
+    }
 
     RandHelper::initRandGlobal();
     // try to load
@@ -112,6 +112,20 @@ GUILane::moveCritical(SUMOTime t) {
 }
 
 
+bool
+GUILane::applyMoveCritical(SUMOTime t, bool &replan) {
+    myLock.lock();
+    try {
+        bool ret = MSLane::applyMoveCritical(t, replan);
+        myLock.unlock();
+        return ret;
+    } catch (ProcessError &) {
+        myLock.unlock();
+        throw;
+    }
+}
+
+
 bool
 GUILane::setCritical(SUMOTime t, std::vector<MSLane*> &into) {
     myLock.lock();
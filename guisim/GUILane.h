@@ -138,6 +138,10 @@ public:
         first; the access will be granted at the end of this method */
     bool moveCritical(SUMOTime t);
 
+    /** the same as in MSLane, but locks the access for the visualisation
+        first; the access will be granted at the end of this method */
+    bool applyMoveCritical(SUMOTime t, bool &replan);
+
     /** the same as in MSLane, but locks the access for the visualisation
         first; the access will be granted at the end of this method */
     bool setCritical(SUMOTime t, std::vector<MSLane*> &into);
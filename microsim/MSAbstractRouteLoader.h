@@ -0,0 +1,88 @@
+/****************************************************************************/
+/// @file    MSAbstractRouteLoader.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSAbstractRouteLoader.h $
+///
+// Interface of the classes which load vehicles step-wise
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSAbstractRouteLoader_h
+#define MSAbstractRouteLoader_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <utils/common/SUMOTime.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSEmitControl;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSAbstractRouteLoader
+ * @brief Interface of the classes which load vehicles step-wise
+ *
+ * Used by MSRouteLoaderControl for both XML route files (MSRouteLoader)
+ *  and binary demand files (MSBinaryRouteLoader).
+ */
+class MSAbstractRouteLoader {
+public:
+    /// @brief Destructor
+    virtual ~MSAbstractRouteLoader() { }
+
+
+    /** @brief Starts reading
+     * @exception ProcessError If the input can not be read
+     */
+    virtual void init() = 0;
+
+
+    /** @brief Loads vehicles until a vehicle is read that starts after the given time
+     * @param[in] time The time to load vehicles until
+     * @param[in] into The emission control to add the vehicles to
+     */
+    virtual void loadUntil(SUMOTime time, MSEmitControl* into) = 0;
+
+
+    /** @brief Returns the information whether new data is available
+     * @return Whether further vehicles may be read
+     */
+    virtual bool moreAvailable() const = 0;
+
+
+    /** @brief Stops the loader's threads, keeping the remaining vehicles readable
+     *
+     * Needed before the process is forked as threads are not copied.
+     */
+    virtual void finishParsing() throw() { }
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,309 @@
+/****************************************************************************/
+/// @file    MSBinaryRouteLoader.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSBinaryRouteLoader.cpp $
+///
+// Loads the vehicles of a binary demand file step-wise
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <utils/common/ToString.h>
+#include <utils/common/SUMOVehicleParameter.h>
+#include <utils/iodevices/BinaryInputDevice.h>
+#include <utils/xml/SAXBinaryCache.h>
+#include "MSEdge.h"
+#include "MSRoute.h"
+#include "MSBinaryRouteLoader.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const unsigned int MSBinaryRouteLoader::FORMAT_MAGIC = 0x53444d42;
+const unsigned int MSBinaryRouteLoader::FORMAT_VERSION = 1;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+// ---------------------------------------------------------------------------
+// MSBinaryRouteLoader::Handler - methods
+// ---------------------------------------------------------------------------
+MSBinaryRouteLoader::Handler::Handler(const std::string &file) throw()
+        : MSRouteHandler(file, false) {}
+
+
+void
+MSBinaryRouteLoader::Handler::addVehicle(SUMOVehicleParameter *pars, bool isFlow) throw(ProcessError) {
+    // same as opening and closing the vehicle's element
+    delete myVehicleParameter;
+    myVehicleParameter = pars;
+    if (isFlow) {
+        closeFlow();
+    } else {
+        closeVehicle();
+        delete myVehicleParameter;
+        myVehicleParameter = 0;
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// MSBinaryRouteLoader - methods
+// ---------------------------------------------------------------------------
+MSBinaryRouteLoader::MSBinaryRouteLoader(const std::string &file) throw()
+        : myFile(file), myStrm(0), myHandler(file), myChunkPos(0),
+        myMoreAvailable(true) {}
+
+
+MSBinaryRouteLoader::~MSBinaryRouteLoader() throw() {
+    for (size_t i=myChunkPos; i<myChunk.size(); ++i) {
+        delete myChunk[i].first;
+    }
+    delete myStrm;
+}
+
+
+bool
+MSBinaryRouteLoader::isBinary(const std::string &file) throw() {
+    BinaryInputDevice strm(file);
+    unsigned int magic = 0;
+    strm >> magic;
+    return strm.good() && magic==FORMAT_MAGIC;
+}
+
+
+void
+MSBinaryRouteLoader::init() throw(ProcessError) {
+    myMoreAvailable = true;
+    myStrm = new BinaryInputDevice(myFile);
+    unsigned int magic = 0;
+    unsigned int version = 0;
+    *myStrm >> magic;
+    *myStrm >> version;
+    if (!myStrm->good() || magic!=FORMAT_MAGIC || version!=FORMAT_VERSION) {
+        throw ProcessError("'" + myFile + "' is not a binary demand file of version " + toString(FORMAT_VERSION) + ".");
+    }
+    // the edges
+    unsigned int size = 0;
+    *myStrm >> size;
+    while (size-->0&&myStrm->good()) {
+        std::string id;
+        *myStrm >> id;
+        MSEdge *edge = MSEdge::dictionary(id);
+        if (edge==0) {
+            throw ProcessError("The edge '" + id + "' used within '" + myFile + "' is not known.");
+        }
+        myEdges.push_back(edge);
+    }
+    // the vehicle types
+    *myStrm >> size;
+    while (size-->0&&myStrm->good()) {
+        std::string id;
+        *myStrm >> id;
+        myTypes.push_back(id);
+    }
+    // the routes
+    *myStrm >> size;
+    myRoutes.reserve(size);
+    while (size-->0&&myStrm->good()) {
+        RouteDefinition route;
+        SUMOReal r, g, b;
+        unsigned int edgeNo = 0;
+        *myStrm >> route.id;
+        *myStrm >> route.shared;
+        *myStrm >> r;
+        *myStrm >> g;
+        *myStrm >> b;
+        route.color = RGBColor(r, g, b);
+        *myStrm >> edgeNo;
+        route.edges.reserve(edgeNo);
+        while (edgeNo-->0&&myStrm->good()) {
+            unsigned int edge = 0;
+            *myStrm >> edge;
+            if (edge>=myEdges.size()) {
+                corrupt();
+            }
+            route.edges.push_back(edge);
+        }
+        myRoutes.push_back(route);
+    }
+    // the definitions
+    std::string definitions;
+    *myStrm >> definitions;
+    if (!myStrm->good()) {
+        corrupt();
+    }
+    SAXBinaryCache::Replayer replayer(myHandler, myFile);
+    if (!replayer.replay(definitions.data(), definitions.data()+definitions.size())) {
+        corrupt();
+    }
+}
+
+
+void
+MSBinaryRouteLoader::loadUntil(SUMOTime time, MSEmitControl* into) throw(ProcessError) {
+    // see MSRouteLoader::loadUntil
+    if (!myMoreAvailable || time+DELTA_T < myHandler.getLastDepart()) {
+        return;
+    }
+    myHandler.retrieveLastReadVehicle(into);
+    bool isFlow = false;
+    SUMOVehicleParameter *pars = nextVehicle(isFlow);
+    while (pars!=0) {
+        myHandler.addVehicle(pars, isFlow);
+        if (myHandler.getLastDepart()>=time) {
+            return;
+        }
+        myHandler.retrieveLastReadVehicle(into);
+        pars = nextVehicle(isFlow);
+    }
+    myMoreAvailable = false;
+}
+
+
+bool
+MSBinaryRouteLoader::moreAvailable() const throw() {
+    return myMoreAvailable;
+}
+
+
+SUMOVehicleParameter *
+MSBinaryRouteLoader::nextVehicle(bool &isFlow) throw(ProcessError) {
+    if (myChunkPos==myChunk.size()) {
+        myChunk.clear();
+        myChunkPos = 0;
+        unsigned int size = 0;
+        *myStrm >> size;
+        if (!myStrm->good()) {
+            corrupt();
+        }
+        myChunk.reserve(size);
+        while (size-->0) {
+            bool flow = false;
+            SUMOVehicleParameter *pars = readVehicle(flow);
+            myChunk.push_back(std::make_pair(pars, flow));
+        }
+        if (myChunk.empty()) {
+            return 0;
+        }
+    }
+    isFlow = myChunk[myChunkPos].second;
+    return myChunk[myChunkPos++].first;
+}
+
+
+SUMOVehicleParameter *
+MSBinaryRouteLoader::readVehicle(bool &isFlow) throw(ProcessError) {
+    SUMOVehicleParameter *pars = new SUMOVehicleParameter();
+    int procedure = 0;
+    unsigned int route = 0;
+    unsigned int type = 0;
+    SUMOReal r, g, b;
+    *myStrm >> pars->id;
+    *myStrm >> isFlow;
+    *myStrm >> pars->depart;
+    *myStrm >> procedure;
+    pars->departProcedure = (DepartDefinition) procedure;
+    *myStrm >> route;
+    *myStrm >> type;
+    *myStrm >> procedure;
+    pars->departLaneProcedure = (DepartLaneDefinition) procedure;
+    *myStrm >> pars->departLane;
+    *myStrm >> procedure;
+    pars->departPosProcedure = (DepartPosDefinition) procedure;
+    *myStrm >> pars->departPos;
+    *myStrm >> procedure;
+    pars->departSpeedProcedure = (DepartSpeedDefinition) procedure;
+    *myStrm >> pars->departSpeed;
+    *myStrm >> procedure;
+    pars->arrivalLaneProcedure = (ArrivalLaneDefinition) procedure;
+    *myStrm >> pars->arrivalLane;
+    *myStrm >> procedure;
+    pars->arrivalPosProcedure = (ArrivalPosDefinition) procedure;
+    *myStrm >> pars->arrivalPos;
+    *myStrm >> procedure;
+    pars->arrivalSpeedProcedure = (ArrivalSpeedDefinition) procedure;
+    *myStrm >> pars->arrivalSpeed;
+    *myStrm >> pars->repetitionNumber;
+    *myStrm >> pars->repetitionOffset;
+    *myStrm >> pars->setParameter;
+    *myStrm >> r;
+    *myStrm >> g;
+    *myStrm >> b;
+    pars->color = RGBColor(r, g, b);
+    *myStrm >> pars->line;
+    *myStrm >> pars->fromTaz;
+    *myStrm >> pars->toTaz;
+    if (!myStrm->good() || type>=myTypes.size()) {
+        delete pars;
+        corrupt();
+    }
+    pars->vtypeid = myTypes[type];
+    try {
+        pars->routeid = buildRoute(route);
+    } catch (ProcessError &) {
+        delete pars;
+        throw;
+    }
+    return pars;
+}
+
+
+const std::string &
+MSBinaryRouteLoader::buildRoute(unsigned int index) throw(ProcessError) {
+    if (index>=myRoutes.size()) {
+        corrupt();
+    }
+    RouteDefinition &def = myRoutes[index];
+    if (!def.edges.empty() && MSRoute::dictionary(def.id)==0) {
+        MSEdgeVector edges;
+        edges.reserve(def.edges.size());
+        for (std::vector<unsigned int>::const_iterator i=def.edges.begin(); i!=def.edges.end(); ++i) {
+            edges.push_back(myEdges[*i]);
+        }
+        MSRoute *route = new MSRoute(def.id, edges, def.shared, def.color, std::vector<SUMOVehicleParameter::Stop>());
+        MSRoute::dictionary(def.id, route);
+        if (!def.shared) {
+            // a route of a single vehicle is not needed anymore
+            std::vector<unsigned int>().swap(def.edges);
+        }
+    }
+    return def.id;
+}
+
+
+void
+MSBinaryRouteLoader::corrupt() const throw(ProcessError) {
+    throw ProcessError("The binary demand file '" + myFile + "' is corrupt.");
+}
+
+
+
+/****************************************************************************/
+
@@ -0,0 +1,235 @@
+/****************************************************************************/
+/// @file    MSBinaryRouteLoader.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSBinaryRouteLoader.h $
+///
+// Loads the vehicles of a binary demand file step-wise
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSBinaryRouteLoader_h
+#define MSBinaryRouteLoader_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <utils/common/RGBColor.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/SUMOVehicleParameter.h>
+#include "MSAbstractRouteLoader.h"
+#include "MSRouteHandler.h"
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSEdge;
+class BinaryInputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSBinaryRouteLoader
+ * @brief Loads the vehicles of a binary demand file step-wise
+ *
+ * Binary demand files are built from XML route files by route2bin. They
+ *  store the vehicles pre-parsed and sorted by their departure, so the
+ *  vehicles are built without any string conversion:
+ * - a table of the used edges, resolved once when loading starts,
+ * - a table of the vehicle type ids the vehicles refer to by index,
+ * - a table of the routes given as edge indices; equal routes embedded
+ *  into several vehicles are stored once. A route without edges names a
+ *  route (or route distribution) defined within the definitions,
+ * - the definitions: the vehicle types, the named routes and the
+ *  distributions as recorded XML elements (see SAXBinaryCache) which are
+ *  replayed when loading starts,
+ * - the vehicles in chunks of a fixed number of records, closed by an
+ *  empty chunk.
+ *
+ * The vehicles are passed to the same MSRouteHandler methods the XML
+ *  route files use, so both behave the same. A route is built when the
+ *  first vehicle using it is read.
+ *
+ * The file is written in the machine's byte order.
+ */
+class MSBinaryRouteLoader : public MSAbstractRouteLoader {
+public:
+    /** @brief Constructor
+     * @param[in] file The binary demand file to load
+     */
+    MSBinaryRouteLoader(const std::string &file) throw();
+
+
+    /// @brief Destructor
+    virtual ~MSBinaryRouteLoader() throw();
+
+
+    /** @brief Returns whether the given file is a binary demand file
+     * @param[in] file The file to check
+     * @return Whether the file starts with the binary demand magic number
+     */
+    static bool isBinary(const std::string &file) throw();
+
+
+    /// @name inherited from MSAbstractRouteLoader
+    /// @{
+
+    /** @brief Reads the tables and the definitions
+     * @exception ProcessError If the file is not a valid binary demand file
+     */
+    void init() throw(ProcessError);
+
+
+    /** @brief Loads vehicles until a vehicle is read that starts after the given time
+     * @param[in] time The time to load vehicles until
+     * @param[in] into The emission control to add the vehicles to
+     * @exception ProcessError If the file is corrupt or a vehicle is invalid
+     */
+    void loadUntil(SUMOTime time, MSEmitControl* into) throw(ProcessError);
+
+
+    /** @brief Returns the information whether new data is available
+     * @return Whether further vehicles may be read
+     */
+    bool moreAvailable() const throw();
+    /// @}
+
+
+    /// @brief The magic number binary demand files start with ("SDMB")
+    static const unsigned int FORMAT_MAGIC;
+
+    /// @brief The version of the format
+    static const unsigned int FORMAT_VERSION;
+
+
+private:
+    /**
+     * @class Handler
+     * @brief Passes the read vehicles to the route handler's methods
+     */
+    class Handler : public MSRouteHandler {
+    public:
+        /** @brief Constructor
+         * @param[in] file The loaded file
+         */
+        Handler(const std::string &file) throw();
+
+
+        /** @brief Closes the given vehicle (or flow) as if it was parsed
+         * @param[in] pars The vehicle's parameter; the handler takes the ownership
+         * @param[in] isFlow Whether the vehicle is a flow
+         * @exception ProcessError If the vehicle's type or route is not known
+         */
+        void addVehicle(SUMOVehicleParameter *pars, bool isFlow) throw(ProcessError);
+
+    };
+
+
+    /**
+     * @struct RouteDefinition
+     * @brief A route of the route table
+     */
+    struct RouteDefinition {
+        /// @brief The route's id
+        std::string id;
+        /// @brief Whether the route is used by several vehicles
+        bool shared;
+        /// @brief The route's color
+        RGBColor color;
+        /// @brief The indices of the route's edges (empty if the route is defined by id only)
+        std::vector<unsigned int> edges;
+    };
+
+
+    /** @brief Reads the next vehicle, reading the next chunk if needed
+     * @param[out] isFlow Whether the read vehicle is a flow
+     * @return The read vehicle, 0 if all vehicles were read
+     * @exception ProcessError If the file is corrupt
+     */
+    SUMOVehicleParameter *nextVehicle(bool &isFlow) throw(ProcessError);
+
+
+    /** @brief Reads a vehicle record
+     * @param[out] isFlow Whether the read vehicle is a flow
+     * @return The read vehicle
+     * @exception ProcessError If the record is corrupt
+     */
+    SUMOVehicleParameter *readVehicle(bool &isFlow) throw(ProcessError);
+
+
+    /** @brief Builds the route with the given index unless it is already known
+     * @param[in] index The route's index within the route table
+     * @return The route's id
+     * @exception ProcessError If the index is invalid
+     */
+    const std::string &buildRoute(unsigned int index) throw(ProcessError);
+
+
+    /// @brief Throws the error reporting a corrupt file
+    void corrupt() const throw(ProcessError);
+
+
+private:
+    /// @brief The loaded file
+    const std::string myFile;
+
+    /// @brief The device to read from
+    BinaryInputDevice *myStrm;
+
+    /// @brief The handler which builds the vehicles
+    Handler myHandler;
+
+    /// @brief The edge table
+    std::vector<MSEdge*> myEdges;
+
+    /// @brief The vehicle type table
+    std::vector<std::string> myTypes;
+
+    /// @brief The route table
+    std::vector<RouteDefinition> myRoutes;
+
+    /// @brief The vehicles of the current chunk which were not yet added (vehicle, whether it is a flow)
+    std::vector<std::pair<SUMOVehicleParameter*, bool> > myChunk;
+
+    /// @brief The position of the next vehicle within the current chunk
+    size_t myChunkPos;
+
+    /// @brief Whether more vehicles may be read
+    bool myMoreAvailable;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSBinaryRouteLoader(const MSBinaryRouteLoader &src);
+
+    /// @brief Invalidated assignment operator.
+    MSBinaryRouteLoader &operator=(const MSBinaryRouteLoader &src);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -56,6 +56,16 @@ MSCFModel::leftVehicleVsafe(const MSVehicle * const ego, const MSVehicle * const
 }
 
 
+void
+MSCFModel::ffeVBatch(const MSVehicle * const *vehs, const SUMOReal *,
+                     const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                     SUMOReal *vSafes, size_t n) const throw() {
+    for (size_t i=0; i<n; ++i) {
+        vSafes[i] = ffeV(vehs[i], gaps[i], predSpeeds[i]);
+    }
+}
+
+
 SUMOReal
 MSCFModel::maxNextSpeed(SUMOReal speed) const throw() {
     return MIN2(speed + (SUMOReal) ACCEL2SPEED(getMaxAccel(speed)), myType->getMaxSpeed());
@@ -112,6 +112,24 @@ public:
     virtual SUMOReal ffeV(const MSVehicle * const veh, const MSVehicle * const pred) const throw() = 0;
 
 
+    /** @brief Computes the safe speeds of several vehicles following a leader (no dawdling)
+     *
+     * For each i, vSafes[i] is set to ffeV(vehs[i], gaps[i], predSpeeds[i]).
+     *  Models which compute the safe speed from the given values only may
+     *  override this to process all vehicles in one pass; the results must
+     *  be the same.
+     * @param[in] vehs The vehicles (EGO); all use this model
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[out] vSafes The EGOs' safe speeds
+     * @param[in] n The number of vehicles
+     */
+    virtual void ffeVBatch(const MSVehicle * const *vehs, const SUMOReal *speeds,
+                           const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                           SUMOReal *vSafes, size_t n) const throw();
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      *
      * Returns the velocity of the vehicle when approaching a static object (such as the end of a lane) assuming no reaction time is needed.
@@ -358,6 +358,14 @@ public:
     virtual void changeLanes(SUMOTime t) throw();
 
 
+    /** @brief Returns the lane changer of this edge
+     * @return The lane changer, 0 for internal and single-lane edges
+     */
+    MSStripChanger *getLaneChanger() const throw() {
+        return myLaneChanger;
+    }
+
+
 #ifdef HAVE_INTERNAL_LANES
     /// @extension: inner junctions are not filled
     const MSEdge *getInternalFollowingEdge(MSEdge *followerAfterInternal) const throw();
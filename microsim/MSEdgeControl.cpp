@@ -30,8 +30,13 @@
 #include "MSEdgeControl.h"
 #include "MSEdge.h"
 #include "MSLane.h"
+#include "MSGlobals.h"
+#include "MSStripChanger.h"
 #include <iostream>
 #include <vector>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -44,7 +49,8 @@
 MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* > &edges) throw()
         : myEdges(edges),
         myLanes(MSLane::dictSize()),
-        myLastLaneChange(MSEdge::dictSize()) {
+        myLastLaneChange(MSEdge::dictSize()),
+        myWorkerPool(0) {
     // build the usage definitions for lanes
     for (std::vector< MSEdge* >::const_iterator i=myEdges.begin(); i!=myEdges.end(); ++i) {
         const std::vector<MSLane*> &lanes = (*i)->getLanes();
@@ -72,10 +78,21 @@ MSEdgeControl::MSEdgeControl(const std::vector< MSEdge* > &edges) throw()
     for (size_t j=0; j<myLanes.size(); j++) {
         myLanes[j].lane->init(*this, myLanes[j].firstNeigh, myLanes[j].lastNeigh);
     }
+    // build the worker pool if wished
+    if (MSGlobals::gNumThreads>1) {
+        try {
+            myWorkerPool = new WorkerPool(MSGlobals::gNumThreads);
+            myReadingLevel.resize(MSEdge::dictSize(), 0);
+            myWritingLevel.resize(MSEdge::dictSize()+1, 0);
+        } catch (ProcessError &e) {
+            WRITE_WARNING(std::string(e.what()) + " Vehicles are moved using one thread.");
+        }
+    }
 }
 
 
 MSEdgeControl::~MSEdgeControl() throw() {
+    delete myWorkerPool;
 }
 
 
@@ -97,8 +114,46 @@ MSEdgeControl::patchActiveLanes() throw() {
     myChangedStateLanes.clear();
 }
 
+
+void
+MSEdgeControl::countActive(unsigned int &lanes, unsigned int &strips) const throw() {
+    lanes = 0;
+    strips = 0;
+    for (std::list<MSLane*>::const_iterator i=myActiveLanes.begin(); i!=myActiveLanes.end(); ++i) {
+        ++lanes;
+        strips += (unsigned int)(*i)->getWidth();
+    }
+}
+
+
 void
 MSEdgeControl::moveCritical(SUMOTime t) throw() {
+    if (myWorkerPool!=0) {
+        // plan all lanes in parallel; the plans change the planned vehicles only
+        myPlanners.clear();
+        for (std::list<MSLane*>::iterator i=myActiveLanes.begin(); i!=myActiveLanes.end(); ++i) {
+            if ((*i)->getVehicleNumber()!=0) {
+                myPlanners.push_back(MoveCriticalPlanner(*i, t));
+            }
+        }
+        myPlannerTasks.clear();
+        for (std::vector<MoveCriticalPlanner>::iterator i=myPlanners.begin(); i!=myPlanners.end(); ++i) {
+            myPlannerTasks.push_back(&(*i));
+        }
+        myWorkerPool->execute(myPlannerTasks);
+        // apply the plans in the serial order; links, warnings and teleports are
+        //  processed herein, in the same order as without the pool
+        bool replan = false;
+        for (std::list<MSLane*>::iterator i=myActiveLanes.begin(); i!=myActiveLanes.end();) {
+            if ((*i)->getVehicleNumber()==0 || (*i)->applyMoveCritical(t, replan)) {
+                myLanes[(*i)->getNumericalID()].amActive = false;
+                i = myActiveLanes.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        return;
+    }
     for (std::list<MSLane*>::iterator i=myActiveLanes.begin(); i!=myActiveLanes.end();) {
         if ((*i)->getVehicleNumber()==0 || (*i)->moveCritical(t)) {
             myLanes[(*i)->getNumericalID()].amActive = false;
@@ -139,6 +194,10 @@ MSEdgeControl::moveFirst(SUMOTime t) throw() {
 
 void
 MSEdgeControl::changeLanes(SUMOTime t) throw() {
+    if (myWorkerPool!=0) {
+        changeLanesParallel(t);
+        return;
+    }
     std::vector<MSLane*> toAdd;
     for (std::list<MSLane*>::iterator i=myActiveLanes.begin(); i!=myActiveLanes.end();) {
         LaneUsage &lu = myLanes[(*i)->getNumericalID()];
@@ -167,6 +226,116 @@ MSEdgeControl::changeLanes(SUMOTime t) throw() {
 }
 
 
+void
+MSEdgeControl::changeLanesParallel(SUMOTime t) throw() {
+    // collect the edges to change in the order used without the pool
+    myChangedEdges.clear();
+    for (std::list<MSLane*>::iterator i=myActiveLanes.begin(); i!=myActiveLanes.end()&&myLanes[(*i)->getNumericalID()].haveNeighbors; ++i) {
+        MSEdge &edge = (*i)->getEdge();
+        if (myLastLaneChange[edge.getNumericalID()]!=t) {
+            myLastLaneChange[edge.getNumericalID()] = t;
+            myChangedEdges.push_back(&edge);
+        }
+    }
+    // assign the levels
+    const unsigned int reminders = (unsigned int) myWritingLevel.size() - 1;
+    unsigned int maxLevel = 0;
+    std::vector<const MSEdge*> ahead;
+    std::vector<const MSEdge*> written;
+    myEdgeLaneChangers.clear();
+    for (std::vector<MSEdge*>::iterator i=myChangedEdges.begin(); i!=myChangedEdges.end(); ++i) {
+        MSStripChanger *changer = (*i)->getLaneChanger();
+        if (changer==0) {
+            continue;
+        }
+        ahead.clear();
+        written.clear();
+        written.push_back(*i);
+        const bool withReminders = changer->collectForeignEdges(ahead, written);
+        unsigned int level = 0;
+        raiseLaneChangeLevel(ahead, false, level);
+        raiseLaneChangeLevel(written, true, level);
+        if (withReminders) {
+            level = MAX2(level, myWritingLevel[reminders]);
+        }
+        ++level;
+        useInLaneChangeLevel(ahead, false, level);
+        useInLaneChangeLevel(written, true, level);
+        if (withReminders) {
+            myWritingLevel[reminders] = level;
+        }
+        maxLevel = MAX2(maxLevel, level);
+        myEdgeLaneChangers.push_back(EdgeLaneChanger(*i, t, level));
+        changer->setBufferDebugOutput(true);
+    }
+    for (std::vector<unsigned int>::iterator i=myLevelUsedEdges.begin(); i!=myLevelUsedEdges.end(); ++i) {
+        myReadingLevel[*i] = 0;
+        myWritingLevel[*i] = 0;
+    }
+    myLevelUsedEdges.clear();
+    myWritingLevel[reminders] = 0;
+    // change the levels one after another
+    myLaneChangeLevels.resize(maxLevel);
+    for (std::vector<EdgeLaneChanger>::iterator i=myEdgeLaneChangers.begin(); i!=myEdgeLaneChangers.end(); ++i) {
+        myLaneChangeLevels[(*i).getLevel()-1].push_back(&(*i));
+    }
+    for (std::vector<std::vector<WorkerPool::Task*> >::iterator i=myLaneChangeLevels.begin(); i!=myLaneChangeLevels.end(); ++i) {
+        myWorkerPool->execute(*i);
+        (*i).clear();
+    }
+    // write the debug output and collect the activated lanes in the edge order
+    std::vector<MSLane*> toAdd;
+    for (std::vector<MSEdge*>::iterator i=myChangedEdges.begin(); i!=myChangedEdges.end(); ++i) {
+        MSStripChanger *changer = (*i)->getLaneChanger();
+        if (changer!=0) {
+            changer->flushDebugOutput();
+            changer->setBufferDebugOutput(false);
+        }
+        const std::vector<MSLane*> &lanes = (*i)->getLanes();
+        for (std::vector<MSLane*>::const_iterator j=lanes.begin(); j!=lanes.end(); ++j) {
+            LaneUsage &lu = myLanes[(*j)->getNumericalID()];
+            if ((*j)->getVehicleNumber()>0 && !lu.amActive) {
+                toAdd.push_back(*j);
+                lu.amActive = true;
+            }
+        }
+    }
+    for (std::vector<MSLane*>::iterator i=toAdd.begin(); i!=toAdd.end(); ++i) {
+        myActiveLanes.push_front(*i);
+    }
+}
+
+
+void
+MSEdgeControl::raiseLaneChangeLevel(const std::vector<const MSEdge*> &edges, bool write,
+                                    unsigned int &level) const throw() {
+    for (std::vector<const MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
+        const unsigned int id = (*i)->getNumericalID();
+        level = MAX2(level, myWritingLevel[id]);
+        if (write) {
+            level = MAX2(level, myReadingLevel[id]);
+        }
+    }
+}
+
+
+void
+MSEdgeControl::useInLaneChangeLevel(const std::vector<const MSEdge*> &edges, bool write,
+                                    unsigned int level) throw() {
+    for (std::vector<const MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
+        const unsigned int id = (*i)->getNumericalID();
+        if (myReadingLevel[id]==0&&myWritingLevel[id]==0) {
+            myLevelUsedEdges.push_back(id);
+        }
+        if (write) {
+            myWritingLevel[id] = level;
+        } else {
+            myReadingLevel[id] = MAX2(myReadingLevel[id], level);
+        }
+    }
+}
+
+
 void
 MSEdgeControl::detectCollisions(SUMOTime timestep) throw() {
     // Detections is made by the edge's lanes, therefore hand over.
@@ -192,5 +361,68 @@ MSEdgeControl::gotActive(MSLane *l) throw() {
 }
 
 
+void
+MSEdgeControl::rebuildWorkerPool() throw() {
+    if (myWorkerPool==0) {
+        return;
+    }
+    myWorkerPool = 0;
+    try {
+        myWorkerPool = new WorkerPool(MSGlobals::gNumThreads);
+    } catch (ProcessError &e) {
+        WRITE_WARNING(std::string(e.what()) + " Vehicles are moved using one thread.");
+    }
+}
+
+
+void
+MSEdgeControl::saveState(std::ostream &os) throw() {
+    unsigned int occupied = 0;
+    for (LaneUsageVector::const_iterator i=myLanes.begin(); i!=myLanes.end(); ++i) {
+        if ((*i).lane->getVehicleNumber()!=0) {
+            ++occupied;
+        }
+    }
+    FileHelpers::writeUInt(os, occupied);
+    for (LaneUsageVector::const_iterator i=myLanes.begin(); i!=myLanes.end(); ++i) {
+        if ((*i).lane->getVehicleNumber()!=0) {
+            FileHelpers::writeString(os, (*i).lane->getID());
+            (*i).lane->saveState(os);
+        }
+    }
+}
+
+
+void
+MSEdgeControl::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    unsigned int occupied;
+    bis >> occupied;
+    for (unsigned int i=0; i<occupied; ++i) {
+        std::string id;
+        bis >> id;
+        MSLane *lane = MSLane::dictionary(id);
+        if (lane==0) {
+            MsgHandler::getErrorInstance()->inform("Unknown lane '" + id + "' in loaded state.");
+            return;
+        }
+        if (!lane->loadState(bis, vc)) {
+            return;
+        }
+    }
+}
+
+
+void
+MSEdgeControl::MoveCriticalPlanner::run() throw() {
+    myLane->planMoveCritical(myTime);
+}
+
+
+void
+MSEdgeControl::EdgeLaneChanger::run() throw() {
+    myEdge->changeLanes(myTime);
+}
+
+
 /****************************************************************************/
 
@@ -35,6 +35,7 @@
 #include <iostream>
 #include <list>
 #include <set>
+#include <utils/common/WorkerPool.h>
 #include "MSEdge.h"
 
 
@@ -43,6 +44,7 @@
 // ===========================================================================
 class OutputDevice;
 class BinaryInputDevice;
+class MSVehicleControl;
 
 
 // ===========================================================================
@@ -61,6 +63,11 @@ class BinaryInputDevice;
  *  add lanes on which a vehicle was emitted, separately, doing this into
  *  ("myChangedStateLanes") which entries are integrated at the begin of is step
  *  in "patchActiveLanes".
+ *
+ * If more than one thread shall be used (MSGlobals::gNumThreads), the moves of
+ *  the critical vehicles are planned in parallel by a worker pool, one task
+ *  per active lane. The plans are applied in the order of the active lanes
+ *  afterwards, so that the results do not depend on the number of threads.
  */
 class MSEdgeControl {
 public:
@@ -91,6 +98,13 @@ public:
     void patchActiveLanes() throw();
 
 
+    /** @brief Counts the active lanes and their strips
+     * @param[out] lanes The number of active lanes
+     * @param[out] strips The number of strips of the active lanes
+     */
+    void countActive(unsigned int &lanes, unsigned int &strips) const throw();
+
+
     /// @name Interfaces for longitudinal vehicle movement
     /// @{
 
@@ -104,7 +118,11 @@ public:
      *  implementation. If this call returns true, the lane is removed from the
      *  list of active lanes.
      *
+     * If a worker pool exists, the lanes are planned in parallel at first and
+     *  their "applyMoveCritical" implementation is called instead.
+     *
      * @see MSLane::moveCritical
+     * @see MSLane::planMoveCritical
      */
     void moveCritical(SUMOTime t) throw();
 
@@ -137,6 +155,9 @@ public:
      *  edge whether a lane got active, adding it to "myActiveLanes" and marking
      *  it as active in such cases.
      *
+     * If a worker pool exists, the edges are changed in parallel, see
+     *  "changeLanesParallel".
+     *
      * @see MSEdge::changeLanes
      */
     void changeLanes(SUMOTime t) throw();
@@ -178,6 +199,39 @@ public:
     void gotActive(MSLane *l) throw();
 
 
+    /** @brief Starts new worker threads after the process was forked
+     *
+     * A forked process contains the calling thread only. The old pool cannot
+     *  be stopped as its threads do not exist and is abandoned therefore.
+     */
+    void rebuildWorkerPool() throw();
+
+
+    /** @brief Returns the pool of worker threads
+     * @return The worker pool, 0 if only one thread is used
+     */
+    WorkerPool *getWorkerPool() const throw() {
+        return myWorkerPool;
+    }
+
+
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the vehicle order of all occupied lanes
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Puts the loaded vehicles back into the lanes
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     */
+    void loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
+
+
 public:
     /**
      * @struct LaneUsage
@@ -225,6 +279,121 @@ private:
     /// @brief The list of active (not empty) lanes
     std::vector<SUMOTime> myLastLaneChange;
 
+    /**
+     * @class MoveCriticalPlanner
+     * @brief Plans the moves of a lane's vehicles within the worker pool
+     */
+    class MoveCriticalPlanner : public WorkerPool::Task {
+    public:
+        /// @brief Constructor
+        MoveCriticalPlanner(MSLane *lane, SUMOTime t) throw()
+                : myLane(lane), myTime(t) { }
+
+        /// @brief Calls MSLane::planMoveCritical
+        void run() throw();
+
+    private:
+        /// @brief The lane to plan
+        MSLane *myLane;
+
+        /// @brief The current time step
+        SUMOTime myTime;
+
+    };
+
+    /// @brief The pool planning the lanes; 0 if only one thread is used
+    WorkerPool *myWorkerPool;
+
+    /// @brief The planners of the current step
+    std::vector<MoveCriticalPlanner> myPlanners;
+
+    /// @brief The planners of the current step as given to the worker pool
+    std::vector<WorkerPool::Task*> myPlannerTasks;
+
+    /**
+     * @class EdgeLaneChanger
+     * @brief Performs the lane changing on an edge within the worker pool
+     */
+    class EdgeLaneChanger : public WorkerPool::Task {
+    public:
+        /// @brief Constructor
+        EdgeLaneChanger(MSEdge *edge, SUMOTime t, unsigned int level) throw()
+                : myEdge(edge), myTime(t), myLevel(level) { }
+
+        /// @brief Calls MSEdge::changeLanes
+        void run() throw();
+
+        /// @brief Returns the level in which the edge is changed
+        unsigned int getLevel() const throw() {
+            return myLevel;
+        }
+
+    private:
+        /// @brief The edge to change
+        MSEdge *myEdge;
+
+        /// @brief The current time step
+        SUMOTime myTime;
+
+        /// @brief The level in which the edge is changed
+        unsigned int myLevel;
+
+    };
+
+    /** @brief Performs the lane changing on the worker pool
+     *
+     * Edges are changed in the same order as without the pool. Each edge gets
+     *  a level which is higher than the ones of all edges before it that use an
+     *  edge it uses, too: lane changing writes the own edge and the edges
+     *  partially occupied by the vehicles and reads the edges the vehicles'
+     *  best lanes are computed for. Edges which may notify move reminders are
+     *  chained as well, as detectors may be shared. The levels are processed
+     *  one after another, the edges within a level in parallel, so the result
+     *  does not depend on the number of threads.
+     *
+     * The lane changers' debug output is buffered and written in the edge order;
+     *  lanes which got active are collected afterwards in this order, too.
+     *
+     * @param[in] t The current time step
+     */
+    void changeLanesParallel(SUMOTime t) throw();
+
+    /** @brief Raises the level by the levels of the last edges using the given ones
+     * @param[in] edges The edges used
+     * @param[in] write Whether the edges are written
+     * @param[in, out] level The level to raise
+     */
+    void raiseLaneChangeLevel(const std::vector<const MSEdge*> &edges, bool write,
+                              unsigned int &level) const throw();
+
+    /** @brief Marks the given edges as used by the given level
+     * @param[in] edges The edges used
+     * @param[in] write Whether the edges are written
+     * @param[in] level The level using them
+     */
+    void useInLaneChangeLevel(const std::vector<const MSEdge*> &edges, bool write,
+                              unsigned int level) throw();
+
+    /// @brief The edges changed in the current step, in the order of changing
+    std::vector<MSEdge*> myChangedEdges;
+
+    /// @brief The lane changers of the current step
+    std::vector<EdgeLaneChanger> myEdgeLaneChangers;
+
+    /// @brief The lane changers of the current step as given to the worker pool, by level
+    std::vector<std::vector<WorkerPool::Task*> > myLaneChangeLevels;
+
+    /// @brief The highest level reading an edge, by the edge's numerical id
+    std::vector<unsigned int> myReadingLevel;
+
+    /** @brief The highest level writing an edge, by the edge's numerical id
+     *
+     * The additional last entry stands for the move reminders. */
+    std::vector<unsigned int> myWritingLevel;
+
+    /// @brief The numerical ids of the edges used by the current step's levels
+    std::vector<unsigned int> myLevelUsedEdges;
+
 private:
     /// @brief Copy constructor.
     MSEdgeControl(const MSEdgeControl&);
@@ -26,6 +26,9 @@
 #include <config.h>
 #endif
 
+#include <cassert>
+#include <utils/common/StdDefs.h>
+#include "MSEdge.h"
 #include "MSEdgeWeightsStorage.h"
 
 #ifdef CHECK_MEMORY_LEAKS
@@ -47,32 +50,16 @@ MSEdgeWeightsStorage::~MSEdgeWeightsStorage() throw() {
 bool
 MSEdgeWeightsStorage::retrieveExistingTravelTime(const MSEdge * const e, const SUMOVehicle * const v,
         SUMOReal t, SUMOReal &value) const throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::const_iterator i = myTravelTimes.find((MSEdge*) e);
-    if (i==myTravelTimes.end()) {
-        return false;
-    }
-    const ValueTimeLine<SUMOReal> &tl = (*i).second;
-    if (!tl.describesTime(t)) {
-        return false;
-    }
-    value = tl.getValue(t);
-    return true;
+    const TimeLine * const tl = getTimeLine(myTravelTimes, e);
+    return tl!=0 && tl->retrieve(t, value);
 }
 
 
 bool
 MSEdgeWeightsStorage::retrieveExistingEffort(const MSEdge * const e, const SUMOVehicle * const v,
         SUMOReal t, SUMOReal &value) const throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::const_iterator i = myEfforts.find((MSEdge*) e);
-    if (i==myEfforts.end()) {
-        return false;
-    }
-    const ValueTimeLine<SUMOReal> &tl = (*i).second;
-    if (!tl.describesTime(t)) {
-        return false;
-    }
-    value = tl.getValue(t);
-    return true;
+    const TimeLine * const tl = getTimeLine(myEfforts, e);
+    return tl!=0 && tl->retrieve(t, value);
 }
 
 
@@ -80,12 +67,7 @@ void
 MSEdgeWeightsStorage::addTravelTime(const MSEdge * const e,
                                     SUMOReal begin, SUMOReal end,
                                     SUMOReal value) throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::iterator i = myTravelTimes.find((MSEdge*) e);
-    if (i==myTravelTimes.end()) {
-        myTravelTimes[(MSEdge*)e] = ValueTimeLine<SUMOReal>();
-        i = myTravelTimes.find((MSEdge*) e);
-    }
-    (*i).second.add(begin, end, value);
+    getTimeLine(myTravelTimes, e).add(begin, end, value);
 }
 
 
@@ -93,45 +75,155 @@ void
 MSEdgeWeightsStorage::addEffort(const MSEdge * const e,
                                 SUMOReal begin, SUMOReal end,
                                 SUMOReal value) throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::iterator i = myEfforts.find((MSEdge*) e);
-    if (i==myEfforts.end()) {
-        myEfforts[(MSEdge*)e] = ValueTimeLine<SUMOReal>();
-        i = myEfforts.find((MSEdge*) e);
-    }
-    (*i).second.add(begin, end, value);
+    getTimeLine(myEfforts, e).add(begin, end, value);
 }
 
 
 void
 MSEdgeWeightsStorage::removeTravelTime(const MSEdge * const e) throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::iterator i = myTravelTimes.find((MSEdge*) e);
-    if (i!=myTravelTimes.end()) {
-        myTravelTimes.erase(i);
+    if (e->getNumericalID()<myTravelTimes.size()) {
+        myTravelTimes[e->getNumericalID()].clear();
     }
 }
 
 
 void
 MSEdgeWeightsStorage::removeEffort(const MSEdge * const e) throw() {
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> >::iterator i = myEfforts.find((MSEdge*) e);
-    if (i!=myEfforts.end()) {
-        myEfforts.erase(i);
+    if (e->getNumericalID()<myEfforts.size()) {
+        myEfforts[e->getNumericalID()].clear();
     }
 }
 
 
 bool
 MSEdgeWeightsStorage::knowsTravelTime(const MSEdge * const e) const throw() {
-    return myTravelTimes.find((MSEdge*) e)!=myTravelTimes.end();
+    return getTimeLine(myTravelTimes, e)!=0;
 }
 
 
 bool
 MSEdgeWeightsStorage::knowsEffort(const MSEdge * const e) const throw() {
-    return myEfforts.find((MSEdge*) e)!=myEfforts.end();
+    return getTimeLine(myEfforts, e)!=0;
 }
 
 
+const MSEdgeWeightsStorage::TimeLine *
+MSEdgeWeightsStorage::getTimeLine(const std::vector<TimeLine> &lines, const MSEdge * const e) throw() {
+    const size_t id = e->getNumericalID();
+    if (id>=lines.size()||lines[id].empty()) {
+        return 0;
+    }
+    return &lines[id];
+}
+
+
+MSEdgeWeightsStorage::TimeLine &
+MSEdgeWeightsStorage::getTimeLine(std::vector<TimeLine> &lines, const MSEdge * const e) throw() {
+    const size_t id = e->getNumericalID();
+    if (id>=lines.size()) {
+        lines.resize(id+1);
+    }
+    return lines[id];
+}
+
+
+// ---------------------------------------------------------------------------
+// MSEdgeWeightsStorage::TimeLine - methods
+// ---------------------------------------------------------------------------
+void
+MSEdgeWeightsStorage::TimeLine::add(SUMOReal begin, SUMOReal end, SUMOReal value) throw() {
+    assert(begin<end);
+    Interval added;
+    added.begin = begin;
+    added.end = end;
+    added.value = value;
+    if (myIntervals.empty()||begin>=myIntervals.back().end) {
+        // the usual case of intervals given in order
+        if (myIntervals.empty()) {
+            myBinWidth = end - begin;
+        } else if (myBinWidth>0
+                   && (begin!=myIntervals.back().end || end-begin!=myBinWidth)) {
+            myBinWidth = -1;
+        }
+        myIntervals.push_back(added);
+        return;
+    }
+    // keep the parts of the stored intervals the new one does not cover
+    std::vector<Interval> result;
+    result.reserve(myIntervals.size()+2);
+    bool inserted = false;
+    for (std::vector<Interval>::const_iterator i=myIntervals.begin(); i!=myIntervals.end(); ++i) {
+        if ((*i).end<=begin) {
+            result.push_back(*i);
+            continue;
+        }
+        if ((*i).begin<begin) {
+            Interval head = *i;
+            head.end = begin;
+            result.push_back(head);
+        }
+        if ((*i).begin>=end || (*i).end>end) {
+            if (!inserted) {
+                result.push_back(added);
+                inserted = true;
+            }
+            Interval tail = *i;
+            tail.begin = MAX2((*i).begin, end);
+            result.push_back(tail);
+        }
+    }
+    if (!inserted) {
+        result.push_back(added);
+    }
+    myIntervals.swap(result);
+    // check whether the interval of a time may be computed directly
+    myBinWidth = myIntervals[0].end - myIntervals[0].begin;
+    for (size_t i=1; i<myIntervals.size(); ++i) {
+        if (myIntervals[i].begin!=myIntervals[i-1].end
+                || myIntervals[i].end-myIntervals[i].begin!=myBinWidth) {
+            myBinWidth = -1;
+            break;
+        }
+    }
+}
+
+
+bool
+MSEdgeWeightsStorage::TimeLine::retrieve(SUMOReal t, SUMOReal &value) const throw() {
+    if (myIntervals.empty()||t<myIntervals[0].begin||t>=myIntervals.back().end) {
+        return false;
+    }
+    size_t index;
+    if (myBinWidth>0) {
+        index = MIN2((size_t)((t - myIntervals[0].begin) / myBinWidth), myIntervals.size()-1);
+        // correct rounding errors
+        if (t<myIntervals[index].begin) {
+            --index;
+        } else if (t>=myIntervals[index].end) {
+            ++index;
+        }
+    } else {
+        // the last interval beginning at or before t
+        size_t lower = 0;
+        size_t upper = myIntervals.size();
+        while (upper-lower>1) {
+            const size_t middle = (lower + upper) / 2;
+            if (myIntervals[middle].begin<=t) {
+                lower = middle;
+            } else {
+                upper = middle;
+            }
+        }
+        index = lower;
+    }
+    if (t<myIntervals[index].begin||t>=myIntervals[index].end) {
+        // a gap
+        return false;
+    }
+    value = myIntervals[index].value;
+    return true;
+}
+
 
 /****************************************************************************/
 
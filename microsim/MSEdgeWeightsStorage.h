@@ -29,8 +29,8 @@
 #include <config.h>
 #endif
 
+#include <vector>
 #include <utils/common/SUMOTime.h>
-#include <utils/common/ValueTimeLine.h>
 
 
 // ===========================================================================
@@ -46,6 +46,11 @@ class SUMOVehicle;
 /**
  * @class MSEdgeWeightsStorage
  * @brief A storage for edge travel times and efforts
+ *
+ * The values are stored per edge in vectors indexed by the edges' numerical
+ *  ids. The values of an edge are kept as a sorted array of non-overlapping
+ *  time intervals; if these are contiguous and of equal length, as when read
+ *  from aggregated weight files, the interval for a time is computed directly.
  */
 class MSEdgeWeightsStorage {
 public:
@@ -124,11 +129,80 @@ public:
 
 
 private:
-    /// @brief A map of edge->time->travel time
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> > myTravelTimes;
+    /**
+     * @class TimeLine
+     * @brief The values of a single edge, stored as sorted, non-overlapping intervals
+     */
+    class TimeLine {
+    public:
+        /// @brief Constructor
+        TimeLine() throw() : myBinWidth(-1) { }
+
+        /** @brief Sets the value for the given time span
+         *
+         * The values of previously added intervals are overwritten where they overlap.
+         *  An interval behind all stored ones is appended in constant time; others
+         *  rebuild the stored intervals.
+         */
+        void add(SUMOReal begin, SUMOReal end, SUMOReal value) throw();
+
+        /** @brief Returns the value for the given time if it is described
+         * @param[in] t The time for which the value shall be retrieved
+         * @param[out] value The value if the time is described
+         * @return Whether the time is described
+         */
+        bool retrieve(SUMOReal t, SUMOReal &value) const throw();
+
+        /// @brief Returns whether no value is stored
+        bool empty() const throw() {
+            return myIntervals.empty();
+        }
+
+        /// @brief Removes all values
+        void clear() throw() {
+            myIntervals.clear();
+            myBinWidth = -1;
+        }
+
+    private:
+        /// @brief A time span and its value
+        struct Interval {
+            SUMOReal begin;
+            SUMOReal end;
+            SUMOReal value;
+        };
+
+        /// @brief The intervals, sorted by their begin
+        std::vector<Interval> myIntervals;
+
+        /// @brief The length of all intervals if they are contiguous and equally long, -1 otherwise
+        SUMOReal myBinWidth;
+
+    };
+
+
+    /** @brief Returns the time line of the given edge, 0 if none is stored
+     * @param[in] lines The time lines to search in
+     * @param[in] e The edge to get the time line of
+     * @return The edge's time line, 0 if the edge is not described
+     */
+    static const TimeLine *getTimeLine(const std::vector<TimeLine> &lines, const MSEdge * const e) throw();
+
+
+    /** @brief Returns the time line of the given edge, building it if needed
+     * @param[in] lines The time lines to search in
+     * @param[in] e The edge to get the time line of
+     * @return The edge's time line
+     */
+    static TimeLine &getTimeLine(std::vector<TimeLine> &lines, const MSEdge * const e) throw();
+
+
+private:
+    /// @brief The travel times by the edges' numerical ids
+    std::vector<TimeLine> myTravelTimes;
 
-    /// @brief A map of edge->time->effort
-    std::map<MSEdge*, ValueTimeLine<SUMOReal> > myEfforts;
+    /// @brief The efforts by the edges' numerical ids
+    std::vector<TimeLine> myEfforts;
 
 
 private:
@@ -219,11 +219,9 @@ MSEmitControl::checkFlows(SUMOTime time,
                 }
             } else {
                 // strange: another vehicle with the same id already exists
-#ifdef HAVE_MESOSIM
                 if (MSGlobals::gStateLoaded) {
                     break;
                 }
-#endif
                 throw ProcessError("Another vehicle with the id '" + newPars->id + "' exists.");
             }
         }
@@ -37,6 +37,7 @@
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/ToString.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/OutputDevice_File.h>
 #include <microsim/MSJunction.h>
 #include <microsim/MSNet.h>
 #include <microsim/MSGlobals.h>
@@ -77,9 +78,12 @@ MSFrame::fillOptions() {
     oc.addSynonyme("net-file", "net");
     oc.addDescription("net-file", "Input", "Load road network description from FILE");
 
+    oc.doRegister("net-cache", new Option_Bool(false));
+    oc.addDescription("net-cache", "Input", "Keeps a binary copy of each net-file in FILE.bin, rebuilt if FILE changed");
+
     oc.doRegister("route-files", 'r', new Option_FileName());
     oc.addSynonyme("route-files", "routes");
-    oc.addDescription("route-files", "Input", "Load routes descriptions from FILE(s)");
+    oc.addDescription("route-files", "Input", "Load routes descriptions from FILE(s) (XML or binary, see route2bin)");
 
     oc.doRegister("additional-files", 'a', new Option_FileName());
     oc.addSynonyme("additional-files", "additional");
@@ -91,12 +95,10 @@ MSFrame::fillOptions() {
     oc.doRegister("measure", 'm', new Option_String()); // !!! describe
     oc.addDescription("measure", "Input", "Load <measure> from weights");
 
-#ifdef HAVE_MESOSIM
-    oc.doRegister("load-state", new Option_FileName());//!!! check, describe
+    oc.doRegister("load-state", new Option_FileName());
     oc.addDescription("load-state", "Input", "Loads a network state from FILE");
-    oc.doRegister("load-state.offset", new Option_String("0", "TIME"));//!!! check, describe
-    oc.addDescription("load-state.offset", "Input", "Sets the time offset for vehicle segment exit times.");
-#endif
+    oc.doRegister("load-state.offset", new Option_String("0", "TIME"));
+    oc.addDescription("load-state.offset", "Input", "Sets the time offset for vehicle departure and segment exit times.");
 
     // register output options
     oc.doRegister("netstate-dump", new Option_FileName());
@@ -105,6 +107,10 @@ MSFrame::fillOptions() {
     oc.addDescription("netstate-dump", "Output", "Save complete network states into FILE");
     oc.doRegister("dump-empty-edges", new Option_Bool(false));
     oc.addDescription("dump-empty-edges", "Output", "Write also empty edges completely when dumping");
+    oc.doRegister("netstate-dump.binary", new Option_Bool(false));
+    oc.addDescription("netstate-dump.binary", "Output", "Write the network states as columnar binary frames (see netstate2xml)");
+    oc.doRegister("netstate-dump.delta", new Option_Integer(0));
+    oc.addDescription("netstate-dump.delta", "Output", "Delta-encode binary network states, writing a full frame every INT frames");
 
     oc.doRegister("emissions-output", new Option_FileName());
     oc.addSynonyme("emissions-output", "emissions");
@@ -126,14 +132,25 @@ MSFrame::fillOptions() {
     oc.addSynonyme("vehroute-output.last-route", "vehroutes.last-route");
     oc.addDescription("vehroute-output.last-route", "Output", "Write the last route only");
 
-#ifdef HAVE_MESOSIM
-    oc.doRegister("save-state.times", new Option_IntVector(IntVector()));//!!! check, describe
+    oc.doRegister("profile-output", new Option_FileName());
+    oc.addDescription("profile-output", "Output", "Save the durations of the simulation step phases into FILE");
+
+    oc.doRegister("profile-steps-output", new Option_FileName());
+    oc.addDescription("profile-steps-output", "Output", "Save the step phases' durations of each step as CSV into FILE");
+
+    oc.doRegister("save-state.times", new Option_IntVector(IntVector()));
     oc.addDescription("save-state.times", "Output", "Use INT[] as times at which a network state written");
-    oc.doRegister("save-state.prefix", new Option_FileName());//!!! check, describe
+    oc.doRegister("save-state.prefix", new Option_FileName());
     oc.addDescription("save-state.prefix", "Output", "Prefix for network states");
-    oc.doRegister("save-state.files", new Option_FileName());//!!! check, describe
+    oc.doRegister("save-state.files", new Option_FileName());
     oc.addDescription("save-state.files", "Output", "Files for network states");
-#endif
+
+    oc.doRegister("async-output", new Option_Bool(false));
+    oc.addDescription("async-output", "Output", "Write output files using a writer thread per file");
+    oc.doRegister("async-output.buffer-size", new Option_Integer(1024));
+    oc.addDescription("async-output.buffer-size", "Output", "Use buffers of INT kB for asynchronous output");
+    oc.doRegister("async-output.buffers", new Option_Integer(4));
+    oc.addDescription("async-output.buffers", "Output", "Use INT buffers per asynchronously written file");
 
     // register the simulation settings
     oc.doRegister("begin", 'b', new Option_String("0", "TIME"));
@@ -177,6 +194,18 @@ MSFrame::fillOptions() {
     oc.doRegister("sloppy-emit", new Option_Bool(false));
     oc.addDescription("sloppy-emit", "Processing", "Whether emission on an edge shall not be repeated in same step once failed.");
 
+    oc.doRegister("threads", new Option_Integer(1));
+    oc.addDescription("threads", "Processing", "Use INT threads for computing the vehicles' movement");
+
+    oc.doRegister("fork.time", new Option_String("-1", "TIME"));
+    oc.addDescription("fork.time", "Processing", "Forks one process per variant at TIME");
+
+    oc.doRegister("fork.variants", new Option_String());
+    oc.addDescription("fork.variants", "Processing", "The variants to fork; each is an additional file or tls:ID:PROGRAM");
+
+    oc.doRegister("fork.output-prefix", new Option_FileName("variant"));
+    oc.addDescription("fork.output-prefix", "Processing", "The outputs of variant INDEX are written into the directory <STR>INDEX");
+
     // devices
     MSDevice_Routing::insertOptions();
     MSDevice_HBEFA::insertOptions();
@@ -268,11 +297,14 @@ MSFrame::fillOptions() {
 
 void
 MSFrame::buildStreams() throw(IOError) {
+    OptionsCont &oc = OptionsCont::getOptions();
     // standard outputs
-    OutputDevice::createDeviceByOption("netstate-dump", "sumo-netstate");
+    OutputDevice::createDeviceByOption("netstate-dump", oc.getBool("netstate-dump.binary") ? "" : "sumo-netstate");
     OutputDevice::createDeviceByOption("emissions-output", "emissions");
     OutputDevice::createDeviceByOption("tripinfo-output", "tripinfos");
     OutputDevice::createDeviceByOption("vehroute-output", "routes");
+    OutputDevice::createDeviceByOption("profile-output", "step-profile");
+    OutputDevice::createDeviceByOption("profile-steps-output");
 }
 
 
@@ -300,10 +332,52 @@ MSFrame::checkOptions() {
             ok = false;
         }
     }
+    if (oc.getInt("threads")<1) {
+        MsgHandler::getErrorInstance()->inform("The number of threads must be at least 1.");
+        ok = false;
+    }
+    if (oc.getInt("async-output.buffer-size")<1 || oc.getInt("async-output.buffers")<2) {
+        MsgHandler::getErrorInstance()->inform("Asynchronous output needs at least two buffers of at least 1 kB.");
+        ok = false;
+    }
+    if (oc.getInt("netstate-dump.delta")<0) {
+        MsgHandler::getErrorInstance()->inform("The key frame interval of the netstate dump must not be negative.");
+        ok = false;
+    }
+    if (oc.getInt("device.routing.landmarks")<0) {
+        MsgHandler::getErrorInstance()->inform("The number of routing landmarks must not be negative.");
+        ok = false;
+    }
+    if (oc.getString("device.routing.algorithm")!="dijkstra" && oc.getString("device.routing.algorithm")!="CH") {
+        MsgHandler::getErrorInstance()->inform("Unknown routing algorithm '" + oc.getString("device.routing.algorithm") + "'.");
+        ok = false;
+    }
+#ifdef HAVE_MESOSIM
+    if (oc.getBool("netstate-dump.binary") && oc.getBool("mesosim")) {
+        MsgHandler::getErrorInstance()->inform("The binary netstate dump is not available for the mesoscopic simulation.");
+        ok = false;
+    }
+#endif
     if (oc.getBool("vehroutes.exit-times") && !oc.isSet("vehroutes")) {
         MsgHandler::getErrorInstance()->inform("A vehroute-output file is needed for exit times.");
         ok = false;
     }
+    if (oc.isSet("fork.variants")) {
+#ifdef WIN32
+        MsgHandler::getErrorInstance()->inform("Forking variants is not supported on this platform.");
+        ok = false;
+#endif
+        if (string2time(oc.getString("fork.time"))<string2time(oc.getString("begin"))) {
+            MsgHandler::getErrorInstance()->inform("The fork time must not lie before the begin of the simulation.");
+            ok = false;
+        }
+#ifndef NO_TRACI
+        if (oc.getInt("remote-port")!=0) {
+            MsgHandler::getErrorInstance()->inform("Variants cannot be forked while a TraCI client is connected.");
+            ok = false;
+        }
+#endif
+    }
     return ok;
 }
 
@@ -323,9 +397,12 @@ MSFrame::setMSGlobals(OptionsCont &oc) {
     MSGlobals::gTimeToGridlock = string2time(oc.getString("time-to-teleport"))<0 ? 0 : string2time(oc.getString("time-to-teleport"));
     //
     MSGlobals::gCheck4Accidents = !oc.getBool("ignore-accidents");
-#ifdef HAVE_MESOSIM
+    //
+    MSGlobals::gNumThreads = oc.getInt("threads");
     MSGlobals::gStateLoaded = oc.isSet("load-state");
-#endif
+    //
+    OutputDevice_File::setAsynchronous(oc.getBool("async-output") ? (size_t) oc.getInt("async-output.buffer-size") * 1024 : 0,
+                                       (unsigned int) oc.getInt("async-output.buffers"));
     //
 #ifdef HAVE_SUBSECOND_TIMESTEPS
     DELTA_T = string2time(oc.getString("step-length"));
@@ -45,9 +45,9 @@ SUMOTime MSGlobals::gTimeToGridlock = TIME2STEPS(300);
 
 bool MSGlobals::gCheck4Accidents;
 
-#ifdef HAVE_MESOSIM
+unsigned int MSGlobals::gNumThreads = 1;
+
 bool MSGlobals::gStateLoaded;
-#endif
 
 #ifdef HAVE_MESOSIM
 bool MSGlobals::gUseMesoSim;
@@ -64,10 +64,11 @@ public:
     /** information whether the network shall check for collisions */
     static bool gCheck4Accidents;
 
-#ifdef HAVE_MESOSIM
+    /// The number of threads used for moving vehicles
+    static unsigned int gNumThreads;
+
     /// Information whether a state has been loaded
     static bool gStateLoaded;
-#endif
 
 #ifdef HAVE_MESOSIM
     /** Information whether mesosim shall be used */
@@ -0,0 +1,85 @@
+/****************************************************************************/
+/// @file    MSKinematicStore.cpp
+/// @author  agent
+/// @date    Fri, 16 Oct 2026
+/// @version $Id: MSKinematicStore.cpp $
+///
+// Simulation-wide storage of the vehicles' per-step kinematic values
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include "MSKinematicStore.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+std::vector<SUMOReal> MSKinematicStore::myPositions;
+std::vector<SUMOReal> MSKinematicStore::mySpeeds;
+std::vector<SUMOReal> MSKinematicStore::myPreDawdleAccelerations;
+std::vector<SUMOReal> MSKinematicStore::myLengths;
+std::vector<size_t> MSKinematicStore::myStripWidths;
+std::vector<unsigned int> MSKinematicStore::myGenerations;
+std::vector<MSKinematicStore::Slot> MSKinematicStore::myFreeSlots;
+
+
+// ===========================================================================
+// static method definitions
+// ===========================================================================
+MSKinematicStore::Slot
+MSKinematicStore::allocate(SUMOReal length, size_t stripWidth) throw() {
+    Slot slot;
+    if (!myFreeSlots.empty()) {
+        slot = myFreeSlots.back();
+        myFreeSlots.pop_back();
+    } else {
+        slot = (Slot) myPositions.size();
+        myPositions.push_back(0);
+        mySpeeds.push_back(0);
+        myPreDawdleAccelerations.push_back(0);
+        myLengths.push_back(0);
+        myStripWidths.push_back(0);
+        myGenerations.push_back(0);
+    }
+    myPositions[slot] = 0;
+    mySpeeds[slot] = 0;
+    myPreDawdleAccelerations[slot] = 0;
+    myLengths[slot] = length;
+    myStripWidths[slot] = stripWidth;
+    ++myGenerations[slot];
+    return slot;
+}
+
+
+void
+MSKinematicStore::release(Slot slot) throw() {
+    myFreeSlots.push_back(slot);
+}
+
+
+
+/****************************************************************************/
+
@@ -0,0 +1,176 @@
+/****************************************************************************/
+/// @file    MSKinematicStore.h
+/// @author  agent
+/// @date    Fri, 16 Oct 2026
+/// @version $Id: MSKinematicStore.h $
+///
+// Simulation-wide storage of the vehicles' per-step kinematic values
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSKinematicStore_h
+#define MSKinematicStore_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <cstddef>
+#include <utils/common/StdDefs.h>
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSKinematicStore
+ * @brief Simulation-wide storage of the vehicles' per-step kinematic values
+ *
+ * Each vehicle obtains a slot on construction and returns it on destruction.
+ *  The values of all vehicles are kept in one array per value, indexed by the
+ *  slot, so that loops over many vehicles (e.g. over a strip's vehicles, see
+ *  MSStrip::getSlots) read contiguous memory instead of visiting each vehicle.
+ *
+ * The vehicle keeps its own state; it writes each change through to the store.
+ *  Freed slots are reused first, so the arrays stay as dense as the number of
+ *  vehicles existing at the same time allows.
+ *
+ * The store is read by the strips' leader and safe speed computation
+ *  (MSStrip::computeLeaderVSafes), their collision check and the binary
+ *  netstate output; the vehicles still integrate their own states when moving.
+ *
+ * Slots are obtained and released by the simulation thread only. Different
+ *  slots may be written concurrently.
+ */
+class MSKinematicStore {
+public:
+    /// @brief Definition of a vehicle's index within the store
+    typedef unsigned int Slot;
+
+
+    /** @brief Returns a free slot
+     * @param[in] length The vehicle's length
+     * @param[in] stripWidth The number of strips the vehicle occupies
+     * @return The slot to use
+     */
+    static Slot allocate(SUMOReal length, size_t stripWidth) throw();
+
+
+    /** @brief Marks the slot as free
+     * @param[in] slot The slot to release
+     */
+    static void release(Slot slot) throw();
+
+
+    /** @brief Sets the position and the speed
+     * @param[in] slot The vehicle's slot
+     * @param[in] pos The vehicle's position on its lane
+     * @param[in] speed The vehicle's speed
+     */
+    static void setState(Slot slot, SUMOReal pos, SUMOReal speed) throw() {
+        myPositions[slot] = pos;
+        mySpeeds[slot] = speed;
+    }
+
+
+    /** @brief Sets the acceleration before dawdling
+     * @param[in] slot The vehicle's slot
+     * @param[in] accel The acceleration before dawdling
+     */
+    static void setPreDawdleAcceleration(Slot slot, SUMOReal accel) throw() {
+        myPreDawdleAccelerations[slot] = accel;
+    }
+
+
+    /// @name Retrieval of the stored values, indexed by the slot
+    /// @{
+
+    /// @brief Returns the positions on the lanes
+    static const std::vector<SUMOReal> &getPositions() throw() {
+        return myPositions;
+    }
+
+    /// @brief Returns the speeds
+    static const std::vector<SUMOReal> &getSpeeds() throw() {
+        return mySpeeds;
+    }
+
+    /// @brief Returns the accelerations before dawdling
+    static const std::vector<SUMOReal> &getPreDawdleAccelerations() throw() {
+        return myPreDawdleAccelerations;
+    }
+
+    /// @brief Returns the vehicles' lengths
+    static const std::vector<SUMOReal> &getLengths() throw() {
+        return myLengths;
+    }
+
+    /// @brief Returns the numbers of strips the vehicles occupy
+    static const std::vector<size_t> &getStripWidths() throw() {
+        return myStripWidths;
+    }
+
+    /// @brief Returns how often each slot was allocated (tells a reused slot from its former owner)
+    static const std::vector<unsigned int> &getGenerations() throw() {
+        return myGenerations;
+    }
+    /// @}
+
+
+    /** @brief Returns the number of slots including the free ones
+     * @return The size of the stored arrays
+     */
+    static size_t size() throw() {
+        return myPositions.size();
+    }
+
+
+private:
+    /// @brief The positions on the lanes
+    static std::vector<SUMOReal> myPositions;
+
+    /// @brief The speeds
+    static std::vector<SUMOReal> mySpeeds;
+
+    /// @brief The accelerations before dawdling
+    static std::vector<SUMOReal> myPreDawdleAccelerations;
+
+    /// @brief The vehicles' lengths
+    static std::vector<SUMOReal> myLengths;
+
+    /// @brief The numbers of strips the vehicles occupy
+    static std::vector<size_t> myStripWidths;
+
+    /// @brief The numbers of allocations of the slots
+    static std::vector<unsigned int> myGenerations;
+
+    /// @brief The released slots, reused last-in first-out
+    static std::vector<Slot> myFreeSlots;
+
+
+private:
+    /// @brief Invalidated constructor (static storage only)
+    MSKinematicStore();
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
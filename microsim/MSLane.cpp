@@ -54,6 +54,8 @@
 #include <utils/common/ToString.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/HelpersHarmonoise.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -78,7 +80,7 @@ MSLane::MSLane(const std::string &id, SUMOReal maxSpeed, SUMOReal length,
 	myStrips(), //TODO: refactor out myVehicles
         myVehicles(), myLength(length), myEdge(edge), myMaxSpeed(maxSpeed),
         myAllowedClasses(allowed), myNotAllowedClasses(disallowed),
-        myVehicleLengthSum(0), myInlappingVehicleEnd(10000), myInlappingVehicle(0) {
+        myVehicleLengthSum(0), myVehicleNumber(0), mySpeedSum(0), myInlappingVehicleEnd(10000), myInlappingVehicle(0) {
     //std::cerr << "StripWidth is:" << stripWidth << " for lane:" << id << std::endl;
     for (unsigned int stripNumId=0; stripNumId < stripWidth; ++stripNumId) {
         myStrips.push_back (new MSStrip("strip"+toString<int>(stripNumId)+"_"+id, length, edge, this, stripNumId));
@@ -446,31 +448,9 @@ MSLane::isEmissionSuccess(MSVehicle* aVehicle,
     }
 
     // get the pointer to the vehicle next in front of the given position
-    MSVehicle *pred;
-    std::vector<MSVehicle *> predCont;
-    std::vector<MSVehicle *>::iterator predIt, it;
-    for (unsigned int i=startStripId; i<=endStripId; ++i) {
-        predCont.push_back(myStrips.at(i)->getPredAtPos(pos));
-    }
-    predIt = predCont.begin();
-    SUMOReal currMin = -1;
-    if (*predIt != 0) {
-        currMin = (*predIt)->getPositionOnLane();
-    } else {
-        // signals no leader in front
-        predIt = predCont.end();
-    }
-    for (it = predCont.begin(); it != predCont.end(); ++it) {
-        if (*it == 0) continue;
-        if ((*it)->getPositionOnLane() < currMin) {
-            predIt = it;
-            currMin = (*it)->getPositionOnLane();
-        }
-    }
-    
-    if (predIt != predCont.end()) {
+    MSVehicle *leader = getVehicleAhead(pos, startStripId, endStripId);
+    if (leader != 0) {
         // ok, there is one (a leader)
-        MSVehicle* leader = *predIt;
         SUMOReal frontGapNeeded = aVehicle->getCarFollowModel().getSecureGap(speed, leader->getCarFollowModel().getSpeedAfterMaxDecel(leader->getSpeed()));
         SUMOReal gap = MSVehicle::gap(leader->getPositionOnLane(), leader->getVehicleType().getLength(), pos);
         if (gap<frontGapNeeded) {
@@ -480,17 +460,7 @@ MSLane::isEmissionSuccess(MSVehicle* aVehicle,
     }
 
     // FIXME: implement look back
-    // check back vehicle
-    if (false/*predIt!=myVehicles.begin()*/) {
-        // there is direct follower on this lane
-        MSVehicle *follower = *(predIt-1);
-        SUMOReal backGapNeeded = follower->getCarFollowModel().getSecureGap(follower->getSpeed(), aVehicle->getCarFollowModel().getSpeedAfterMaxDecel(speed));
-        SUMOReal gap = MSVehicle::gap(pos, aVehicle->getVehicleType().getLength(), follower->getPositionOnLane());
-        if (gap<backGapNeeded) {
-            // too close to the follower on this lane
-            return false;
-        }
-    } else if (false) {
+    if (false) {
         // check approaching vehicle (consecutive follower)
         SUMOReal lspeed = getMaxSpeed();
         // in order to look back, we'd need the minimum braking ability of vehicles in the net...
@@ -608,9 +578,10 @@ MSLane::getLastVehicleInformation() const throw() {
 // ------  ------
 bool
 MSLane::moveCritical(SUMOTime t) {
-    StripContIter it = myStrips.begin();
+    // empty strips have nothing to do; strips may get emptied by collisions meanwhile
+    myStripsToProcess = myOccupiedStrips;
     bool res = true;
-    for (it; it != myStrips.end(); ++it) {
+    for (StripContIter it = myStripsToProcess.begin(); it != myStripsToProcess.end(); ++it) {
         // returns false if there is atleast one vehicle in lane
         bool empty = (*it)->moveCritical(t);
         res = res && empty;
@@ -620,9 +591,30 @@ MSLane::moveCritical(SUMOTime t) {
 }
 
 
+void
+MSLane::planMoveCritical(SUMOTime t) throw() {
+    for (StripContIter it = myOccupiedStrips.begin(); it != myOccupiedStrips.end(); ++it) {
+        (*it)->planMoveCritical(t);
+    }
+}
+
+
+bool
+MSLane::applyMoveCritical(SUMOTime t, bool &replan) {
+    myStripsToProcess = myOccupiedStrips;
+    bool res = true;
+    for (StripContIter it = myStripsToProcess.begin(); it != myStripsToProcess.end(); ++it) {
+        bool empty = (*it)->applyMoveCritical(t, replan);
+        res = res && empty;
+    }
+    return res;
+}
+
+
 void
 MSLane::detectCollisions(SUMOTime timestep) {
-    for (StripContIter strip = myStrips.begin(); strip != myStrips.end(); ++strip) {
+    myStripsToProcess = myOccupiedStrips;
+    for (StripContIter strip = myStripsToProcess.begin(); strip != myStripsToProcess.end(); ++strip) {
         (*strip)->detectCollisions(timestep);
     }
 }
@@ -650,8 +642,9 @@ getMaxSpeedRegardingNextLanes(MSVehicle& veh, SUMOReal speed, SUMOReal pos) {
 bool
 MSLane::setCritical(SUMOTime t, std::vector<MSLane*> &into) {
     // move critical vehicles
-    StripCont::iterator i;
-    for (i=myStrips.begin(); i!=myStrips.end(); ++i) {
+    //  popping a vehicle removes it from all of its strips, so iterate over a copy
+    myStripsToProcess = myOccupiedStrips;
+    for (StripContIter i=myStripsToProcess.begin(); i!=myStripsToProcess.end(); ++i) {
         (*i)->setCritical(t, into);
     }
     return getVehicleNumber()==0;
@@ -754,14 +747,35 @@ bool
 MSLane::integrateNewVehicle(SUMOTime t) {
     bool wasInactive = getVehicleNumber()==0;
     bool hasActivity = false;
-    for (StripContIter strip = myStrips.begin(); strip != myStrips.end(); ++strip) {
+    // only strips which got vehicles pushed have something to integrate
+    for (StripContIter strip = myStripsToIntegrate.begin(); strip != myStripsToIntegrate.end(); ++strip) {
         bool res = (*strip)->integrateNewVehicle(t);
         hasActivity = hasActivity || res;
     }
+    myStripsToIntegrate.clear();
     return wasInactive&&hasActivity;
 }
 
 
+void
+MSLane::stripOccupied(MSStrip *strip) throw() {
+    StripContIter i = myOccupiedStrips.begin();
+    while (i!=myOccupiedStrips.end()&&(*i)->getNumericalID()<strip->getNumericalID()) {
+        ++i;
+    }
+    assert(i==myOccupiedStrips.end()||*i!=strip);
+    myOccupiedStrips.insert(i, strip);
+}
+
+
+void
+MSLane::stripEmptied(MSStrip *strip) throw() {
+    StripContIter i = std::find(myOccupiedStrips.begin(), myOccupiedStrips.end(), strip);
+    assert(i!=myOccupiedStrips.end());
+    myOccupiedStrips.erase(i);
+}
+
+
 bool
 MSLane::isLinkEnd(MSLinkCont::const_iterator &i) const {
     return i==myLinks.end();
@@ -1130,32 +1144,11 @@ MSLane::getVehLenSum() const throw() {
 
 SUMOReal
 MSLane::getMeanSpeed() const throw() { //ashu modification 16 november
-         int temp=0; 
-     if (getVehicleNumber()==0) {
+    if (myVehicleNumber==0) {
         //return myMaxSpeed;
-         return 0; 
+        return 0;
     }
-    SUMOReal v = 0;
-    for (StripContConstIter i=myStrips.begin(); i!=myStrips.end(); ++i) {
-   
-        v += (*i)->getMeanSpeed();
-         if ((*i)->getMeanSpeed() == 0)
-             {
-                temp++;
-             }
-     }
-    SUMOReal ret = v / (SUMOReal) (myStrips.size() - temp);
-    releaseVehicles();
-    return ret;
-}
-
-unsigned int 
-MSLane::getVehicleNumber() const throw() {
-        unsigned int count = 0;
-        for (StripContConstIter it = myStrips.begin(); it != myStrips.end(); ++it) {
-            count += (*it)->getVehicleNumber();
-        }
-        return count;
+    return mySpeedSum / (SUMOReal) myVehicleNumber;
 }
 
 const std::deque< MSVehicle* > & 
@@ -1188,47 +1181,47 @@ MSLane::getRealLaneWidth() const {
 
 size_t
 MSLane::getEmptyStartStripID(size_t vehWidth) const {
-    StripCont::const_iterator strip = myStrips.begin();
-    std::vector<SUMOReal> vehPositions(myStrips.size(), getLength());
-    std::vector<SUMOReal>::iterator it, start, end;
-    size_t startPos = 0;
-    it = vehPositions.begin();
-    
     // vehPositions contains position of end of last vehicle of every strip
     // or length of lane if there is no last vehicle
-    int i=0;
-    for (i=0; strip != myStrips.end(); ++strip, ++i) {
-        MSVehicle *veh = (*strip)->getLastVehicle();     
+    std::vector<SUMOReal> vehPositions(myStrips.size(), getLength());
+    for (size_t i=0; i<myStrips.size(); ++i) {
+        MSVehicle *veh = myStrips[i]->getLastVehicle();
         if (veh != 0)
             vehPositions[i] = veh->getPositionOnLane() - veh->getVehicleType().getLength();
     }
-    assert(i==myStrips.size());
     
     // for each possible position of vehicle, find the vehicle closest to current one
-    // (in all strips current vehicle occupies)
-    std::map<size_t, SUMOReal> possiblePosn;
-    std::map<size_t, SUMOReal>::iterator pos;
-    for (size_t myStart = 0; myStart <= myStrips.size() - vehWidth; ++myStart) {
-        // find min dist among all strips that vehicle may occupy
-        start = vehPositions.begin() + myStart;
-        end = start + vehWidth;
-        it = std::min_element(start, end);
-        possiblePosn[myStart] = *it;
-    }
-    // now find the maximum among the possible start positions
-    pos = possiblePosn.begin();
-    SUMOReal currMaxPos = pos->second;
-    startPos = pos->first;
-    for (; pos != possiblePosn.end(); ++pos) {
-        if (currMaxPos < pos->second) {
-            currMaxPos = pos->second;
-            startPos = pos->first;
+    // (in all strips current vehicle occupies); choose the (first) start position
+    // where this distance is maximal
+    size_t startPos = 0;
+    SUMOReal currMaxPos = 0;
+    for (size_t myStart = 0; myStart + vehWidth <= myStrips.size(); ++myStart) {
+        std::vector<SUMOReal>::const_iterator start = vehPositions.begin() + myStart;
+        SUMOReal curr = *std::min_element(start, start + vehWidth);
+        if (myStart == 0 || currMaxPos < curr) {
+            currMaxPos = curr;
+            startPos = myStart;
         }
     }
     //std::cerr << getID() << "::getEmptyStartStrip(" << vehWidth << ") = " << startPos << std::endl;
     return startPos;
 }
 
+
+MSVehicle *
+MSLane::getVehicleAhead(SUMOReal pos, size_t firstStrip, size_t lastStrip) const throw() {
+    assert(firstStrip <= lastStrip && lastStrip < myStrips.size());
+    MSVehicle *ret = 0;
+    for (size_t i=firstStrip; i<=lastStrip; ++i) {
+        MSVehicle *curr = myStrips[i]->getPredAtPos(pos);
+        if (curr != 0 && (ret == 0 || curr->getPositionOnLane() < ret->getPositionOnLane())) {
+            ret = curr;
+        }
+    }
+    return ret;
+}
+
+
 MSVehicle *
 MSLane::getPartialOccupator(unsigned int startStrip, unsigned int endStrip) const throw() {
     if (endStrip == 0) endStrip = myStrips.size()-1;
@@ -1264,4 +1257,32 @@ MSLane::printDebugMsg(const std::string &msg) const {
         (*it)->printDebugMsg();
     }
 }
+
+
+void
+MSLane::saveState(std::ostream &os) throw() {
+    FileHelpers::writeUInt(os, (unsigned int) myStrips.size());
+    for (StripContConstIter i=myStrips.begin(); i!=myStrips.end(); ++i) {
+        (*i)->saveState(os);
+    }
+}
+
+
+bool
+MSLane::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    unsigned int size;
+    bis >> size;
+    if (size!=myStrips.size()) {
+        MsgHandler::getErrorInstance()->inform("The state describes " + toString(size) + " strips for lane '" + getID() + "' which has " + toString(myStrips.size()) + ".");
+        return false;
+    }
+    bool wasInactive = getVehicleNumber()==0;
+    for (StripContIter i=myStrips.begin(); i!=myStrips.end(); ++i) {
+        (*i)->loadState(bis, vc);
+    }
+    if (wasInactive&&getVehicleNumber()!=0) {
+        MSNet::getInstance()->getEdgeControl().gotActive(this);
+    }
+    return true;
+}
 /****************************************************************************/
@@ -56,7 +56,9 @@ class MSMoveReminder;
 class GUILaneWrapper;
 class GUIGlObjectStorage;
 class MSVehicleTransfer;
+class MSVehicleControl;
 class OutputDevice;
+class BinaryInputDevice;
 
 
 // ===========================================================================
@@ -262,13 +264,35 @@ public:
 
 
 
+    /// @name Neighbour queries over a range of strips
+    /// @{
+
+    /** @brief Returns the nearest vehicle at or ahead of the given position on the given strips
+     *
+     * The strips' vehicle containers are sorted by position and thereby used
+     *  as index; each strip is asked using a binary search, so the costs are
+     *  O((lastStrip-firstStrip+1) log n). There is no index shared by the whole
+     *  lane; only the emission uses this method, the strip changer and the
+     *  collision check still walk the strips themselves.
+     * @param[in] pos The position to look from
+     * @param[in] firstStrip The numerical id of the first strip to regard
+     * @param[in] lastStrip The numerical id of the last strip to regard
+     * @return The vehicle with the smallest position not smaller than pos, 0 if there is none
+     */
+    MSVehicle *getVehicleAhead(SUMOReal pos, size_t firstStrip, size_t lastStrip) const throw();
+    /// @}
+
+
+
     /// @name Access to vehicles
     /// @{
 
     /** @brief Returns the number of vehicles on this lane
      * @return The number of vehicles on this lane
      */
-    unsigned int getVehicleNumber() const throw();
+    unsigned int getVehicleNumber() const throw() {
+        return myVehicleNumber;
+    }
 
     /** @brief Returns the vehicles container; locks it for microsimulation
      *
@@ -355,6 +379,25 @@ public:
 
     virtual bool moveCritical(SUMOTime t);
 
+
+    /** @brief Plans the moves of the vehicles on the lane's strips
+     *
+     * Changes only the lane's strips' plans and the planned vehicles; see
+     *  MSStrip::planMoveCritical. May be run in parallel for different lanes.
+     *
+     * @param[in] t The current time step
+     */
+    void planMoveCritical(SUMOTime t) throw();
+
+
+    /** @brief Applies the planned moves; yields the same as moveCritical
+     *
+     * @param[in] t The current time step
+     * @param[in, out] replan Whether the plans may be outdated; see MSStrip::applyMoveCritical
+     * @return Whether the lane is empty afterwards
+     */
+    virtual bool applyMoveCritical(SUMOTime t, bool &replan);
+
     /** Moves the critical vehicles
         This step is done after the responds have been set */
     virtual bool setCritical(SUMOTime t, std::vector<MSLane*> &into);
@@ -500,7 +543,7 @@ public:
     //@{
 
     /** @brief Returns the mean speed on this lane
-     * @return The average speed of vehicles during the last step; default speed if no vehicle was on this lane
+     * @return The average speed of vehicles during the last step; 0 if no vehicle was on this lane
      */
     SUMOReal getMeanSpeed() const throw();
 
@@ -545,6 +588,27 @@ public:
     }
     
     void printDebugMsg(const std::string &msg="") const;
+
+
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the order of the vehicles within the lane's strips
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Puts the loaded vehicles into the lane's strips in the saved order
+     *
+     * Lanes which get occupied are reported to the edge control as active.
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     * @return Whether the saved strips match the lane
+     */
+    bool loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
+
 protected:
     /** @brief Insert a vehicle into the lane's vehicle buffer.
         After processing done from moveCritical, when a vehicle exits it's lane.
@@ -562,6 +626,22 @@ protected:
      */
     size_t getEmptyStartStripID(size_t vehWidth) const;
 
+
+    /// @name Maintenance of the occupied strips list (called by the strips)
+    /// @{
+
+    /** @brief Adds the strip to the occupied ones, keeping the numerical id order
+     * @param[in] strip The strip which got its first vehicle
+     */
+    void stripOccupied(MSStrip *strip) throw();
+
+
+    /** @brief Removes the strip from the occupied ones
+     * @param[in] strip The strip which lost its last vehicle
+     */
+    void stripEmptied(MSStrip *strip) throw();
+    /// @}
+
 protected:
     /// Unique ID.
     std::string myID;
@@ -618,6 +698,21 @@ protected:
     /// @brief The current length of all vehicles on this lane
     SUMOReal myVehicleLengthSum;
 
+    /// @brief The number of vehicles on this lane's strips (maintained by the strips)
+    unsigned int myVehicleNumber;
+
+    /// @brief The sum of the speeds of the vehicles counted in myVehicleNumber (maintained by the strips)
+    SUMOReal mySpeedSum;
+
+    /// @brief The strips which hold vehicles, sorted by their numerical id
+    StripCont myOccupiedStrips;
+
+    /// @brief The strips which got vehicles into their buffer during this step
+    StripCont myStripsToIntegrate;
+
+    /// @brief Copy of myOccupiedStrips to iterate over while strips may get emptied
+    StripCont myStripsToProcess;
+
     /// @brief End position of a vehicle which laps into this lane
     SUMOReal myInlappingVehicleEnd;
 
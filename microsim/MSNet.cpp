@@ -63,6 +63,7 @@
 #include <utils/shapes/Polygon2D.h>
 #include <utils/shapes/ShapeContainer.h>
 #include "output/MSXMLRawOut.h"
+#include "output/MSBinaryRawOut.h"
 #include <utils/iodevices/OutputDevice.h>
 #include <utils/common/SysUtils.h>
 #include <utils/common/WrappingCommand.h>
@@ -74,6 +75,7 @@
 #include <ctime>
 #include "MSPerson.h"
 #include "MSEdgeWeightsStorage.h"
+#include "MSScenarioFork.h"
 
 
 #ifdef _MESSAGES
@@ -82,8 +84,9 @@
 
 #ifdef HAVE_MESOSIM
 #include <mesosim/MELoop.h>
-#include <utils/iodevices/BinaryInputDevice.h>
 #endif
+#include <utils/iodevices/BinaryInputDevice.h>
+#include <utils/common/RandHelper.h>
 
 #ifndef NO_TRACI
 #include <traci-server/TraCIServer.h>
@@ -98,6 +101,7 @@
 // static member definitions
 // ===========================================================================
 MSNet* MSNet::myInstance = 0;
+const unsigned int MSNet::STATE_FORMAT_VERSION = 2;
 
 
 // ===========================================================================
@@ -161,6 +165,9 @@ MSNet::MSNet(MSVehicleControl *vc, MSEventControl *beginOfTimestepEvents,
     myStep = string2time(oc.getString("begin"));
     myLogExecutionTime = !oc.getBool("no-duration-log");
     myLogStepNumber = !oc.getBool("no-step-log");
+    myProfiler = 0;
+    myScenarioFork = 0;
+    myBinaryRawOut = 0;
     myTooManyVehicles = oc.getInt("too-many-vehicles");
     myEmitter = new MSEmitControl(*vc, (SUMOTime) oc.getInt("max-depart-delay"), oc.getBool("sloppy-emit"));// !!! SUMOTime-option
     myVehicleControl = vc;
@@ -228,6 +235,23 @@ MSNet::closeBuilding(MSEdgeControl *edges, MSJunctionControl *junctions,
     if (myLogExecutionTime) {
         mySimBeginMillis = SysUtils::getCurrentMillis();
     }
+    OptionsCont &oc = OptionsCont::getOptions();
+    if (oc.isSet("profile-output")||oc.isSet("profile-steps-output")) {
+        myProfiler = new MSStepProfiler(
+            oc.isSet("profile-output") ? &OutputDevice::getDeviceByOption("profile-output") : 0,
+            oc.isSet("profile-steps-output") ? &OutputDevice::getDeviceByOption("profile-steps-output") : 0);
+    }
+    if (oc.isSet("netstate-dump")&&oc.getBool("netstate-dump.binary")) {
+        myBinaryRawOut = new MSBinaryRawOut(OutputDevice::getDeviceByOption("netstate-dump"), *myEdges,
+                                            (unsigned int) oc.getInt("netstate-dump.delta"), MSGlobals::gOmitEmptyEdgesOnDump);
+    }
+}
+
+
+void
+MSNet::setScenarioFork(MSScenarioFork *fork) throw() {
+    delete myScenarioFork;
+    myScenarioFork = fork;
 }
 
 
@@ -261,6 +285,9 @@ MSNet::~MSNet() throw() {
     delete myEndOfTimestepEvents;
     delete myEmissionEvents;
     delete myEdgeWeights;
+    delete myProfiler;
+    delete myScenarioFork;
+    delete myBinaryRawOut;
     clearAll();
     GeoConvHelper::close();
     myInstance = 0;
@@ -317,36 +344,51 @@ MSNet::closeSimulation(SUMOTime start) {
         << " Waiting: " << myEmitter->getWaitingVehicleNo() << "\n";
         WRITE_MESSAGE(msg.str());
     }
+    if (myProfiler!=0) {
+        myProfiler->writeSummary();
+    }
     myDetectorControl->close(myStep);
 #ifndef NO_TRACI
     traci::TraCIServer::close();
 #endif
+    // write the buffered outputs before waiting for the variants
+    OutputDevice::flushAll();
+    if (myScenarioFork!=0) {
+        myScenarioFork->waitForVariants();
+    }
 }
 
 
 void
 MSNet::simulationStep() {
+    const unsigned int teleports = MSVehicleTransfer::getInstance()->getTeleportedVehicleNo();
+    profilePhase(MSStepProfiler::PHASE_TRACI);
 #ifndef NO_TRACI
     traci::TraCIServer::processCommandsUntilSimStep(myStep);
 #endif
     // execute beginOfTimestepEvents
+    profilePhase(MSStepProfiler::PHASE_BEGIN_EVENTS);
     if (myLogExecutionTime) {
         mySimStepBegin = SysUtils::getCurrentMillis();
     }
-#ifdef HAVE_MESOSIM
-    // netstate output
+    // state output
     std::vector<SUMOTime>::iterator timeIt = find(myStateDumpTimes.begin(), myStateDumpTimes.end(), myStep);
     if (timeIt!=myStateDumpTimes.end()) {
         const int dist = distance(myStateDumpTimes.begin(), timeIt);
         std::ofstream strm(myStateDumpFiles[dist].c_str(), std::fstream::out|std::fstream::binary);
         saveState(strm);
     }
-#endif
+    // let the variants start from here
+    if (myScenarioFork!=0&&myScenarioFork->getTime()==myStep) {
+        myScenarioFork->fork(*this);
+    }
     myBeginOfTimestepEvents->execute(myStep);
     if (MSGlobals::gCheck4Accidents) {
+        profilePhase(MSStepProfiler::PHASE_DETECT_COLLISIONS);
         myEdges->detectCollisions(myStep);
     }
     // check whether the tls programs need to be switched
+    profilePhase(MSStepProfiler::PHASE_TLS_SWITCH);
     myLogics->check2Switch(myStep);
     // set the signals
     myLogics->setTrafficLightSignals();
@@ -358,26 +400,38 @@ MSNet::simulationStep() {
 #endif
 
         // assure all lanes with vehicles are 'active'
+        profilePhase(MSStepProfiler::PHASE_PATCH_ACTIVE_LANES);
         myEdges->patchActiveLanes();
+        if (myProfiler!=0) {
+            unsigned int lanes, strips;
+            myEdges->countActive(lanes, strips);
+            myProfiler->setCounter(MSStepProfiler::COUNTER_ACTIVE_LANES, lanes);
+            myProfiler->setCounter(MSStepProfiler::COUNTER_STRIPS, strips);
+        }
 
         // move vehicles
         //  precompute possible positions for vehicles that do interact with
         //   their lane's end
+        profilePhase(MSStepProfiler::PHASE_MOVE_CRITICAL);
         myEdges->moveCritical(myStep);
 
         // move vehicles which do interact with their lane's end
         //  (it is now known whether they may drive
+        profilePhase(MSStepProfiler::PHASE_MOVE_FIRST);
         myEdges->moveFirst(myStep);
         if (MSGlobals::gCheck4Accidents) {
+            profilePhase(MSStepProfiler::PHASE_DETECT_COLLISIONS);
             myEdges->detectCollisions(myStep);
 
 
         }
 
         // Vehicles change Lanes (maybe)
+        profilePhase(MSStepProfiler::PHASE_CHANGE_LANES);
           myEdges->changeLanes(myStep);
 
         if (MSGlobals::gCheck4Accidents) {
+            profilePhase(MSStepProfiler::PHASE_DETECT_COLLISIONS);
             myEdges->detectCollisions(myStep);
             std::cerr<<"change lane collisionaaaaaaaaaaaaaaaaaaaaa";
         }
@@ -385,9 +439,11 @@ MSNet::simulationStep() {
     }
 #endif
     // load routes
+    profilePhase(MSStepProfiler::PHASE_ROUTE_LOADING);
     myRouteLoaders->loadNext(myStep, myEmitter);
 
     // persons
+    profilePhase(MSStepProfiler::PHASE_EMISSION);
     if (myPersonControl!=0) {
         while (myPersonControl->hasArrivedPersons(myStep)) {
             const MSPersonControl::PersonVector &persons = myPersonControl->popArrivedPersons(myStep);
@@ -398,16 +454,24 @@ MSNet::simulationStep() {
     }
     // emit Vehicles
     myEmitter->emitVehicles(myStep);
+    if (myProfiler!=0) {
+        myProfiler->setCounter(MSStepProfiler::COUNTER_EMISSION_RETRIES, myEmitter->getWaitingVehicleNo());
+    }
     if (MSGlobals::gCheck4Accidents) {
+        profilePhase(MSStepProfiler::PHASE_DETECT_COLLISIONS);
         myEdges->detectCollisions(myStep);
     }
+    profilePhase(MSStepProfiler::PHASE_VEHICLE_TRANSFER);
     MSVehicleTransfer::getInstance()->checkEmissions(myStep);
+    profilePhase(MSStepProfiler::PHASE_EMISSION);
     myEmissionEvents->execute(myStep);
 
     // execute endOfTimestepEvents
+    profilePhase(MSStepProfiler::PHASE_END_EVENTS);
     myEndOfTimestepEvents->execute(myStep);
 
     // update and write (if needed) detector values
+    profilePhase(MSStepProfiler::PHASE_WRITE_OUTPUT);
     writeOutput();
     std::cerr<<COLOR_red<<time2string(myStep)<<"\n"<<COLOR_reset<<std::endl;
     
@@ -416,6 +480,11 @@ MSNet::simulationStep() {
         mySimStepDuration = mySimStepEnd - mySimStepBegin;
         myVehiclesMoved += myVehicleControl->getRunningVehicleNo();
     }
+    if (myProfiler!=0) {
+        myProfiler->setCounter(MSStepProfiler::COUNTER_TELEPORTS,
+                               MSVehicleTransfer::getInstance()->getTeleportedVehicleNo() - teleports);
+        myProfiler->endStep(myStep);
+    }
     myStep += DELTA_T;
 }
 
@@ -486,7 +555,9 @@ MSNet::writeOutput() {
     // update detector values
     myDetectorControl->updateDetectors(myStep);
     // check state dumps
-    if (OptionsCont::getOptions().isSet("netstate-dump")) {
+    if (myBinaryRawOut!=0) {
+        myBinaryRawOut->write(myStep);
+    } else if (OptionsCont::getOptions().isSet("netstate-dump")) {
         MSXMLRawOut::write(OutputDevice::getDeviceByOption("netstate-dump"), *myEdges, myStep);
     }
     // emission output
@@ -519,26 +590,38 @@ MSNet::logSimulationDuration() const throw() {
 }
 
 
-#ifdef HAVE_MESOSIM
 void
 MSNet::saveState(std::ostream &os) throw() {
     FileHelpers::writeString(os, VERSION_STRING);
+    FileHelpers::writeUInt(os, STATE_FORMAT_VERSION);
     FileHelpers::writeUInt(os, sizeof(size_t));
     FileHelpers::writeUInt(os, sizeof(SUMOReal));
     FileHelpers::writeUInt(os, MSEdge::dictSize());
     FileHelpers::writeUInt(os, myStep);
     myVehicleControl->saveState(os);
+    myEdges->saveState(os);
+    myLogics->saveState(os);
+    MSVehicleTransfer::getInstance()->saveState(os);
+    myDetectorControl->saveState(os);
+    RandHelper::saveState(os);
+#ifdef HAVE_MESOSIM
     if (MSGlobals::gUseMesoSim) {
         MSGlobals::gMesoNet->saveState(os);
     }
+#endif
 }
 
 
 unsigned int
 MSNet::loadState(BinaryInputDevice &bis) throw() {
     std::string version;
-    unsigned int sizeT, fpSize, numEdges, step;
+    unsigned int formatVersion, sizeT, fpSize, numEdges, step;
     bis >> version;
+    bis >> formatVersion;
+    if (formatVersion != STATE_FORMAT_VERSION) {
+        MsgHandler::getErrorInstance()->inform("State was written in format version " + toString(formatVersion) + " (present: " + toString(STATE_FORMAT_VERSION) + ")!");
+        return 0;
+    }
     bis >> sizeT;
     bis >> fpSize;
     bis >> numEdges;
@@ -556,13 +639,21 @@ MSNet::loadState(BinaryInputDevice &bis) throw() {
         WRITE_WARNING("State was written for a different net!");
     }
     const SUMOTime offset = string2time(OptionsCont::getOptions().getString("load-state.offset"));
+    // events built while loading the vehicles refer to the current step
+    myStep = step;
     myVehicleControl->loadState(bis, offset);
+    myEdges->loadState(bis, *myVehicleControl);
+    myLogics->loadState(bis, step);
+    MSVehicleTransfer::getInstance()->loadState(bis, *myVehicleControl);
+    myDetectorControl->loadState(bis, *myVehicleControl);
+    RandHelper::loadState(bis);
+#ifdef HAVE_MESOSIM
     if (MSGlobals::gUseMesoSim) {
         MSGlobals::gMesoNet->loadState(bis, *myVehicleControl, offset);
     }
+#endif
     return step;
 }
-#endif
 
 
 MSPersonControl &
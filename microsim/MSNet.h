@@ -47,6 +47,7 @@
 #include "MSVehicleControl.h"
 #include "MSPersonControl.h"
 #include "MSEventControl.h"
+#include "MSStepProfiler.h"
 #include <utils/geom/Boundary.h>
 #include <utils/geom/Position2D.h>
 #include <utils/common/SUMOTime.h>
@@ -75,6 +76,8 @@ class ShapeContainer;
 class BinaryInputDevice;
 class MSRouteLoader;
 class MSEdgeWeightsStorage;
+class MSScenarioFork;
+class MSBinaryRawOut;
 class SUMOVehicle;
 #ifdef _MESSAGES
 class MSMessageEmitter;
@@ -156,6 +159,14 @@ public:
                        std::vector<SUMOTime> stateDumpTimes, std::vector<std::string> stateDumpFiles) throw();
 
 
+    /** @brief Sets the forker of scenario variants
+     *
+     * The network takes the ownership of the given object.
+     * @param[in] fork The forker to use at its fork time
+     */
+    void setScenarioFork(MSScenarioFork *fork) throw();
+
+
     /** @brief Clears all dictionaries
      * @todo Try to move all this to the destructor
      */
@@ -239,11 +250,14 @@ public:
 
 
 
-#ifdef HAVE_MESOSIM
-    /// @name State I/O (mesosim only)
+    /// @name State I/O
     /// @{
 
     /** @brief Saves the current state
+     *
+     * Writes the vehicles, their order within the strips, the traffic lights,
+     *  the teleporting vehicles, the induction loops and the random number
+     *  generator.
      *
      * @param[in] os The stream to write the state into (binary)
      */
@@ -251,12 +265,18 @@ public:
 
 
     /** @brief Loads the network state
+     *
+     * Has to be called after the additional files were loaded, so that
+     *  detectors and other move reminders are known to the lanes.
+     *
+     * An error is reported if the state was written using a different
+     *  format version.
      *
      * @param[in] bis The input to read the state from (binary)
+     * @return The time step the state was saved at
      */
     unsigned int loadState(BinaryInputDevice &bis) throw();
     /// @}
-#endif
 
     /// @name Retrieval of references to substructures
     /// @{
@@ -302,6 +322,16 @@ public:
     }
 
 
+    /** @brief Returns the route loading control
+     * @return The route loading control
+     * @see MSRouteLoaderControl
+     * @see myRouteLoaders
+     */
+    MSRouteLoaderControl &getRouteLoaders() throw() {
+        return *myRouteLoaders;
+    }
+
+
     /** @brief Returns the detector control
      * @return The detector control
      * @see MSDetectorControl
@@ -579,6 +609,9 @@ protected:
     /// @brief Unique instance of MSNet
     static MSNet* myInstance;
 
+    /// @brief The version of the state format, changed whenever a record changes
+    static const unsigned int STATE_FORMAT_VERSION;
+
     /// @brief Route loader for dynamic loading of routes
     MSRouteLoaderControl *myRouteLoaders;
 
@@ -635,6 +668,9 @@ protected:
 
     /// @brief The overall number of vehicle movements
     long myVehiclesMoved;
+
+    /// @brief The profiler of the step phases (0 if not wished)
+    MSStepProfiler *myProfiler;
     //}
 
 
@@ -648,6 +684,12 @@ protected:
     std::vector<std::string> myStateDumpFiles;
     /// @}
 
+    /// @brief The forker of scenario variants (0 if not wished)
+    MSScenarioFork *myScenarioFork;
+
+    /// @brief The binary netstate dump (0 if the dump is not wished or written as XML)
+    MSBinaryRawOut *myBinaryRawOut;
+
 
     /// @brief Storage for maximum vehicle number
     int myTooManyVehicles;
@@ -671,6 +713,18 @@ protected:
 #endif
 
 
+private:
+    /** @brief Lets the profiler begin the given phase if profiling is wished
+     * @param[in] phase The phase of the simulation step which begins
+     * @see MSStepProfiler::switchPhase
+     */
+    void profilePhase(MSStepProfiler::Phase phase) throw() {
+        if (myProfiler!=0) {
+            myProfiler->switchPhase(phase);
+        }
+    }
+
+
 private:
     /// @brief Invalidated copy constructor.
     MSNet(const MSNet&);
@@ -211,7 +211,6 @@ MSRoute::operator[](unsigned index) const {
 }
 
 
-#ifdef HAVE_MESOSIM
 void
 MSRoute::dict_saveState(std::ostream &os) throw() {
     FileHelpers::writeUInt(os, (unsigned int) myDict.size());
@@ -296,7 +295,6 @@ MSRoute::dict_loadState(BinaryInputDevice &bis) throw() {
         }
     }
 }
-#endif
 
 
 unsigned
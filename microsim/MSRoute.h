@@ -93,8 +93,7 @@ public:
 
     const MSEdge *operator[](unsigned index) const;
 
-#ifdef HAVE_MESOSIM
-    /// @name State I/O (mesosim only)
+    /// @name State I/O
     /// @{
 
     /** @brief Saves all known routes into the given stream
@@ -110,7 +109,6 @@ public:
      */
     static void dict_loadState(BinaryInputDevice &bis) throw();
     /// @}
-#endif
 
     unsigned posInRoute(const MSRouteIterator &currentEdge) const;
 
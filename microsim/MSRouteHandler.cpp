@@ -395,13 +395,9 @@ MSRouteHandler::myEndElement(SumoXMLTag element) throw(ProcessError) {
         if (!MSNet::getInstance()->getVehicleControl().addVType(vehType)) {
             std::string id = vehType->getID();
             delete vehType;
-#ifdef HAVE_MESOSIM
             if (!MSGlobals::gStateLoaded) {
-#endif
                 throw ProcessError("Another vehicle type (or distribution) with the id '" + id + "' exists.");
-#ifdef HAVE_MESOSIM
             }
-#endif
         } else {
             if (myCurrentVTypeDistribution != 0) {
                 myCurrentVTypeDistribution->add(vehType->getDefaultProbability(), vehType);
@@ -430,9 +426,7 @@ MSRouteHandler::closeRoute() throw(ProcessError) {
     myActiveRoute.clear();
     if (!MSRoute::dictionary(myActiveRouteID, route)) {
         delete route;
-#ifdef HAVE_MESOSIM
         if (!MSGlobals::gStateLoaded) {
-#endif
             if (myVehicleParameter!=0) {
                 if (MSNet::getInstance()->getVehicleControl().getVehicle(myVehicleParameter->id)==0) {
                     throw ProcessError("Another route for vehicle '" + myVehicleParameter->id + "' exists.");
@@ -442,9 +436,7 @@ MSRouteHandler::closeRoute() throw(ProcessError) {
             } else {
                 throw ProcessError("Another route (or distribution) with the id '" + myActiveRouteID + "' exists.");
             }
-#ifdef HAVE_MESOSIM
         }
-#endif
     } else {
         if (myCurrentRouteDistribution != 0) {
             myCurrentRouteDistribution->add(myActiveRouteProbability, route);
@@ -550,18 +542,14 @@ MSRouteHandler::closeVehicle() throw(ProcessError) {
         }
     } else {
         // strange: another vehicle with the same id already exists
-#ifdef HAVE_MESOSIM
         if (!MSGlobals::gStateLoaded) {
-#endif
             // and was not loaded while loading a simulation state
             // -> error
             throw ProcessError("Another vehicle with the id '" + myVehicleParameter->id + "' exists.");
-#ifdef HAVE_MESOSIM
         } else {
             // ok, it seems to be loaded previously while loading a simulation state
             vehicle = 0;
         }
-#endif
     }
     // check whether the vehicle shall be added directly to the network or
     //  shall stay in the internal buffer
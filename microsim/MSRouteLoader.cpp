@@ -30,6 +30,7 @@
 #include <utils/common/MsgHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/xml/XMLSubSys.h>
+#include <utils/xml/SUMOSAXHandler.h>
 #include "MSNet.h"
 #include "MSRouteHandler.h"
 #include "MSRouteLoader.h"
@@ -39,18 +40,48 @@
 #endif // CHECK_MEMORY_LEAKS
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const size_t MSRouteLoader::QUEUE_SIZE = 4096;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
 MSRouteLoader::MSRouteLoader(MSNet &,
                              MSRouteHandler *handler)
-        : myParser(0), myMoreAvailable(true), myHandler(handler) {
-    myParser = XMLSubSys::getSAXReader(*myHandler);
+        : myParser(0), myMoreAvailable(true), myHandler(handler),
+        myParseHandler(new SUMOSAXHandler(handler->getFileName())),
+        myRecorder(myElement), myReplayer(*handler, handler->getFileName()),
+        myParsingFinished(false), myUnbounded(false) {
+    myParseHandler->setRecorder(&myRecorder);
+    myParser = XMLSubSys::getSAXReader(*myParseHandler);
+#ifndef WIN32
+    myThreadRunning = false;
+    myQuit = false;
+    pthread_mutex_init(&myLock, 0);
+    pthread_cond_init(&myElementQueued, 0);
+    pthread_cond_init(&myElementTaken, 0);
+#endif
 }
 
 
 MSRouteLoader::~MSRouteLoader() {
+#ifndef WIN32
+    if (myThreadRunning) {
+        pthread_mutex_lock(&myLock);
+        myQuit = true;
+        pthread_cond_broadcast(&myElementTaken);
+        pthread_mutex_unlock(&myLock);
+        pthread_join(myThread, 0);
+    }
+    pthread_cond_destroy(&myElementTaken);
+    pthread_cond_destroy(&myElementQueued);
+    pthread_mutex_destroy(&myLock);
+#endif
     delete myParser;
+    delete myParseHandler;
     delete myHandler;
 }
 
@@ -61,6 +92,12 @@ MSRouteLoader::init() {
     if (!myParser->parseFirst(myHandler->getFileName().c_str(), myToken)) {
         throw ProcessError("Can not read XML-file '" + myHandler->getFileName() + "'.");
     }
+#ifndef WIN32
+    if (pthread_create(&myThread, 0, &MSRouteLoader::threadMain, this)!=0) {
+        throw ProcessError("Could not start the loading thread for '" + myHandler->getFileName() + "'.");
+    }
+    myThreadRunning = true;
+#endif
 }
 
 
@@ -78,7 +115,9 @@ MSRouteLoader::loadUntil(SUMOTime time, MSEmitControl* into) {
     myHandler->retrieveLastReadVehicle(into);
     // read vehicles until specified time or the period to read vehicles
     //  until is reached
-    while (myParser->parseNext(myToken)) {
+    std::string element;
+    while (nextElement(element)) {
+        myReplayer.replay(element.data(), element.data()+element.size());
         // return when the last read vehicle is beyond the period
         if (myHandler->getLastDepart()>=time) {
             return;
@@ -99,6 +138,103 @@ MSRouteLoader::moreAvailable() const {
 }
 
 
+bool
+MSRouteLoader::nextElement(std::string &into) throw(ProcessError) {
+#ifndef WIN32
+    pthread_mutex_lock(&myLock);
+    while (myQueue.empty()&&!myParsingFinished) {
+        pthread_cond_wait(&myElementQueued, &myLock);
+    }
+#else
+    while (myQueue.empty()&&!myParsingFinished) {
+        parseNextElement();
+    }
+#endif
+    const bool available = !myQueue.empty();
+    if (available) {
+        into.swap(myQueue.front());
+        myQueue.pop_front();
+    }
+    const std::string error = myQueue.empty() ? myError : "";
+#ifndef WIN32
+    pthread_cond_signal(&myElementTaken);
+    pthread_mutex_unlock(&myLock);
+#endif
+    if (!available&&error!="") {
+        throw ProcessError(error);
+    }
+    return available;
+}
+
+
+bool
+MSRouteLoader::parseNextElement() throw() {
+    bool more = true;
+    std::string error;
+    try {
+        // parse until a top-level element is complete
+        do {
+            more = myParser->parseNext(myToken);
+        } while (more&&(myRecorder.getDepth()>1||myElement.tellp()==std::streampos(0)));
+    } catch (ProcessError &e) {
+        error = e.what();
+        more = false;
+    } catch (...) {
+        error = "An error occured while parsing '" + myHandler->getFileName() + "'.";
+        more = false;
+    }
+#ifndef WIN32
+    pthread_mutex_lock(&myLock);
+    while (myQueue.size()>=QUEUE_SIZE&&!myUnbounded&&!myQuit) {
+        pthread_cond_wait(&myElementTaken, &myLock);
+    }
+#endif
+    if (myElement.tellp()!=std::streampos(0)) {
+        myQueue.push_back(myElement.str());
+        myElement.str("");
+    }
+    if (!more) {
+        myParsingFinished = true;
+        myError = error;
+    }
+#ifndef WIN32
+    more &= !myQuit;
+    pthread_cond_broadcast(&myElementQueued);
+    pthread_mutex_unlock(&myLock);
+#endif
+    return more;
+}
+
+
+void
+MSRouteLoader::finishParsing() throw() {
+#ifndef WIN32
+    if (!myThreadRunning) {
+        return;
+    }
+    pthread_mutex_lock(&myLock);
+    myUnbounded = true;
+    pthread_cond_broadcast(&myElementTaken);
+    pthread_mutex_unlock(&myLock);
+    pthread_join(myThread, 0);
+    myThreadRunning = false;
+#else
+    while (!myParsingFinished) {
+        parseNextElement();
+    }
+#endif
+}
+
+
+#ifndef WIN32
+void *
+MSRouteLoader::threadMain(void *arg) {
+    MSRouteLoader *loader = static_cast<MSRouteLoader*>(arg);
+    while (loader->parseNextElement());
+    return 0;
+}
+#endif
+
 
 /****************************************************************************/
 
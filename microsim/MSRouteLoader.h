@@ -31,9 +31,23 @@
 
 #include <xercesc/sax2/XMLReaderFactory.hpp>
 #include <string>
+#include <deque>
+#include <sstream>
 #include <microsim/MSNet.h>
+#include <utils/xml/SAXBinaryCache.h>
 #include "MSVehicleContainer.h"
 #include "MSRouteHandler.h"
+#include "MSAbstractRouteLoader.h"
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class SUMOSAXHandler;
 
 
 // ===========================================================================
@@ -41,25 +55,70 @@
 // ===========================================================================
 /**
  * @class MSRouteLoader
+ * @brief Loads the vehicles of a route file step-wise
+ *
+ * The XML file is parsed by a loading thread which records the elements
+ *  (see SAXBinaryCache) and puts them into a bounded queue, one entry per
+ *  top-level element, staying up to QUEUE_SIZE elements ahead of the
+ *  simulation. The simulation thread only replays the queued elements into
+ *  the MSRouteHandler which builds the routes and vehicles, so the
+ *  dictionaries, the vehicle types and the random number generator are
+ *  used by the simulation thread only and the results do not depend on
+ *  the loading thread's progress.
+ *
+ * On WIN32, the elements are parsed on demand by the simulation thread.
+ *
+ * @todo Included files are parsed by the loading thread using XMLSubSys which is not thread-safe
  */
-class MSRouteLoader {
+class MSRouteLoader : public MSAbstractRouteLoader {
 public:
     /// constructor
     MSRouteLoader(MSNet &net,
                   MSRouteHandler *handler);
 
     /// destructor
-    ~MSRouteLoader();
+    virtual ~MSRouteLoader();
 
     /** loads vehicles until a vehicle is read that starts after
         the specified time */
     void loadUntil(SUMOTime time, MSEmitControl* into);
 
-    /// resets the reader
+    /** @brief starts reading the file
+     * @exception ProcessError If the file can not be read or the loading thread can not be started
+     */
     void init();
 
     /// returns the information whether new data is available
     bool moreAvailable() const;
+
+    /** @brief Parses the remainder of the file into the queue and stops the loading thread
+     *
+     * Needed before the process is forked as the thread is not copied.
+     */
+    void finishParsing() throw();
+
+
+private:
+    /** @brief Returns the next queued element, waiting for it if necessary
+     * @param[out] into The recorded element
+     * @return Whether an element was available
+     * @exception ProcessError If parsing failed
+     */
+    bool nextElement(std::string &into) throw(ProcessError);
+
+
+    /** @brief Parses the next top-level element and queues it
+     * @return Whether the file contains further elements
+     */
+    bool parseNextElement() throw();
+
+
+#ifndef WIN32
+    /// @brief The function run by the loading thread
+    static void *threadMain(void *arg);
+#endif
+
+
 private:
     /// the used SAX2XMLReader
     SAX2XMLReader* myParser;
@@ -72,6 +131,61 @@ private:
 
     MSRouteHandler *myHandler;
 
+    /// @brief The handler the parser reports to; records the elements
+    SUMOSAXHandler *myParseHandler;
+
+    /// @brief The currently recorded element
+    std::ostringstream myElement;
+
+    /// @brief Records the parsed elements into myElement
+    SAXBinaryCache myRecorder;
+
+    /// @brief Replays the queued elements into myHandler
+    SAXBinaryCache::Replayer myReplayer;
+
+    /// @brief The recorded top-level elements not yet replayed
+    std::deque<std::string> myQueue;
+
+    /// @brief Whether the whole file was parsed (or parsing failed)
+    bool myParsingFinished;
+
+    /// @brief The error which stopped parsing, if any
+    std::string myError;
+
+    /// @brief Whether the queue shall take the remainder of the file
+    bool myUnbounded;
+
+    /// @brief The maximum number of queued elements
+    static const size_t QUEUE_SIZE;
+
+#ifndef WIN32
+    /// @brief The loading thread
+    pthread_t myThread;
+
+    /// @brief Whether the loading thread was started and not yet joined
+    bool myThreadRunning;
+
+    /// @brief Whether the loading thread shall stop
+    bool myQuit;
+
+    /// @brief Guards the queue and the parsing state
+    pthread_mutex_t myLock;
+
+    /// @brief Signals a queued element or the end of parsing
+    pthread_cond_t myElementQueued;
+
+    /// @brief Signals a free queue entry (or the end of the bound)
+    pthread_cond_t myElementTaken;
+#endif
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSRouteLoader(const MSRouteLoader&);
+
+    /// @brief Invalidated assignment operator.
+    MSRouteLoader& operator=(const MSRouteLoader&);
+
 };
 
 
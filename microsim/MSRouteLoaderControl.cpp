@@ -28,7 +28,7 @@
 #endif
 
 #include <vector>
-#include "MSRouteLoader.h"
+#include "MSAbstractRouteLoader.h"
 #include "MSRouteLoaderControl.h"
 
 #ifdef CHECK_MEMORY_LEAKS
@@ -97,6 +97,14 @@ MSRouteLoaderControl::loadNext(SUMOTime step, MSEmitControl* into) {
 }
 
 
+void
+MSRouteLoaderControl::finishParsing() throw() {
+    for (LoaderVector::iterator i=myRouteLoaders.begin(); i!=myRouteLoaders.end(); ++i) {
+        (*i)->finishParsing();
+    }
+}
+
+
 
 /****************************************************************************/
 
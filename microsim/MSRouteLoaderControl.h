@@ -37,7 +37,7 @@
 // ===========================================================================
 // class declarations
 // ===========================================================================
-class MSRouteLoader;
+class MSAbstractRouteLoader;
 
 
 // ===========================================================================
@@ -55,7 +55,7 @@ class MSRouteLoader;
 class MSRouteLoaderControl {
 public:
     /// definition of the loader vector
-    typedef std::vector<MSRouteLoader*> LoaderVector;
+    typedef std::vector<MSAbstractRouteLoader*> LoaderVector;
 
 public:
     /// constructor
@@ -68,6 +68,9 @@ public:
     /// loads the next routes
     void loadNext(SUMOTime step, MSEmitControl* into);
 
+    /// parses the remainders of all files and stops the loading threads
+    void finishParsing() throw();
+
 private:
     /// the last time step new routes were loaded
     SUMOTime myLastLoadTime;
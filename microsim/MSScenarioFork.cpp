@@ -0,0 +1,146 @@
+/****************************************************************************/
+/// @file    MSScenarioFork.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSScenarioFork.cpp $
+///
+// Forks the running simulation into variants sharing the warmed-up state
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#ifndef WIN32
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+#include <utils/common/MsgHandler.h>
+#include <utils/common/ToString.h>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSNet.h"
+#include "MSEdgeControl.h"
+#include "MSRouteLoaderControl.h"
+#include "traffic_lights/MSTLLogicControl.h"
+#include "MSScenarioFork.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSScenarioFork::MSScenarioFork(SUMOTime time, const std::vector<std::string> &variants,
+                               const std::string &outputPrefix) throw()
+        : myTime(time), myVariants(variants), myOutputPrefix(outputPrefix),
+        myVariantIndex(-1) {}
+
+
+MSScenarioFork::~MSScenarioFork() throw() {}
+
+
+void
+MSScenarioFork::fork(MSNet &net) throw(ProcessError) {
+#ifdef WIN32
+    throw ProcessError("Forking variants is not supported on this platform.");
+#else
+    // the route loading threads are not copied and would share the files' offsets
+    net.getRouteLoaders().finishParsing();
+    // nothing buffered may be written by both processes
+    OutputDevice::flushAll();
+    std::cout.flush();
+    std::cerr.flush();
+    for (unsigned int i=0; i<myVariants.size(); ++i) {
+        const pid_t pid = ::fork();
+        if (pid<0) {
+            throw ProcessError("Could not fork variant '" + myVariants[i] + "' (" + std::strerror(errno) + ").");
+        }
+        if (pid==0) {
+            myChildren.clear();
+            myVariantIndex = (int) i;
+            startVariant(net);
+            return;
+        }
+        myChildren.push_back((int) pid);
+    }
+    WRITE_MESSAGE("Forked " + toString(myVariants.size()) + " variant(s) at time " + time2string(myTime) + ".");
+#endif
+}
+
+
+void
+MSScenarioFork::startVariant(MSNet &net) throw(ProcessError) {
+#ifndef WIN32
+    const std::string &variant = myVariants[myVariantIndex];
+    const std::string directory = myOutputPrefix + toString(myVariantIndex);
+    if (mkdir(directory.c_str(), 0777)!=0&&errno!=EEXIST) {
+        throw ProcessError("Could not build the output directory '" + directory + "' of variant '" + variant + "'.");
+    }
+    try {
+        OutputDevice::redirectAll(directory);
+    } catch (IOError &e) {
+        throw ProcessError(e.what());
+    }
+    // the worker threads were not copied
+    net.getEdgeControl().rebuildWorkerPool();
+    if (variant.substr(0, 4)=="tls:") {
+        const std::string::size_type split = variant.rfind(':');
+        if (split<=4) {
+            throw ProcessError("The tls variant '" + variant + "' does not name a program.");
+        }
+        const std::string id = variant.substr(4, split-4);
+        const std::string programID = variant.substr(split+1);
+        if (!net.getTLSControl().switchTo(id, programID)) {
+            throw ProcessError("Could not switch tls '" + id + "' to program '" + programID + "'.");
+        }
+    } else {
+        loadAdditional(net, variant);
+    }
+    WRITE_MESSAGE("Variant " + toString(myVariantIndex) + " ('" + variant + "') writes into '" + directory + "'.");
+#endif
+}
+
+
+unsigned int
+MSScenarioFork::waitForVariants() throw() {
+    unsigned int failed = 0;
+#ifndef WIN32
+    for (unsigned int i=0; i<myChildren.size(); ++i) {
+        int status = 0;
+        if (waitpid((pid_t) myChildren[i], &status, 0)<0||!WIFEXITED(status)||WEXITSTATUS(status)!=0) {
+            MsgHandler::getErrorInstance()->inform("Variant " + toString(i) + " ('" + myVariants[i] + "') did not finish successfully.");
+            ++failed;
+        }
+    }
+    myChildren.clear();
+#endif
+    return failed;
+}
+
+
+
+/****************************************************************************/
+
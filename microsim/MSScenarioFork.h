@@ -0,0 +1,164 @@
+/****************************************************************************/
+/// @file    MSScenarioFork.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSScenarioFork.h $
+///
+// Forks the running simulation into variants sharing the warmed-up state
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSScenarioFork_h
+#define MSScenarioFork_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/UtilExceptions.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class MSNet;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSScenarioFork
+ * @brief Forks the running simulation into variants sharing the warmed-up state
+ *
+ * At the begin of the fork step, MSNet calls "fork" which starts one child
+ *  process per variant using fork(2). The children share the memory of the
+ *  simulation copy-on-write, so the warm-up is computed once and only the
+ *  pages changed by a variant are copied.
+ *
+ * Each child writes its outputs into the directory "<prefix><index>"; the
+ *  outputs written during the warm-up are copied there. A variant is either
+ *  the name of an additional file which is loaded into the child's network
+ *  or "tls:ID:PROGRAM" which switches the named tls to the named program.
+ *
+ * The parent continues unchanged as the reference run and waits for the
+ *  children when the simulation is closed.
+ *
+ * Loading additional files needs the network builders and is therefore
+ *  implemented by a derived class within netload.
+ */
+class MSScenarioFork {
+public:
+    /** @brief Constructor
+     * @param[in] time The step to fork at
+     * @param[in] variants The variant definitions
+     * @param[in] outputPrefix The prefix of the variants' output directories
+     */
+    MSScenarioFork(SUMOTime time, const std::vector<std::string> &variants,
+                   const std::string &outputPrefix) throw();
+
+
+    /// @brief Destructor
+    virtual ~MSScenarioFork() throw();
+
+
+    /** @brief Returns the step to fork at
+     * @return The fork time
+     */
+    SUMOTime getTime() const throw() {
+        return myTime;
+    }
+
+
+    /** @brief Returns the index of the variant simulated by this process
+     * @return The variant's index, -1 within the parent
+     */
+    int getVariantIndex() const throw() {
+        return myVariantIndex;
+    }
+
+
+    /** @brief Forks one process per variant
+     *
+     * Returns within the parent and within each child, the latter having
+     *  redirected its outputs and applied its variant.
+     *
+     * @param[in] net The running network
+     * @exception ProcessError If forking or applying the variant fails
+     */
+    void fork(MSNet &net) throw(ProcessError);
+
+
+    /** @brief Waits for the forked processes to finish
+     *
+     * Does nothing within the children.
+     * @return The number of variants which did not finish successfully
+     */
+    unsigned int waitForVariants() throw();
+
+
+protected:
+    /** @brief Loads the given additional file into the network
+     * @param[in] net The running network
+     * @param[in] file The file to load
+     * @exception ProcessError If the file could not be loaded
+     */
+    virtual void loadAdditional(MSNet &net, const std::string &file) throw(ProcessError) = 0;
+
+
+private:
+    /** @brief Prepares the child process and applies its variant
+     * @param[in] net The running network
+     * @exception ProcessError If the outputs could not be redirected or the variant is invalid
+     */
+    void startVariant(MSNet &net) throw(ProcessError);
+
+
+private:
+    /// @brief The step to fork at
+    SUMOTime myTime;
+
+    /// @brief The variant definitions
+    std::vector<std::string> myVariants;
+
+    /// @brief The prefix of the output directories
+    std::string myOutputPrefix;
+
+    /// @brief The index of the variant simulated by this process (-1 for the parent)
+    int myVariantIndex;
+
+    /// @brief The process ids of the forked children
+    std::vector<int> myChildren;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSScenarioFork(const MSScenarioFork&);
+
+    /// @brief Invalidated assignment operator.
+    MSScenarioFork& operator=(const MSScenarioFork&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
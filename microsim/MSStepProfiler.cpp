@@ -0,0 +1,207 @@
+/****************************************************************************/
+/// @file    MSStepProfiler.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSStepProfiler.cpp $
+///
+// Measures the duration of the phases of each simulation step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <iostream>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSStepProfiler.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSStepProfiler::MSStepProfiler(OutputDevice *summary, OutputDevice *steps) throw()
+        : mySummary(summary), mySteps(steps), myCurrentPhase(PHASE_NUMBER),
+        myPhaseBegin(0), myStepNumber(0) {
+    for (int i=0; i<PHASE_NUMBER; ++i) {
+        myStepCycles[i] = 0;
+        myPhases[i].sum = 0;
+        myPhases[i].max = 0;
+        for (int j=0; j<HISTOGRAM_SIZE; ++j) {
+            myPhases[i].histogram[j] = 0;
+        }
+    }
+    for (int i=0; i<COUNTER_NUMBER; ++i) {
+        myStepCounters[i] = 0;
+        myCounters[i].sum = 0;
+        myCounters[i].max = 0;
+    }
+    if (mySteps!=0) {
+        (*mySteps) << "step";
+        for (int i=0; i<PHASE_NUMBER; ++i) {
+            (*mySteps) << "," << getName((Phase) i);
+        }
+        for (int i=0; i<COUNTER_NUMBER; ++i) {
+            (*mySteps) << "," << getName((Counter) i);
+        }
+        (*mySteps) << "\n";
+    }
+}
+
+
+MSStepProfiler::~MSStepProfiler() throw() {}
+
+
+void
+MSStepProfiler::endStep(SUMOTime step) throw(IOError) {
+    switchPhase(PHASE_NUMBER);
+    for (int i=0; i<PHASE_NUMBER; ++i) {
+        const Cycles cycles = myStepCycles[i];
+        PhaseStatistics &stats = myPhases[i];
+        stats.sum += cycles;
+        if (cycles>stats.max) {
+            stats.max = cycles;
+        }
+        // the bin is the number of significant bits
+        int bin = 0;
+        for (Cycles rest=cycles; rest!=0&&bin<HISTOGRAM_SIZE-1; rest>>=1) {
+            ++bin;
+        }
+        stats.histogram[bin]++;
+    }
+    for (int i=0; i<COUNTER_NUMBER; ++i) {
+        CounterStatistics &stats = myCounters[i];
+        stats.sum += myStepCounters[i];
+        if (myStepCounters[i]>stats.max) {
+            stats.max = myStepCounters[i];
+        }
+    }
+    if (mySteps!=0) {
+        (*mySteps) << time2string(step);
+        for (int i=0; i<PHASE_NUMBER; ++i) {
+            (*mySteps) << "," << myStepCycles[i];
+        }
+        for (int i=0; i<COUNTER_NUMBER; ++i) {
+            (*mySteps) << "," << myStepCounters[i];
+        }
+        (*mySteps) << "\n";
+    }
+    for (int i=0; i<PHASE_NUMBER; ++i) {
+        myStepCycles[i] = 0;
+    }
+    for (int i=0; i<COUNTER_NUMBER; ++i) {
+        myStepCounters[i] = 0;
+    }
+    ++myStepNumber;
+}
+
+
+void
+MSStepProfiler::writeSummary() throw(IOError) {
+    if (mySummary==0) {
+        return;
+    }
+    OutputDevice &dev = *mySummary;
+#if (defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))) || defined(_MSC_VER)
+    const std::string source = "cycles";
+#else
+    const std::string source = "clock";
+#endif
+    dev << "    <steps number=\"" << myStepNumber << "\" unit=\"" << source << "\"/>\n";
+    for (int i=0; i<PHASE_NUMBER; ++i) {
+        const PhaseStatistics &stats = myPhases[i];
+        const SUMOReal mean = myStepNumber!=0 ? (SUMOReal) stats.sum / (SUMOReal) myStepNumber : 0;
+        dev << "    <phase id=\"" << getName((Phase) i) << "\" sum=\"" << stats.sum
+        << "\" mean=\"" << mean << "\" max=\"" << stats.max << "\">\n";
+        for (int j=0; j<HISTOGRAM_SIZE; ++j) {
+            if (stats.histogram[j]!=0) {
+                // the upper border of bin j is 2^j
+                dev << "        <bin end=\"" << ((Cycles) 1 << j) << "\" steps=\"" << stats.histogram[j] << "\"/>\n";
+            }
+        }
+        dev << "    </phase>\n";
+    }
+    for (int i=0; i<COUNTER_NUMBER; ++i) {
+        const CounterStatistics &stats = myCounters[i];
+        const SUMOReal mean = myStepNumber!=0 ? (SUMOReal) stats.sum / (SUMOReal) myStepNumber : 0;
+        dev << "    <counter id=\"" << getName((Counter) i) << "\" sum=\"" << stats.sum
+        << "\" mean=\"" << mean << "\" max=\"" << stats.max << "\"/>\n";
+    }
+}
+
+
+const char *
+MSStepProfiler::getName(Phase phase) throw() {
+    switch (phase) {
+    case PHASE_TRACI:
+        return "traci";
+    case PHASE_BEGIN_EVENTS:
+        return "beginEvents";
+    case PHASE_TLS_SWITCH:
+        return "tlsSwitch";
+    case PHASE_PATCH_ACTIVE_LANES:
+        return "patchActiveLanes";
+    case PHASE_MOVE_CRITICAL:
+        return "moveCritical";
+    case PHASE_MOVE_FIRST:
+        return "moveFirst";
+    case PHASE_DETECT_COLLISIONS:
+        return "detectCollisions";
+    case PHASE_CHANGE_LANES:
+        return "changeLanes";
+    case PHASE_ROUTE_LOADING:
+        return "routeLoading";
+    case PHASE_EMISSION:
+        return "emission";
+    case PHASE_VEHICLE_TRANSFER:
+        return "vehicleTransfer";
+    case PHASE_END_EVENTS:
+        return "endEvents";
+    case PHASE_WRITE_OUTPUT:
+        return "writeOutput";
+    default:
+        return "";
+    }
+}
+
+
+const char *
+MSStepProfiler::getName(Counter counter) throw() {
+    switch (counter) {
+    case COUNTER_ACTIVE_LANES:
+        return "activeLanes";
+    case COUNTER_STRIPS:
+        return "strips";
+    case COUNTER_TELEPORTS:
+        return "teleports";
+    case COUNTER_EMISSION_RETRIES:
+        return "emissionRetries";
+    default:
+        return "";
+    }
+}
+
+
+
+/****************************************************************************/
+
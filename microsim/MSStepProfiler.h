@@ -0,0 +1,266 @@
+/****************************************************************************/
+/// @file    MSStepProfiler.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSStepProfiler.h $
+///
+// Measures the duration of the phases of each simulation step
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSStepProfiler_h
+#define MSStepProfiler_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <ctime>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/UtilExceptions.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSStepProfiler
+ * @brief Measures the duration of the phases of each simulation step
+ *
+ * MSNet::simulationStep calls "switchPhase" at the begin of each phase and
+ *  "endStep" at the end of the step. The time between two calls is read from
+ *  the processor's time stamp counter (in cycles) where available and from
+ *  "clock" otherwise, and added to the phase which was active. A phase may be
+ *  entered several times per step (e.g. the collision detection).
+ *
+ * For each phase, the sum and the maximum of the per-step durations are kept
+ *  together with a histogram of the per-step durations, using powers of two
+ *  as bin borders. Additionally, per-step counters (active lanes, strips, ...)
+ *  are set by the simulation.
+ *
+ * The summary is written as XML into "profile-output" when the simulation is
+ *  closed; if "profile-steps-output" is set, one line of comma-separated values
+ *  is written per step.
+ */
+class MSStepProfiler {
+public:
+    /// @brief The type of the measured durations
+    typedef unsigned long long Cycles;
+
+
+    /// @brief The profiled phases of a simulation step
+    enum Phase {
+        /// @brief Processing TraCI commands
+        PHASE_TRACI = 0,
+        /// @brief Executing the begin of step events
+        PHASE_BEGIN_EVENTS,
+        /// @brief Switching and setting the traffic lights
+        PHASE_TLS_SWITCH,
+        /// @brief MSEdgeControl::patchActiveLanes
+        PHASE_PATCH_ACTIVE_LANES,
+        /// @brief MSEdgeControl::moveCritical
+        PHASE_MOVE_CRITICAL,
+        /// @brief MSEdgeControl::moveFirst
+        PHASE_MOVE_FIRST,
+        /// @brief MSEdgeControl::detectCollisions
+        PHASE_DETECT_COLLISIONS,
+        /// @brief MSEdgeControl::changeLanes
+        PHASE_CHANGE_LANES,
+        /// @brief Loading routes
+        PHASE_ROUTE_LOADING,
+        /// @brief Emitting vehicles and proceeding persons
+        PHASE_EMISSION,
+        /// @brief Reinserting teleported vehicles
+        PHASE_VEHICLE_TRANSFER,
+        /// @brief Executing the end of step events
+        PHASE_END_EVENTS,
+        /// @brief MSNet::writeOutput
+        PHASE_WRITE_OUTPUT,
+        /// @brief The number of phases (no phase active)
+        PHASE_NUMBER
+    };
+
+
+    /// @brief The counters set during a simulation step
+    enum Counter {
+        /// @brief The number of active lanes
+        COUNTER_ACTIVE_LANES = 0,
+        /// @brief The number of strips of the active lanes
+        COUNTER_STRIPS,
+        /// @brief The number of vehicles teleported within the step
+        COUNTER_TELEPORTS,
+        /// @brief The number of vehicles which could not be emitted and wait for the next try
+        COUNTER_EMISSION_RETRIES,
+        /// @brief The number of counters
+        COUNTER_NUMBER
+    };
+
+
+    /** @brief Constructor
+     * @param[in] summary The device to write the summary into (may be 0)
+     * @param[in] steps The device to write the per-step values into (may be 0)
+     */
+    MSStepProfiler(OutputDevice *summary, OutputDevice *steps) throw();
+
+
+    /// @brief Destructor
+    ~MSStepProfiler() throw();
+
+
+    /** @brief Ends the active phase and begins the given one
+     * @param[in] phase The phase to begin
+     */
+    void switchPhase(Phase phase) throw() {
+        const Cycles now = getCycles();
+        if (myCurrentPhase!=PHASE_NUMBER) {
+            myStepCycles[myCurrentPhase] += now - myPhaseBegin;
+        }
+        myCurrentPhase = phase;
+        myPhaseBegin = now;
+    }
+
+
+    /** @brief Sets a counter's value for the current step
+     * @param[in] counter The counter to set
+     * @param[in] value The value within the current step
+     */
+    void setCounter(Counter counter, unsigned int value) throw() {
+        myStepCounters[counter] = value;
+    }
+
+
+    /** @brief Ends the active phase and adds the step's values to the statistics
+     *
+     * Writes the step's values if a device for them is given.
+     *
+     * @param[in] step The step which ends
+     */
+    void endStep(SUMOTime step) throw(IOError);
+
+
+    /** @brief Writes the summary if a device for it is given
+     */
+    void writeSummary() throw(IOError);
+
+
+    /** @brief Returns the current value of the time source
+     * @return The current time stamp counter or clock value
+     */
+    static Cycles getCycles() throw() {
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+        unsigned int low, high;
+        __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+        return ((Cycles) high << 32) | low;
+#elif defined(_MSC_VER)
+        return __rdtsc();
+#else
+        return (Cycles) clock();
+#endif
+    }
+
+
+private:
+    /// @brief The number of histogram bins; bin i holds durations in [2^(i-1), 2^i)
+    static const int HISTOGRAM_SIZE = 64;
+
+
+    /**
+     * @struct PhaseStatistics
+     * @brief The durations of a phase over all steps
+     */
+    struct PhaseStatistics {
+        /// @brief The sum of the durations
+        Cycles sum;
+        /// @brief The longest duration within a step
+        Cycles max;
+        /// @brief The number of steps per duration bin
+        unsigned int histogram[HISTOGRAM_SIZE];
+    };
+
+
+    /**
+     * @struct CounterStatistics
+     * @brief The values of a counter over all steps
+     */
+    struct CounterStatistics {
+        /// @brief The sum of the values
+        Cycles sum;
+        /// @brief The maximum value
+        unsigned int max;
+    };
+
+
+    /// @brief Returns the name of the phase as used in the outputs
+    static const char *getName(Phase phase) throw();
+
+    /// @brief Returns the name of the counter as used in the outputs
+    static const char *getName(Counter counter) throw();
+
+
+private:
+    /// @brief The device to write the summary into (0 if not wished)
+    OutputDevice *mySummary;
+
+    /// @brief The device to write the per-step values into (0 if not wished)
+    OutputDevice *mySteps;
+
+    /// @brief The active phase (PHASE_NUMBER if none)
+    Phase myCurrentPhase;
+
+    /// @brief The time the active phase began at
+    Cycles myPhaseBegin;
+
+    /// @brief The durations of the phases within the current step
+    Cycles myStepCycles[PHASE_NUMBER];
+
+    /// @brief The counters' values within the current step
+    unsigned int myStepCounters[COUNTER_NUMBER];
+
+    /// @brief The phases' durations over all steps
+    PhaseStatistics myPhases[PHASE_NUMBER];
+
+    /// @brief The counters' values over all steps
+    CounterStatistics myCounters[COUNTER_NUMBER];
+
+    /// @brief The number of profiled steps
+    unsigned int myStepNumber;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSStepProfiler(const MSStepProfiler&);
+
+    /// @brief Invalidated assignment operator.
+    MSStepProfiler& operator=(const MSStepProfiler&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
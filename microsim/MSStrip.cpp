@@ -55,6 +55,8 @@
 #include <utils/common/ToString.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/common/HelpersHarmonoise.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -74,7 +76,8 @@ MSStrip::MSStrip(const std::string &id, SUMOReal length, MSEdge * const edge, MS
                unsigned int numericalID) throw()
         : myID(id), myNumericalID(numericalID),
         myVehicles(), myEdge(edge), myLane(lane), myLength(length),
-        myVehicleLengthSum(0), myInlappingVehicleEnd(10000), myInlappingVehicle(0) {
+        myVehicleLengthSum(0), myMainVehicleNumber(0), mySpeedSum(0), myFrontPosition(0),
+        myInlappingVehicleEnd(10000), myInlappingVehicle(0) {
 		// Default strip width [m], shouldn't matter much in simulation
 		myWidth = 0.5;
 }
@@ -343,7 +346,7 @@ MSStrip::isEmissionSuccess(MSVehicle* aVehicle,
 
     // get the pointer to the vehicle next in front of the given position
     MSLane::VehCont::iterator predIt =
-        find_if(myVehicles.begin(), myVehicles.end(), bind2nd(VehPosition(), pos));
+        std::lower_bound(myVehicles.begin(), myVehicles.end(), pos, VehPositionLess());
     if (predIt != myVehicles.end()) {
         // ok, there is one (a leader)
         MSVehicle* leader = *predIt;
@@ -401,12 +404,8 @@ MSStrip::isEmissionSuccess(MSVehicle* aVehicle,
     // enter
     //aVehicle->enterLaneAtEmit(this->myLane, pos, speed);
     bool wasInactive = myVehicles.size()==0;
-    if (predIt==myVehicles.end()) {
-        // vehicle will be the first on the lane
-        myVehicles.push_back(aVehicle);
-    } else {
-        myVehicles.insert(predIt, aVehicle);
-    }
+    // if predIt==myVehicles.end(), the vehicle will be the first on the lane
+    insertVehicle(predIt, aVehicle);
     myVehicleLengthSum += aVehicle->getVehicleType().getLength();
     if (wasInactive) {
         MSNet::getInstance()->getEdgeControl().gotActive(this->myLane);
@@ -467,15 +466,17 @@ MSStrip::moveCritical(SUMOTime t) {
     //std::cerr<<"moveCritical for strip: "<<getID()<<std::endl;
     //printDebugMsg();
     std::vector<MSVehicle*> collisions;
+    computeLeaderVSafes();
     VehCont::iterator lastBeforeEnd = myVehicles.end() - 1;
     VehCont::iterator veh;
     // Move all next vehicles beside the first
     for (veh=myVehicles.begin(); veh != lastBeforeEnd; ++veh) {
-        if ((*veh)->isMainStrip(*this)) {
+        if ((*veh)->getStripOccupancy().mainStrip==this) {
             myLeftVehLength -= (*veh)->getVehicleType().getLength();
-            const MSVehicle *pred = (*veh)->getPred();
+            const size_t index = veh - myVehicles.begin();
+            const MSVehicle *pred = myLeaders[index];
             //std::cout<<"my ID: "<<(*veh)->getID()<<"my front leader: "<<pred->getID()<<"\n";
-            if ((*veh)->moveRegardingCritical(t, this->myLane, pred, 0, myLeftVehLength)) {
+            if ((*veh)->moveRegardingCritical(t, this->myLane, pred, 0, myLeftVehLength, pred!=0 ? &myLeaderVSafes[index] : 0)) {
                 MsgHandler::getWarningInstance()->inform("Strip:vehicle collision:");
                 (*veh)->printDebugMsg();
                 collisions.push_back(*veh);
@@ -485,9 +486,10 @@ MSStrip::moveCritical(SUMOTime t) {
    //ashutosh after integration jan 2012
 
 
-    if ((*veh)->isMainStrip(*this)) {
+    if ((*veh)->getStripOccupancy().mainStrip==this) {
         myLeftVehLength -= (*veh)->getVehicleType().getLength();
-        const MSVehicle *pred = (*veh)->getPred();
+        const size_t index = veh - myVehicles.begin();
+        const MSVehicle *pred = myLeaders[index];
         if(pred ==0)
             {
             if ((*veh)->moveRegardingCritical(t, this->myLane, 0, 0, myLeftVehLength)) {
@@ -496,7 +498,7 @@ MSStrip::moveCritical(SUMOTime t) {
             }
         else
         {
-        	if ((*veh)->moveRegardingCritical(t, this->myLane, pred, 0, myLeftVehLength)) {
+        	if ((*veh)->moveRegardingCritical(t, this->myLane, pred, 0, myLeftVehLength, &myLeaderVSafes[index])) {
         	collisions.push_back(*veh);
         	}
         }
@@ -507,8 +509,128 @@ MSStrip::moveCritical(SUMOTime t) {
 //........................................ after integration
     assert((*veh)->getPositionOnLane() <= myLength);
     //assert(&(*veh)->getLane()==this->myLane);
-    // deal with collisions
-    for (std::vector<MSVehicle*>::iterator i=collisions.begin(); i!=collisions.end(); ++i) {
+    return teleportCollided(collisions);
+}
+
+
+void
+MSStrip::planMoveCritical(SUMOTime t) throw() {
+    myPlannedMoves.clear();
+    computeLeaderVSafes();
+    SUMOReal lengthsInFront = myVehicleLengthSum;
+    for (VehCont::iterator veh=myVehicles.begin(); veh!=myVehicles.end(); ++veh) {
+        // strip ids are lane-local; a vehicle spanning lanes is planned on its main strip only
+        if ((*veh)->getStripOccupancy().mainStrip==this) {
+            lengthsInFront -= (*veh)->getVehicleType().getLength();
+            const size_t index = veh - myVehicles.begin();
+            const MSVehicle *pred = myLeaders[index];
+            PlannedMove plan;
+            plan.vehicle = *veh;
+            plan.lengthsInFront = lengthsInFront;
+            plan.collided = (*veh)->planCriticalMove(t, myLane, pred, 0, lengthsInFront, false,
+                            pred!=0 ? &myLeaderVSafes[index] : 0);
+            myPlannedMoves.push_back(plan);
+        }
+    }
+}
+
+
+void
+MSStrip::computeLeaderVSafes() throw() {
+    myLeaders.assign(myVehicles.size(), 0);
+    myLeaderVSafes.assign(myVehicles.size(), 0);
+    // the kinematic values are read from the store, in the strip's order
+    const std::vector<SUMOReal> &positions = MSKinematicStore::getPositions();
+    const std::vector<SUMOReal> &speeds = MSKinematicStore::getSpeeds();
+    const std::vector<SUMOReal> &lengths = MSKinematicStore::getLengths();
+    const MSCFModel *model = 0;
+    for (size_t i=0; i<=myVehicles.size(); ++i) {
+        const MSVehicle *veh = i<myVehicles.size() ? myVehicles[i] : 0;
+        const MSVehicle *pred = 0;
+        if (veh!=0&&veh->getStripOccupancy().mainStrip==this) {
+            pred = veh->getPred();
+            myLeaders[i] = pred;
+        }
+        if (pred==0&&veh!=0) {
+            continue;
+        }
+        // the run ends at the strip's end or with the first vehicle using another model
+        if (veh==0||&veh->getCarFollowModel()!=model) {
+            if (!myBatchIndices.empty()) {
+                myBatchVSafes.resize(myBatchIndices.size());
+                model->ffeVBatch(&myBatchVehicles[0], &myBatchSpeeds[0], &myBatchGaps[0],
+                                 &myBatchPredSpeeds[0], &myBatchVSafes[0], myBatchIndices.size());
+                for (size_t j=0; j<myBatchIndices.size(); ++j) {
+                    myLeaderVSafes[myBatchIndices[j]] = myBatchVSafes[j];
+                }
+            }
+            myBatchIndices.clear();
+            myBatchVehicles.clear();
+            myBatchSpeeds.clear();
+            myBatchGaps.clear();
+            myBatchPredSpeeds.clear();
+            if (veh==0) {
+                break;
+            }
+            model = &veh->getCarFollowModel();
+        }
+        const MSKinematicStore::Slot slot = mySlots[i];
+        const MSKinematicStore::Slot predSlot = pred->getKinematicSlot();
+        // as MSVehicle::gap2pred
+        SUMOReal gap = positions[predSlot] - lengths[predSlot] - positions[slot];
+        if (gap<0&&gap>-1.0e-12) {
+            gap = 0;
+        }
+        myBatchIndices.push_back(i);
+        myBatchVehicles.push_back(veh);
+        myBatchSpeeds.push_back(speeds[slot]);
+        myBatchGaps.push_back(gap);
+        myBatchPredSpeeds.push_back(speeds[predSlot]);
+    }
+}
+
+
+bool
+MSStrip::applyMoveCritical(SUMOTime t, bool &replan) {
+    if (replan) {
+        // the teleported vehicles may have been leaders of the planned ones
+        return moveCritical(t);
+    }
+    myLeftVehLength = myVehicleLengthSum;
+    if (myVehicles.size() == 0) {
+        return true;
+    }
+    std::vector<MSVehicle*> collisions;
+    std::vector<PlannedMove>::const_iterator plan = myPlannedMoves.begin();
+    for (VehCont::iterator veh=myVehicles.begin(); veh!=myVehicles.end(); ++veh) {
+        if ((*veh)->getStripOccupancy().mainStrip!=this) {
+            continue;
+        }
+        assert(plan!=myPlannedMoves.end()&&(*plan).vehicle==*veh);
+        myLeftVehLength = (*plan).lengthsInFront;
+        if ((*plan).collided) {
+            // move again; reports the collision as moveCritical does
+            if ((*veh)->moveRegardingCritical(t, this->myLane, (*veh)->getPred(), 0, myLeftVehLength)) {
+                if (veh+1!=myVehicles.end()) {
+                    MsgHandler::getWarningInstance()->inform("Strip:vehicle collision:");
+                    (*veh)->printDebugMsg();
+                }
+                collisions.push_back(*veh);
+            }
+        } else {
+            (*veh)->applyCriticalMove(false, myLeftVehLength);
+        }
+        ++plan;
+    }
+    assert(myVehicles.back()->getPositionOnLane() <= myLength);
+    replan = !collisions.empty();
+    return teleportCollided(collisions);
+}
+
+
+bool
+MSStrip::teleportCollided(const std::vector<MSVehicle*> &collisions) {
+    for (std::vector<MSVehicle*>::const_iterator i=collisions.begin(); i!=collisions.end(); ++i) {
         MsgHandler::getWarningInstance()->inform("Strip:moveCrit:Teleporting vehicle '" + (*i)->getID() + "'; collision, lane='" + getID() + "', time=" + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".");
         myVehicleLengthSum -= (*i)->getVehicleType().getLength();     
         //myVehicles.erase(find(myVehicles.begin(), myVehicles.end(), *i));
@@ -525,6 +647,16 @@ MSStrip::detectCollisions(SUMOTime) {
         return;
     }
 
+    // look for an overlap in the kinematic store first; usually, there is none
+    const std::vector<SUMOReal> &positions = MSKinematicStore::getPositions();
+    const std::vector<SUMOReal> &lengths = MSKinematicStore::getLengths();
+    bool overlap = false;
+    for (size_t i=1; i<mySlots.size()&&!overlap; ++i) {
+        overlap = positions[mySlots[i]] - lengths[mySlots[i]] - positions[mySlots[i-1]] < 0;
+    }
+    if (!overlap) {
+        return;
+    }
     VehCont::iterator lastVeh = myVehicles.end() - 1;
     for (VehCont::iterator veh = myVehicles.begin(); veh != lastVeh;) {
         VehCont::iterator pred = veh + 1;
@@ -695,22 +827,31 @@ time=" + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".");
         }
     }
     // check for vehicle removal
-    for (VehCont::iterator veh = myVehicles.begin(); veh != myVehicles.end();) {
+    //  the removed vehicles are collected and erased in one pass afterwards
+    //  the speeds have changed within this step, so the speed sum is rebuilt, too
+    std::vector<size_t> removed;
+    SUMOReal speedSum = 0;
+    for (VehCont::iterator veh = myVehicles.begin(); veh != myVehicles.end(); ++veh) {
         MSVehicle *vehV = *veh;
         if (vehV->getPositionOnLane()>getLength()) {
             MsgHandler::getWarningInstance()->inform("Strip:setCrit4Teleporting vehicle '" + vehV->getID() + "'; beyond lane (2), targetLane='" + getID() + "', time=" + time2string(MSNet::getInstance()->getCurrentTimeStep()) + ".");
             MSVehicleTransfer::getInstance()->addVeh(vehV);
-            veh = myVehicles.erase(veh); // remove current vehicle
+            removed.push_back(veh - myVehicles.begin());
         } else if (vehV->ends()) { // route end
             //std::cerr<<"RtEnd   :REMed "<<remove<<" vehicle:"<<vehV->getID()<<" from strip:"<<getID()<<std::endl;
             myVehicleLengthSum -= vehV->getVehicleType().getLength();
             vehV->onRemovalFromNet(false);
             MSNet::getInstance()->getVehicleControl().scheduleVehicleRemoval(vehV);
-            veh = myVehicles.erase(veh); // remove current vehicle
+            removed.push_back(veh - myVehicles.begin());
         } else {
-            ++veh;
+            if (vehV->isCountedAsMain(this)) {
+                speedSum += vehV->getSpeed();
+            }
         }
     }
+    eraseVehicles(removed);
+    myLane->mySpeedSum += speedSum - mySpeedSum;
+    mySpeedSum = speedSum;
     return myVehicles.size()==0;
 }
 
@@ -756,8 +897,12 @@ MSStrip::insertIDs(std::vector<std::string> &into) throw() {
 
 
 bool
-MSStrip::push(MSVehicle* veh) {  
+MSStrip::push(MSVehicle* veh) {
+    if (myVehBuffer.empty()) {
+        myLane->myStripsToIntegrate.push_back(this);
+    }
     myVehBuffer.push_back(veh);
+    return false;
 }
 
 
@@ -767,16 +912,12 @@ MSStrip::pop(SUMOTime t, MSVehicle *v) {
 
     //TODO: fix the movement bug and remove this part
     // No movement bug, it happpens even in orig SUMO
-    VehCont::iterator veh = myVehicles.end() - 1;
-    while (veh != myVehicles.begin() - 1) {
-        if (*veh == v) {
-            veh = myVehicles.erase(veh);
-            myVehicleLengthSum -= v->getVehicleType().getLength();
-            break;
-        }
-        --veh;
+    VehCont::iterator veh = findVehicle(v);
+    assert(veh != myVehicles.end());
+    if (veh != myVehicles.end()) {
+        eraseVehicle(veh);
+        myVehicleLengthSum -= v->getVehicleType().getLength();
     }
-    assert (veh != myVehicles.begin() - 1);
     return v;
     
     MSVehicle* first = myVehicles.back();
@@ -803,7 +944,7 @@ MSStrip::integrateNewVehicle(SUMOTime) {
     sort(myVehBuffer.begin(), myVehBuffer.end(), vehicle_position_sorter());
     for (std::vector<MSVehicle*>::const_iterator i=myVehBuffer.begin(); i!=myVehBuffer.end(); ++i) {
         MSVehicle *veh = *i;
-        myVehicles.push_front(veh);
+        insertVehicle(myVehicles.begin(), veh);
         myVehicleLengthSum += veh->getVehicleType().getLength();
     }
     myVehBuffer.clear();
@@ -916,8 +1057,176 @@ MSStrip::getLinkCont() const {
 
 void
 MSStrip::swapAfterLaneChange(SUMOTime) {
+    const bool wasOccupied = !myVehicles.empty();
+    for (VehCont::const_iterator i=myVehicles.begin(); i!=myVehicles.end(); ++i) {
+        (*i)->removeStripPosition(this);
+    }
     myVehicles = myTmpVehicles;
     myTmpVehicles.clear();
+    myFrontPosition = 0;
+    updatePositions(0, myVehicles.size());
+    mySlots.clear();
+    for (VehCont::const_iterator i=myVehicles.begin(); i!=myVehicles.end(); ++i) {
+        mySlots.push_back((*i)->getKinematicSlot());
+    }
+    if (wasOccupied&&myVehicles.empty()) {
+        myLane->stripEmptied(this);
+    } else if (!wasOccupied&&!myVehicles.empty()) {
+        myLane->stripOccupied(this);
+    }
+    // vehicles may have changed their main strip
+    recountVehicles();
+}
+
+
+void
+MSStrip::addToCounters(MSVehicle *veh) throw() {
+    if (myVehicles.size()==1) {
+        myLane->stripOccupied(this);
+    }
+    if (veh->isMainStrip(*this)) {
+        veh->setCountedAsMain(this, true);
+        ++myMainVehicleNumber;
+        ++myLane->myVehicleNumber;
+        mySpeedSum += veh->getSpeed();
+        myLane->mySpeedSum += veh->getSpeed();
+    }
+}
+
+
+void
+MSStrip::removeFromCounters(MSVehicle *veh) throw() {
+    // the vehicle's main strip may have changed since it was counted; decrement
+    //  only what was counted, so the counters can not underflow
+    if (veh->isCountedAsMain(this)) {
+        assert(myMainVehicleNumber>0);
+        veh->setCountedAsMain(this, false);
+        --myMainVehicleNumber;
+        --myLane->myVehicleNumber;
+        mySpeedSum -= veh->getSpeed();
+        myLane->mySpeedSum -= veh->getSpeed();
+        if (myMainVehicleNumber==0) {
+            // do not let rounding errors accumulate
+            myLane->mySpeedSum -= mySpeedSum;
+            mySpeedSum = 0;
+        }
+        if (myLane->myVehicleNumber==0) {
+            myLane->mySpeedSum = 0;
+        }
+    }
+}
+
+
+MSStrip::VehContIter
+MSStrip::insertVehicle(VehContIter i, MSVehicle *veh) throw() {
+    const size_t index = i - myVehicles.begin();
+    i = myVehicles.insert(i, veh);
+    mySlots.insert(mySlots.begin() + index, veh->getKinematicSlot());
+    if (index<myVehicles.size()/2) {
+        // the vehicles in front of the inserted one keep their handles
+        --myFrontPosition;
+        updatePositions(0, index+1);
+    } else {
+        // the vehicles behind the inserted one keep their handles
+        updatePositions(index, myVehicles.size());
+    }
+    addToCounters(veh);
+    return i;
+}
+
+
+MSStrip::VehContIter
+MSStrip::eraseVehicle(VehContIter i) throw() {
+    MSVehicle *veh = *i;
+    const size_t index = i - myVehicles.begin();
+    if (myVehicles.size()==1) {
+        myLane->stripEmptied(this);
+    }
+    removeFromCounters(veh);
+    veh->removeStripPosition(this);
+    i = myVehicles.erase(i);
+    mySlots.erase(mySlots.begin() + index);
+    if (myVehicles.empty()) {
+        myFrontPosition = 0;
+    } else if (index<myVehicles.size()/2) {
+        ++myFrontPosition;
+        updatePositions(0, index);
+    } else {
+        updatePositions(index, myVehicles.size());
+    }
+    return i;
+}
+
+
+void
+MSStrip::eraseVehicles(const std::vector<size_t> &indices) throw() {
+    if (indices.empty()) {
+        return;
+    }
+    if (indices.size()==myVehicles.size()) {
+        myLane->stripEmptied(this);
+    }
+    // compact both containers behind the first erased vehicle
+    size_t next = 0;
+    size_t write = indices[0];
+    for (size_t read=indices[0]; read<myVehicles.size(); ++read) {
+        if (next<indices.size()&&indices[next]==read) {
+            assert(next==0||indices[next-1]<read);
+            removeFromCounters(myVehicles[read]);
+            myVehicles[read]->removeStripPosition(this);
+            ++next;
+            continue;
+        }
+        myVehicles[write] = myVehicles[read];
+        mySlots[write] = mySlots[read];
+        ++write;
+    }
+    myVehicles.resize(write);
+    mySlots.resize(write);
+    if (myVehicles.empty()) {
+        myFrontPosition = 0;
+    } else {
+        updatePositions(indices[0], myVehicles.size());
+    }
+}
+
+
+MSStrip::VehContIter
+MSStrip::findVehicle(const MSVehicle *veh) throw() {
+    long pos;
+    if (!veh->getStripPosition(this, pos)) {
+        return myVehicles.end();
+    }
+    VehContIter i = myVehicles.begin() + (pos - myFrontPosition);
+    assert(*i==veh);
+    return i;
+}
+
+
+void
+MSStrip::updatePositions(size_t from, size_t to) throw() {
+    for (size_t i=from; i<to; ++i) {
+        myVehicles[i]->setStripPosition(this, myFrontPosition + (long) i);
+    }
+}
+
+
+void
+MSStrip::recountVehicles() throw() {
+    myLane->myVehicleNumber -= myMainVehicleNumber;
+    myLane->mySpeedSum -= mySpeedSum;
+    myMainVehicleNumber = 0;
+    mySpeedSum = 0;
+    for (VehCont::const_iterator i=myVehicles.begin(); i!=myVehicles.end(); ++i) {
+        const bool main = (*i)->isMainStrip(*this);
+        (*i)->setCountedAsMain(this, main);
+        if (main) {
+            ++myMainVehicleNumber;
+            ++myLane->myVehicleNumber;
+            mySpeedSum += (*i)->getSpeed();
+            myLane->mySpeedSum += (*i)->getSpeed();
+        }
+    }
 }
 
 
@@ -932,7 +1241,7 @@ MSVehicle *
 MSStrip::removeFirstVehicle() {
     MSVehicle *veh = *(myVehicles.end()-1);
     veh->leaveLaneAtMove(0);
-    myVehicles.erase(myVehicles.end()-1);
+    eraseVehicle(myVehicles.end()-1);
     myVehicleLengthSum -= veh->getVehicleType().getLength();
     return veh;
 }
@@ -940,13 +1249,11 @@ MSStrip::removeFirstVehicle() {
 
 MSVehicle *
 MSStrip::removeVehicle(MSVehicle * remVehicle) {
-    for (MSLane::VehCont::iterator it = myVehicles.begin(); it < myVehicles.end(); it++) {
-        if (remVehicle->getID() == (*it)->getID()) {
-            remVehicle->leaveLane(true);
-            myVehicles.erase(it);
-            myVehicleLengthSum -= remVehicle->getVehicleType().getLength();
-            break;
-        }
+    VehContIter it = findVehicle(remVehicle);
+    if (it!=myVehicles.end()) {
+        remVehicle->leaveLane(true);
+        eraseVehicle(it);
+        myVehicleLengthSum -= remVehicle->getVehicleType().getLength();
     }
     return remVehicle;
 }
@@ -1122,29 +1429,21 @@ MSStrip::getVehLenSum() const throw() {
 
 
 SUMOReal
-MSStrip::getMeanSpeed() const throw() {   if ((SUMOReal) getVehicleNumber()==0) { //ashu modification 16 november
-   //if (myVehicles.size()==0) {
-       // return myLane->getMaxSpeed();
-          return 0; 
-    }
-    SUMOReal v = 0;
-    const MSStrip::VehCont &vehs = getVehiclesSecure();
-    for (VehCont::const_iterator i=vehs.begin(); i!=vehs.end(); ++i) {
-        if ((*i)->isMainStrip(*this))
-            v += (*i)->getSpeed();
-    }
-    SUMOReal ret = v / (SUMOReal) getVehicleNumber();
-    releaseVehicles();
-    return ret;
+MSStrip::getMeanSpeed() const throw() {
+    if (myMainVehicleNumber==0) { //ashu modification 16 november
+        return 0;
+    }
+    return mySpeedSum / (SUMOReal) myMainVehicleNumber;
 }
 
 MSVehicle *
 MSStrip::getPred(const MSVehicle *veh) const {
-    VehCont::const_iterator it = std::find(myVehicles.begin(), myVehicles.end(), veh);
-    
-    if (it == myVehicles.end())
+    long pos;
+    if (!veh->getStripPosition(this, pos))
         return 0;
     
+    VehCont::const_iterator it = myVehicles.begin() + (pos - myFrontPosition);
+    assert(*it == veh);
     if (it == myVehicles.end() - 1) {
         if (myInlappingVehicle != 0)
             return myInlappingVehicle;
@@ -1159,6 +1458,12 @@ MSStrip::getPred(const MSVehicle *veh) const {
 
 void
 MSStrip::printDebugMsg(const std::string &msg) const {
+    WRITE_WARNING(getDebugMsg(msg));
+}
+
+
+std::string
+MSStrip::getDebugMsg(const std::string &msg) const {
     std::stringstream out;
     out << msg << "::";
     out << getID() << ":" << ": len-" << getLength() << ": " << myVehicles.size() << "[";
@@ -1168,14 +1473,42 @@ MSStrip::printDebugMsg(const std::string &msg) const {
         out << (*it)->getID() << "(" << (int)(*it)->getPositionOnLane() << ")" << " :";
     }
     out << "\b]" << myVehicleLengthSum;
-    WRITE_WARNING(out.str());
+    return out.str();
 }
 
 MSStrip::VehContIter
 MSStrip::eraseFromStrip(MSVehicle* veh) {
-    std::deque<MSVehicle*>::iterator vehS = std::find(myVehicles.begin(), myVehicles.end(), veh);
-    vehS = myVehicles.erase(vehS);
-    return vehS;
+    VehContIter vehS = findVehicle(veh);
+    assert(vehS != myVehicles.end());
+    return eraseVehicle(vehS);
+}
+
+
+void
+MSStrip::saveState(std::ostream &os) throw() {
+    FileHelpers::writeFloat(os, myVehicleLengthSum);
+    FileHelpers::writeUInt(os, (unsigned int) myVehicles.size());
+    for (VehContConstIter i=myVehicles.begin(); i!=myVehicles.end(); ++i) {
+        FileHelpers::writeString(os, (*i)->getID());
+    }
+}
+
+
+void
+MSStrip::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    bis >> myVehicleLengthSum;
+    unsigned int size;
+    bis >> size;
+    for (; size>0; size--) {
+        std::string id;
+        bis >> id;
+        MSVehicle *veh = vc.getVehicle(id);
+        if (veh==0) {
+            MsgHandler::getErrorInstance()->inform("The unknown vehicle '" + id + "' is stored in strip '" + getID() + "'.");
+        } else {
+            insertVehicle(myVehicles.end(), veh);
+        }
+    }
 }
 /****************************************************************************/
 
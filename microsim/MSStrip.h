@@ -32,6 +32,7 @@
 #include "MSLane.h"
 #include "MSEdge.h"
 #include "MSEdgeControl.h"
+#include <algorithm>
 #include <bitset>
 #include <deque>
 #include <vector>
@@ -40,6 +41,7 @@
 #include <string>
 #include <iostream>
 #include "MSNet.h"
+#include "MSKinematicStore.h"
 #include <utils/geom/Position2DVector.h>
 #include <utils/common/SUMOTime.h>
 #include <utils/common/SUMOVehicleClass.h>
@@ -55,7 +57,9 @@ class MSMoveReminder;
 class GUILaneWrapper;
 class GUIGlObjectStorage;
 class MSVehicleTransfer;
+class MSVehicleControl;
 class OutputDevice;
+class BinaryInputDevice;
 
 
 // ===========================================================================
@@ -92,6 +96,16 @@ public:
         }
     };
 
+    /** Function-object for binary searches within the vehicles container
+        (which is sorted by the vehicles' positions, ascending). */
+    struct VehPositionLess : public std::binary_function< const MSVehicle*,
+                SUMOReal, bool > {
+        /// returns whether the vehicle is behind the given position
+        bool operator()(const MSVehicle* cmp, SUMOReal pos) const {
+            return cmp->getPositionOnLane() < pos;
+        }
+    };
+
 
 public:
     /** @brief Constructor
@@ -225,20 +239,14 @@ public:
      * @return The number of vehicles on this lane
      */
     unsigned int getVehicleNumber() const throw() {
-        //return (unsigned int) myVehicles.size();
-        //or is this meaning correct
-        ///*
-        unsigned int count=0;
-        for (VehCont::const_iterator it = myVehicles.begin(); it != myVehicles.end(); ++it) {
-         if ((*it)->isMainStrip(*this))
-             count++;
-        }
-        return count;
-        //*/
+        // only vehicles which have this strip as their main strip are counted
+        return myMainVehicleNumber;
     }
     
     void pushIntoStrip(MSVehicle *veh) {
-        myVehicles.push_front(veh);
+        // keep the container sorted; usually, vehicles are emitted at the lane's begin
+        insertVehicle(std::lower_bound(myVehicles.begin(), myVehicles.end(),
+                                       veh->getPositionOnLane(), VehPositionLess()), veh);
     }
 
 
@@ -256,6 +264,18 @@ public:
     /** @brief Allows to use the container for microsimulation again
      */
     virtual void releaseVehicles() const throw() { }
+
+
+    /** @brief Returns the kinematic store slots of the vehicles
+     *
+     * The slots are stored in the order of the vehicles container, the
+     *  rearmost vehicle first.
+     * @return The vehicles' slots
+     * @see MSKinematicStore
+     */
+    const std::deque<MSKinematicStore::Slot> &getSlots() const throw() {
+        return mySlots;
+    }
     /// @}
 
 
@@ -326,6 +346,30 @@ public:
 
     virtual bool moveCritical(SUMOTime t);
 
+
+    /** @brief Plans the moves of the vehicles which have this strip as main strip
+     *
+     * Stores the results of MSVehicle::planCriticalMove in myPlannedMoves.
+     *  Only the plans and the planned vehicles are changed, so that strips
+     *  of different lanes may be planned in parallel.
+     *
+     * @param[in] t The current time step
+     */
+    void planMoveCritical(SUMOTime t) throw();
+
+
+    /** @brief Applies the planned moves; yields the same as moveCritical
+     *
+     * If replan is set, the plans are discarded and moveCritical is used.
+     *  Otherwise, the planned moves are applied; vehicles for which a
+     *  collision was planned are moved again for reporting it in order.
+     *
+     * @param[in] t The current time step
+     * @param[in, out] replan Whether vehicles were teleported before; set if vehicles are teleported herein
+     * @return Whether the strip is empty afterwards
+     */
+    bool applyMoveCritical(SUMOTime t, bool &replan);
+
     /** Moves the critical vehicles
         This step is done after the responds have been set */
     virtual bool setCritical(SUMOTime t, std::vector<MSLane*> &into);
@@ -374,8 +418,8 @@ public:
     /// Returns next vehicle in the container which is at position greater
     /// than the one given
     MSVehicle *getPredAtPos(SUMOReal pos=0) const {
-        VehContConstIter vehIt = std::find_if(myVehicles.begin(), myVehicles.end(), 
-                                                std::bind2nd(VehPosition(), pos));
+        VehContConstIter vehIt = std::lower_bound(myVehicles.begin(), myVehicles.end(),
+                                                  pos, VehPositionLess());
         if (vehIt == myVehicles.end()) return 0;
         return *vehIt; 
     }
@@ -419,6 +463,9 @@ public:
     
     void printDebugMsg(const std::string &s="") const;
 
+    /// @brief Returns the message printDebugMsg writes as a warning
+    std::string getDebugMsg(const std::string &s="") const;
+
     /** Same as succLink, but does not throw any assertions when
         the succeeding link could not be found;
         Returns the myLinks.end() instead; Further, the number of edges to
@@ -515,6 +562,25 @@ public:
     }
 
     MSStrip::VehContIter eraseFromStrip(MSVehicle *veh);
+
+
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the ids of the vehicles in the order they are stored herein
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Puts the vehicles into the container in the saved order
+     *
+     * The vehicles must have been loaded by MSVehicleControl::loadState.
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     */
+    void loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
     
 protected:
     /** @brief Insert a vehicle into the lane's vehicle buffer.
@@ -529,6 +595,100 @@ protected:
     virtual void swapAfterLaneChange(SUMOTime t);
 
 
+    /** @brief Teleports the vehicles which collided while moving critical
+     * @param[in] collisions The collided vehicles
+     * @return Whether the strip is empty afterwards
+     */
+    bool teleportCollided(const std::vector<MSVehicle*> &collisions);
+
+
+    /** @brief Determines the leaders of the main strip vehicles and their safe speeds
+     *
+     * Fills myLeaders and myLeaderVSafes, both in the order of myVehicles.
+     *  The safe speeds are computed by MSCFModel::ffeVBatch for each run of
+     *  vehicles using the same car-following model; the speeds and gaps are
+     *  read from MSKinematicStore using mySlots.
+     */
+    void computeLeaderVSafes() throw();
+
+
+    /// @name Maintenance of the vehicle counters
+    /// @{
+
+    /** @brief Updates the counters for a vehicle put into myVehicles
+     *
+     * Must be called right after the vehicle was inserted; informs the lane
+     *  if the strip got occupied.
+     * @param[in] veh The added vehicle
+     */
+    void addToCounters(MSVehicle *veh) throw();
+
+
+    /** @brief Updates the counters for a vehicle removed from myVehicles
+     *
+     * Must be called right before the vehicle is erased. The main vehicle
+     *  counters are decremented only if the vehicle was counted as a main
+     *  vehicle of this strip.
+     * @param[in] veh The removed vehicle
+     */
+    void removeFromCounters(MSVehicle *veh) throw();
+
+
+    /** @brief Rebuilds the counters from myVehicles (after a lane change)
+     */
+    void recountVehicles() throw();
+    /// @}
+
+
+    /// @name Maintenance of the vehicles' position handles
+    /// @{
+
+    /** @brief Inserts the vehicle into myVehicles before the given position
+     *
+     * Updates the position handles of the vehicles on the shorter side of the
+     *  insertion point as well as the counters.
+     * @param[in] i The position to insert the vehicle at
+     * @param[in] veh The vehicle to insert
+     * @return The position of the inserted vehicle
+     */
+    VehContIter insertVehicle(VehContIter i, MSVehicle *veh) throw();
+
+
+    /** @brief Erases the vehicle at the given position from myVehicles
+     *
+     * Updates the position handles of the vehicles on the shorter side of the
+     *  erased one as well as the counters.
+     * @param[in] i The position of the vehicle to erase
+     * @return The position of the vehicle which followed the erased one
+     */
+    VehContIter eraseVehicle(VehContIter i) throw();
+
+
+    /** @brief Erases the vehicles at the given positions from myVehicles in one pass
+     *
+     * The remaining vehicles are moved forward over the erased ones, so that
+     *  removing k vehicles costs O(n) instead of the O(k*n) of single erasures.
+     *  Updates the position handles of the moved vehicles as well as the counters.
+     * @param[in] indices The ascending positions of the vehicles to erase
+     */
+    void eraseVehicles(const std::vector<size_t> &indices) throw();
+
+
+    /** @brief Returns the position of the given vehicle within myVehicles
+     * @param[in] veh The vehicle to find
+     * @return The vehicle's position, myVehicles.end() if it is not stored herein
+     */
+    VehContIter findVehicle(const MSVehicle *veh) throw();
+
+
+    /** @brief Sets the position handles of the vehicles stored at the given indices
+     * @param[in] from The first index to update
+     * @param[in] to The index behind the last one to update
+     */
+    void updatePositions(size_t from, size_t to) throw();
+    /// @}
+
+
 
 protected:
     /// Unique ID.
@@ -576,6 +736,22 @@ protected:
     /// @brief The current length of all vehicles on this lane
     SUMOReal myVehicleLengthSum;
 
+    /// @brief The number of vehicles which have this strip as main strip
+    unsigned int myMainVehicleNumber;
+
+    /// @brief The sum of the speeds of the vehicles which have this strip as main strip
+    SUMOReal mySpeedSum;
+
+    /** @brief The position handle of the vehicle at myVehicles.front()
+     *
+     * A vehicle stored at index i within myVehicles has the position handle
+     *  myFrontPosition+i; see MSVehicle::myStripPositions.
+     */
+    long myFrontPosition;
+
+    /// @brief The kinematic store slots of the vehicles in myVehicles, in the same order
+    std::deque<MSKinematicStore::Slot> mySlots;
+
     /// @brief End position of a vehicle which laps into this lane
     SUMOReal myInlappingVehicleEnd;
 
@@ -592,6 +768,38 @@ protected:
     /// @brief Not yet seen vehicle lengths
     SUMOReal myLeftVehLength;
 
+    /**
+     * @struct PlannedMove
+     * @brief The result of planning a vehicle's critical move
+     */
+    struct PlannedMove {
+        /// @brief The planned vehicle
+        MSVehicle *vehicle;
+        /// @brief The lengths of the vehicles in front of it
+        SUMOReal lengthsInFront;
+        /// @brief Whether the vehicle collided
+        bool collided;
+    };
+
+    /// @brief The planned moves in the order of myVehicles; see planMoveCritical
+    std::vector<PlannedMove> myPlannedMoves;
+
+    /// @brief The leaders of the vehicles in myVehicles (0 if none or not the main strip); see computeLeaderVSafes
+    std::vector<const MSVehicle*> myLeaders;
+
+    /// @brief The safe speeds towards the leaders in myLeaders; see computeLeaderVSafes
+    std::vector<SUMOReal> myLeaderVSafes;
+
+    /// @name Input of the current ffeVBatch call; see computeLeaderVSafes
+    /// @{
+    std::vector<size_t> myBatchIndices;
+    std::vector<const MSVehicle*> myBatchVehicles;
+    std::vector<SUMOReal> myBatchSpeeds;
+    std::vector<SUMOReal> myBatchGaps;
+    std::vector<SUMOReal> myBatchPredSpeeds;
+    std::vector<SUMOReal> myBatchVSafes;
+    /// @}
+
     /** The lane's Links to it's succeeding lanes and the default
         right-of-way rule, i.e. blocked or not blocked. */
     MSLinkCont myLinks;
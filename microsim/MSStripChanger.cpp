@@ -35,6 +35,7 @@
 #include <iterator>
 #include <cstdlib>
 #include <cmath>
+#include <sstream>
 #include <microsim/MSAbstractLaneChangeModel.h>
 #include <utils/common/MsgHandler.h>
 
@@ -46,7 +47,8 @@
 // ===========================================================================
 // member method definitions
 // ===========================================================================
-MSStripChanger::MSStripChanger(std::vector<MSStrip*>* strips) {
+MSStripChanger::MSStripChanger(std::vector<MSStrip*>* strips)
+        : myBufferDebugOutput(false) {
     assert(strips->size() > 1);
 
     // Fill the changer with the strip-data.
@@ -75,11 +77,11 @@ MSStripChanger::laneChange(SUMOTime t) {
     // needs an update to prevent multiple changes of one vehicle.
     // Finally, the change-result has to be given back to the lanes.
     initChanger();
-    std::cerr<<"\n\nOneIterOfLaneChange\n";
+    writeDebug(DEBUG_CERR, "\n\nOneIterOfLaneChange\n");
     for (ChangerIt it = myChanger.begin(); it != myChanger.end(); ++it) {
-        it->strip->printDebugMsg();
+        writeDebug(DEBUG_WARNING, it->strip->getDebugMsg());
     }
-    std::cerr<<std::endl;
+    writeDebug(DEBUG_CERR, "\n");
     while (vehInChanger()) {
         ChangerIt left, right;
         bool haveChanged = change(left, right);
@@ -89,6 +91,57 @@ MSStripChanger::laneChange(SUMOTime t) {
 }
 
 
+bool
+MSStripChanger::collectForeignEdges(std::vector<const MSEdge*> &ahead,
+                                    std::vector<const MSEdge*> &behind) const throw() {
+    bool withReminders = false;
+    for (ConstChangerIt ce = myChanger.begin(); ce != myChanger.end(); ++ce) {
+        if (!ce->lane->getMoveReminders().empty()) {
+            withReminders = true;
+        }
+        const MSStrip::VehCont &vehicles = ce->strip->myVehicles;
+        for (MSStrip::VehContConstIter i = vehicles.begin(); i != vehicles.end(); ++i) {
+            if ((*i)->isMainStrip(*ce->strip) && (*i)->collectLaneChangeEdges(ahead, behind)) {
+                withReminders = true;
+            }
+        }
+    }
+    return withReminders;
+}
+
+
+void
+MSStripChanger::writeDebug(DebugTarget target, const std::string &msg) throw() {
+    if (myBufferDebugOutput) {
+        myDebugOutput.push_back(std::make_pair(target, msg));
+        return;
+    }
+    switch (target) {
+    case DEBUG_CERR:
+        std::cerr << msg;
+        break;
+    case DEBUG_COUT:
+        std::cout << msg;
+        break;
+    case DEBUG_WARNING:
+        WRITE_WARNING(msg);
+        break;
+    }
+}
+
+
+void
+MSStripChanger::flushDebugOutput() throw() {
+    const bool buffer = myBufferDebugOutput;
+    myBufferDebugOutput = false;
+    for (std::vector<std::pair<DebugTarget, std::string> >::const_iterator i = myDebugOutput.begin(); i != myDebugOutput.end(); ++i) {
+        writeDebug((*i).first, (*i).second);
+    }
+    myDebugOutput.clear();
+    myBufferDebugOutput = buffer;
+}
+
+
 void
 MSStripChanger::initChanger() {
     // Prepare myChanger with a safe state.
@@ -233,8 +286,10 @@ MSStripChanger::change(ChangerIt& leftMostStrip, ChangerIt& rightMostStrip) {
 	        /*std::cout << "TraCI: lane changer fulfilled request for RIGHT |time " << MSNet::getInstance()->getCurrentTimeStep() << "s" << std::endl;*/
 	#endif
 
-	        std::cerr<<"Ashutosh:"<<vehicle->getID()<<"state"<<state1<<"changingAllowed"<<changingAllowed;
-	        std::cerr<<"!!Vehicle:"<<vehicle->getID()<<" changing to right.\n";
+	        std::ostringstream msg;
+	        msg<<"Ashutosh:"<<vehicle->getID()<<"state"<<state1<<"changingAllowed"<<changingAllowed;
+	        msg<<"!!Vehicle:"<<vehicle->getID()<<" changing to right.\n";
+	        writeDebug(DEBUG_CERR, msg.str());
 	        // Order is important here, strips of vehicle are from left to right (increasing index),
 	        // myChanger Elements are from right to left (increasing index)
 	        enteredStrips.clear();
@@ -259,7 +314,9 @@ MSStripChanger::change(ChangerIt& leftMostStrip, ChangerIt& rightMostStrip) {
 	        vehicle->myLastLaneChangeOffset = 0;
 	        vehicle->getLaneChangeModel().changed();
 	        (rightMostStrip - 1)->dens += (rightMostStrip - 1)->hoppedVeh->getVehicleType().getLength();
-	        std::cout<<"my strips"<<vehicle->getStripIDs()<<"\n";
+	        msg.str("");
+	        msg<<"my strips"<<vehicle->getStripIDs()<<"\n";
+	        writeDebug(DEBUG_COUT, msg.str());
 	        return true;
 	    }
 
@@ -296,8 +353,10 @@ MSStripChanger::change(ChangerIt& leftMostStrip, ChangerIt& rightMostStrip) {
 	#endif
 
 
-	        std::cerr<<" changing allowed = "<<changingAllowed<<" state 2 = "<<state2;
-	        std::cerr<<"!!Vehicle:"<<vehicle->getID()<<" changing to left.\n";
+	        std::ostringstream msg;
+	        msg<<" changing allowed = "<<changingAllowed<<" state 2 = "<<state2;
+	        msg<<"!!Vehicle:"<<vehicle->getID()<<" changing to left.\n";
+	        writeDebug(DEBUG_CERR, msg.str());
 	        enteredStrips.clear();
 	        // Order important, refer above
 	        for (ChangerIt ci = rightMostStrip+1; ci != leftMostStrip+2; ++ci) {
@@ -394,6 +453,8 @@ MSStripChanger::change(ChangerIt& leftMostStrip, ChangerIt& rightMostStrip) {
 	                    p1 = vehicle->getSpeed();
 	                    vehicle->myState.mySpeed = prohibitor->myState.mySpeed;
 	                    prohibitor->myState.mySpeed = p1;
+	                    vehicle->storeState();
+	                    prohibitor->storeState();
 	                    // enter lane and detectors
 	                    vehicle->enterLaneAtLaneChange(target->lane);
 	                    prohibitor->enterLaneAtLaneChange(myCandi->lane);
@@ -922,7 +983,7 @@ MSStripChanger::getLeftMostStrip(ChangerIt candi) {
     ChangerIt ce = candi;
     
     for (; ce != myChanger.end(); ++ce) {
-        if (ce->strip->getID() == vehicle->getLeftStrip()->getID())
+        if (ce->strip == vehicle->getLeftStrip())
             break;
     }
     assert (ce != myChanger.end());
@@ -937,7 +998,7 @@ MSStripChanger::getRightMostStrip(ChangerIt candi) {
     ChangerIt ce = candi;
     
     for (; ce >= myChanger.begin(); --ce) {
-        if (ce->strip->getID() == vehicle->getRightStrip()->getID())
+        if (ce->strip == vehicle->getRightStrip())
             break;
     }
     assert(ce != myChanger.begin()-1);
@@ -33,6 +33,7 @@
 #include "MSLane.h"
 #include "MSEdge.h"
 #include <vector>
+#include <string>
 #include <utils/iodevices/OutputDevice.h>
 
 
@@ -60,6 +61,28 @@ public:
     /// Start lateral-movement-process for all vehicles on the edge's lane's strips.
     void laneChange(SUMOTime t);
 
+    /** @brief Collects the other edges the next call to laneChange may use
+     *
+     * @param[out] ahead Receives the edges whose occupation may be read
+     * @param[out] behind Receives the edges whose partial occupation may be changed
+     * @return Whether move reminders may be notified
+     * @see MSVehicle::collectLaneChangeEdges
+     */
+    bool collectForeignEdges(std::vector<const MSEdge*> &ahead,
+                             std::vector<const MSEdge*> &behind) const throw();
+
+    /** @brief Sets whether the debug output shall be kept until flushDebugOutput is called
+     *
+     * Used while the changers of several edges run in parallel.
+     * @param[in] buffer Whether the output shall be buffered
+     */
+    void setBufferDebugOutput(bool buffer) throw() {
+        myBufferDebugOutput = buffer;
+    }
+
+    /// @brief Writes and clears the buffered debug output
+    void flushDebugOutput() throw();
+
 public:
     /** Structure used for lane-change. For every lane you have to
         know four vehicles, the change-candidate veh and it's follower
@@ -206,6 +229,23 @@ protected:
 
     ChangerIt getLeftMostStrip(ChangerIt candi);
     ChangerIt getRightMostStrip(ChangerIt candi);
+
+    /// @brief Where a debug message goes
+    enum DebugTarget {
+        /// @brief std::cerr
+        DEBUG_CERR,
+        /// @brief std::cout
+        DEBUG_COUT,
+        /// @brief The warnings' MsgHandler
+        DEBUG_WARNING
+    };
+
+    /** @brief Writes the debug message or buffers it if wished
+     * @param[in] target Where the message goes
+     * @param[in] msg The message
+     */
+    void writeDebug(DebugTarget target, const std::string &msg) throw();
+
 protected:
     /// Container for ChangeElemements, one for every lane in the edge.
     Changer   myChanger;
@@ -215,6 +255,12 @@ protected:
         once in the change-process. */
     ChangerIt myCandi;
 
+    /// @brief Whether debug output is buffered
+    bool myBufferDebugOutput;
+
+    /// @brief The buffered debug output
+    std::vector<std::pair<DebugTarget, std::string> > myDebugOutput;
+
 private:
     /// Default constructor.
     MSStripChanger();
@@ -161,6 +161,7 @@ MSVehicle::~MSVehicle() throw() {
     //
     delete myParameter;
     delete myLaneChangeModel;
+    MSKinematicStore::release(mySlot);
     for (std::vector< MSDevice* >::iterator dev=myDevices.begin(); dev != myDevices.end(); ++dev) {
         delete(*dev);
     }
@@ -210,6 +211,7 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars,
         myOldLaneMoveReminderOffsets(0),
         myArrivalPos(pars->arrivalPos),
         myPreDawdleAcceleration(0),
+        mySlot(MSKinematicStore::allocate(type->getLength(), type->getStripWidth())),
         myEdgeWeights(0),
         myWasBraking(false)
 #ifndef NO_TRACI
@@ -246,6 +248,9 @@ MSVehicle::MSVehicle(SUMOVehicleParameter* pars,
     myWidth = type->getStripWidth();
     //std::cerr << "VEHICLE width: " << myWidth << std::endl;
     myStrips.reserve(myWidth);
+    myStripIDs.reserve(myWidth);
+    myStripPositions.reserve(myWidth);
+    updateStripOccupancy();
     
     // build arrival definition
     SUMOReal lastLaneLength = (myRoute->getLastEdge()->getLanes())[0]->getLength();
@@ -793,7 +798,18 @@ bool
 MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
                                  const MSVehicle * const pred,
                                  const MSVehicle * const neigh,
-                                 SUMOReal lengthsInFront) throw() {
+                                 SUMOReal lengthsInFront,
+                                 const SUMOReal *predVSafe) throw() {
+    // the planning does not look at the approached links, so they may be
+    //  released afterwards
+    bool collided = planCriticalMove(t, lane, pred, neigh, lengthsInFront, true, predVSafe);
+    applyCriticalMove(collided, lengthsInFront);
+    return collided;
+}
+
+
+void
+MSVehicle::applyCriticalMove(bool collided, SUMOReal lengthsInFront) throw() {
 #ifdef _MESSAGES
     if (myHBMsgEmitter != 0) {
         if (isOnRoad()) {
@@ -802,18 +818,38 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
         }
     }
 #endif
-#ifdef DEBUG_VEHICLE_GUI_SELECTION
-    if (gSelected.isSelected(GLO_VEHICLE, static_cast<const GUIVehicle*>(this)->getGlID())) {
-        int bla = 0;
-    }
-#endif
-    myTarget = 0;
     for (DriveItemVector::iterator i=myLFLinkLanes.begin(); i!=myLFLinkLanes.end(); ++i) {
         if ((*i).myLink!=0) {
             (*i).myLink->removeApproaching(this);
         }
     }
     myLFLinkLanes.clear();
+    if (collided) {
+        return;
+    }
+    myLFLinkLanes.swap(myPlannedLFLinkLanes);
+    //@ to be optimized (move to somewhere else)
+    if (hasCORNIntValue(MSCORN::CORN_VEH_LASTREROUTEOFFSET)) {
+        myIntCORNMap[MSCORN::CORN_VEH_LASTREROUTEOFFSET] = myIntCORNMap[MSCORN::CORN_VEH_LASTREROUTEOFFSET] + 1;
+    }
+    //@ to be optimized (move to somewhere else)
+    checkRewindLinkLanes(lengthsInFront);
+}
+
+
+bool
+MSVehicle::planCriticalMove(SUMOTime t, const MSLane* const lane,
+                            const MSVehicle * const pred,
+                            const MSVehicle * const neigh,
+                            SUMOReal lengthsInFront, bool report,
+                            const SUMOReal *predVSafe) throw() {
+#ifdef DEBUG_VEHICLE_GUI_SELECTION
+    if (gSelected.isSelected(GLO_VEHICLE, static_cast<const GUIVehicle*>(this)->getGlID())) {
+        int bla = 0;
+    }
+#endif
+    myTarget = 0;
+    myPlannedLFLinkLanes.clear();
     const MSCFModel &cfModel = getCarFollowModel();
     // check whether the vehicle is not on an appropriate lane
     if (!myLane->appropriate(this)) {
@@ -825,7 +861,9 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
             SUMOReal gap = gap2pred(*pred);
             if (MSGlobals::gCheck4Accidents && gap<0) {
                 // collision occured!
-                printDebugMsg("moveRC1");
+                if (report) {
+                    printDebugMsg("moveRC1");
+                }
                 return true;
             }
             vWish = MIN2(vWish, cfModel.ffeV(this, pred));
@@ -836,7 +874,9 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
                 SUMOReal gap = myLane->getPartialOccupatorEnd() - myState.myPos;
                 if (MSGlobals::gCheck4Accidents && gap<0) {
                     // collision occured!
-                    printDebugMsg("moveRC2");
+                    if (report) {
+                        printDebugMsg("moveRC2");
+                    }
                     return true;
                 }
                 vWish = MIN2(vWish, cfModel.ffeV(this, gap, predP->getSpeed()));
@@ -851,7 +891,7 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
             vWish = MIN2(vWish, vsafeStop);
         }
         vWish = MAX2((SUMOReal) 0, vWish);
-        myLFLinkLanes.push_back(DriveProcessItem(0, vWish, vWish, false, 0, 0, myLane->getLength()-myState.myPos));
+        myPlannedLFLinkLanes.push_back(DriveProcessItem(0, vWish, vWish, false, 0, 0, myLane->getLength()-myState.myPos));
 
     } else {
         // compute other values as in move
@@ -860,11 +900,13 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
             SUMOReal gap = gap2pred(*pred);
             if (MSGlobals::gCheck4Accidents && gap<0) {
                 // collision occured!
-                printDebugMsg("moveRC3");
-                pred->printDebugMsg();
+                if (report) {
+                    printDebugMsg("moveRC3");
+                    pred->printDebugMsg();
+                }
                 return true;
             }
-            SUMOReal vSafe = cfModel.ffeV(this, gap, pred->getSpeed());
+            SUMOReal vSafe = predVSafe!=0 ? *predVSafe : cfModel.ffeV(this, gap, pred->getSpeed());
             //  the vehicle is bound by the lane speed and must not drive faster
             //  than vsafe to the next vehicle
             vBeg = MIN2(vBeg, vSafe);
@@ -875,7 +917,9 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
                 SUMOReal gap = myLane->getPartialOccupatorEnd() - myState.myPos;
                 if (MSGlobals::gCheck4Accidents && gap<0) {
                     // collision occured!
-                    printDebugMsg("moveRC4");
+                    if (report) {
+                        printDebugMsg("moveRC4");
+                    }
                     return true;
                 }
                 vBeg = MIN2(vBeg, cfModel.ffeV(this, gap, predP->getSpeed()));
@@ -886,12 +930,6 @@ MSVehicle::moveRegardingCritical(SUMOTime t, const MSLane* const lane,
         // set next links, computing possible speeds
         vsafeCriticalCont(t, vBeg, lengthsInFront);
     }
-    //@ to be optimized (move to somewhere else)
-    if (hasCORNIntValue(MSCORN::CORN_VEH_LASTREROUTEOFFSET)) {
-        myIntCORNMap[MSCORN::CORN_VEH_LASTREROUTEOFFSET] = myIntCORNMap[MSCORN::CORN_VEH_LASTREROUTEOFFSET] + 1;
-    }
-    //@ to be optimized (move to somewhere else)
-    checkRewindLinkLanes(lengthsInFront);
     return false;
 }
 
@@ -994,6 +1032,7 @@ MSVehicle::moveFirstChecked() {
     // update position and speed
     myState.myPos += SPEED2DIST(vNext);
     myState.mySpeed = vNext;
+    storeState();
     myTarget = 0;
     std::vector<MSLane*> passedLanes;
     for (std::vector<MSLane*>::reverse_iterator i=myFurtherLanes.rbegin(); i!=myFurtherLanes.rend(); ++i) {
@@ -1026,6 +1065,7 @@ MSVehicle::moveFirstChecked() {
             //  approach on the following lanes when a lane changing is performed
             assert(approachedLane!=0);
             myState.myPos -= approachedLane->getLength();
+            storeState();
             assert(myState.myPos>0);
             if (approachedLane!=myLane) {
                 // XXX: error, we haven't handled this yet. Need to change LFLinkLanes// modification_AB
@@ -1231,7 +1271,7 @@ MSVehicle::vsafeCriticalCont(SUMOTime t, SUMOReal boundVSafe, SUMOReal lengthsIn
 //......................
 
     	// not "reaching critical"
-        myLFLinkLanes.push_back(DriveProcessItem(0, boundVSafe, boundVSafe, false, 0, 0, seen));
+        myPlannedLFLinkLanes.push_back(DriveProcessItem(0, boundVSafe, boundVSafe, false, 0, 0, seen));
         return;
     }
 
@@ -1269,7 +1309,7 @@ MSVehicle::vsafeCriticalCont(SUMOTime t, SUMOReal boundVSafe, SUMOReal lengthsIn
         if (nextLane->isLinkEnd(link)) {
             // the vehicle will not drive further
             SUMOReal laneEndVSafe = cfModel.ffeS(this, seen);
-            myLFLinkLanes.push_back(DriveProcessItem(0, MIN2(vLinkPass, laneEndVSafe), MIN2(vLinkPass, laneEndVSafe), false, 0, 0, seen));
+            myPlannedLFLinkLanes.push_back(DriveProcessItem(0, MIN2(vLinkPass, laneEndVSafe), MIN2(vLinkPass, laneEndVSafe), false, 0, 0, seen));
             return;
         }
         // the link was passed
@@ -1333,13 +1373,13 @@ MSVehicle::vsafeCriticalCont(SUMOTime t, SUMOReal boundVSafe, SUMOReal lengthsIn
         if ((yellow||red)&&seen>cfModel.brakeGap(myState.mySpeed)-SPEED2DIST(myState.mySpeed)*cfModel.getTau()) { // !!! we should reuse brakeGap with no reaction time...
             vLinkPass = vLinkWait;
             setRequest = false;
-            myLFLinkLanes.push_back(DriveProcessItem(*link, vLinkWait, vLinkWait, false, t+TIME2STEPS(seen / vLinkPass), vLinkPass, seen));
+            myPlannedLFLinkLanes.push_back(DriveProcessItem(*link, vLinkWait, vLinkWait, false, t+TIME2STEPS(seen / vLinkPass), vLinkPass, seen));
         }
         // the next condition matches the previously one used for determining the difference
         //  between critical/non-critical vehicles. Though, one should assume that a vehicle
         //  should want to move over an intersection even though it could brake before it!?
         setRequest &= dist-seen>0;
-        myLFLinkLanes.push_back(DriveProcessItem(*link, vLinkPass, vLinkWait, setRequest, t + TIME2STEPS(seen / vLinkPass), vLinkPass, seen));
+        myPlannedLFLinkLanes.push_back(DriveProcessItem(*link, vLinkPass, vLinkWait, setRequest, t + TIME2STEPS(seen / vLinkPass), vLinkPass, seen));
         seen += nextLane->getLength();
         seenNonInternal += nextLane->getEdge().getPurpose()==MSEdge::EDGEFUNCTION_INTERNAL ? 0 : nextLane->getLength();
         if ((vLinkPass<=0||seen>dist)&&hadNonInternal&&seenNonInternal>50) {
@@ -1385,6 +1425,7 @@ MSVehicle::enterLaneAtMove(MSLane* enteredLane, SUMOReal driven, const StripCont
     if (hasMainStrip) {
         myLane = enteredLane;
         myStrips.clear();
+        updateStripOccupancy();
     }
     
     //XXX: Getting through ID, actually get through links
@@ -1429,6 +1470,7 @@ MSVehicle::enterStripAtMove(MSStrip* strip) {
         //++it;
     //myStrips.insert(it, strip);
     myStrips.push_back(strip);
+    updateStripOccupancy();
 }
 
 void
@@ -1480,11 +1522,13 @@ MSVehicle::enterLaneAtLaneChange(MSLane* enteredLane) {
 void
 MSVehicle::enterStripsAtStripChange(const StripCont &strips) {
     myStrips = strips;
+    updateStripOccupancy();
 }
 
 void
 MSVehicle::enterLaneAtEmit(MSLane* enteredLane, SUMOReal pos, SUMOReal speed, StripCont &strips) {
     myState = State(pos, speed);
+    storeState();
     assert(myState.myPos >= 0);
     assert(myState.mySpeed >= 0);
     myWaitingTime = 0;
@@ -1495,6 +1539,7 @@ MSVehicle::enterLaneAtEmit(MSLane* enteredLane, SUMOReal pos, SUMOReal speed, St
     //enterStripAtMove(myLane->getStrip(0));
     myStrips.clear();
     myStrips = strips;
+    updateStripOccupancy();
     // set and activate the new lane's reminders
     for (std::vector< MSDevice* >::iterator dev=myDevices.begin(); dev != myDevices.end(); ++dev) {
         (*dev)->enterLaneAtEmit(enteredLane, myState);
@@ -1933,6 +1978,155 @@ MSVehicle::saveState(std::ostream &os) {
     FileHelpers::writeTime(os, myEventTime);
     FileHelpers::writeTime(os, myLastEntryTime);
 #endif
+    // the departure definition (needed by vehicles which are not emitted yet)
+    FileHelpers::writeInt(os, myParameter->departProcedure);
+    FileHelpers::writeInt(os, myParameter->departLaneProcedure);
+    FileHelpers::writeInt(os, myParameter->departLane);
+    FileHelpers::writeInt(os, myParameter->departPosProcedure);
+    FileHelpers::writeFloat(os, myParameter->departPos);
+    FileHelpers::writeInt(os, myParameter->departSpeedProcedure);
+    FileHelpers::writeFloat(os, myParameter->departSpeed);
+    FileHelpers::writeInt(os, myParameter->arrivalPosProcedure);
+    FileHelpers::writeFloat(os, myParameter->arrivalPos);
+    FileHelpers::writeInt(os, myParameter->setParameter);
+    // the microscopic state
+    FileHelpers::writeFloat(os, myState.myPos);
+    FileHelpers::writeFloat(os, myState.mySpeed);
+    FileHelpers::writeFloat(os, myPreDawdleAcceleration);
+    FileHelpers::writeByte(os, myWasBraking);
+    FileHelpers::writeInt(os, myLaneChangeModel->getState());
+    FileHelpers::writeString(os, myLane!=0 ? myLane->getID() : "");
+    FileHelpers::writeUInt(os, (unsigned int) myStrips.size());
+    for (StripContConstIter i=myStrips.begin(); i!=myStrips.end(); ++i) {
+        FileHelpers::writeString(os, (*i)->getLane()->getID());
+        FileHelpers::writeUInt(os, (unsigned int)(*i)->getNumericalID());
+    }
+    FileHelpers::writeUInt(os, (unsigned int) myFurtherLanes.size());
+    for (std::vector<MSLane*>::const_iterator i=myFurtherLanes.begin(); i!=myFurtherLanes.end(); ++i) {
+        FileHelpers::writeString(os, (*i)->getID());
+    }
+    // the links approached within the last step, given by their lane and index
+    FileHelpers::writeUInt(os, (unsigned int) myLFLinkLanes.size());
+    const MSLane *from = myLane;
+    for (DriveItemVector::const_iterator i=myLFLinkLanes.begin(); i!=myLFLinkLanes.end(); ++i) {
+        int index = -1;
+        if ((*i).myLink!=0&&from!=0) {
+            const MSLinkCont &links = from->getLinkCont();
+            MSLinkCont::const_iterator link = std::find(links.begin(), links.end(), (*i).myLink);
+            if (link!=links.end()) {
+                index = (int) std::distance(links.begin(), link);
+            }
+        }
+        FileHelpers::writeString(os, index>=0 ? from->getID() : "");
+        FileHelpers::writeInt(os, index);
+        FileHelpers::writeFloat(os, (*i).myVLinkPass);
+        FileHelpers::writeFloat(os, (*i).myVLinkWait);
+        FileHelpers::writeTime(os, (*i).myArrivalTime);
+        FileHelpers::writeFloat(os, (*i).myArrivalSpeed);
+        FileHelpers::writeFloat(os, (*i).myDistance);
+        FileHelpers::writeByte(os, (*i).mySetRequest);
+        if ((*i).myLink!=0) {
+#ifdef HAVE_INTERNAL_LANES
+            from = (*i).myLink->getViaLane()!=0 ? (*i).myLink->getViaLane() : (*i).myLink->getLane();
+#else
+            from = (*i).myLink->getLane();
+#endif
+        }
+    }
+}
+
+
+void
+MSVehicle::loadState(BinaryInputDevice &bis) throw() {
+    SUMOReal pos, speed;
+    bis >> pos;
+    bis >> speed;
+    myState = State(pos, speed);
+    storeState();
+    bis >> myPreDawdleAcceleration;
+    bis >> myWasBraking;
+    int laneChangeState;
+    bis >> laneChangeState;
+    myLaneChangeModel->setState(laneChangeState);
+    std::string laneID;
+    bis >> laneID;
+    unsigned int size;
+    bis >> size;
+    StripCont strips;
+    for (; size>0; size--) {
+        std::string stripLaneID;
+        bis >> stripLaneID;
+        unsigned int index;
+        bis >> index;
+        MSLane *stripLane = MSLane::dictionary(stripLaneID);
+        if (stripLane==0||index>=stripLane->getWidth()) {
+            MsgHandler::getErrorInstance()->inform("Vehicle '" + getID() + "' occupies the unknown strip " + toString(index) + " of lane '" + stripLaneID + "'.");
+        } else {
+            strips.push_back(stripLane->getStrip(index));
+        }
+    }
+    bis >> size;
+    std::vector<MSLane*> furtherLanes;
+    for (; size>0; size--) {
+        std::string furtherLaneID;
+        bis >> furtherLaneID;
+        MSLane *furtherLane = MSLane::dictionary(furtherLaneID);
+        if (furtherLane==0) {
+            MsgHandler::getErrorInstance()->inform("Vehicle '" + getID() + "' laps into the unknown lane '" + furtherLaneID + "'.");
+        } else {
+            furtherLanes.push_back(furtherLane);
+        }
+    }
+    bis >> size;
+    for (; size>0; size--) {
+        std::string fromLaneID;
+        bis >> fromLaneID;
+        int index;
+        bis >> index;
+        SUMOReal vPass, vWait, arrivalSpeed, distance;
+        SUMOTime arrivalTime;
+        bool setRequest;
+        bis >> vPass;
+        bis >> vWait;
+        bis >> arrivalTime;
+        bis >> arrivalSpeed;
+        bis >> distance;
+        bis >> setRequest;
+        MSLink *link = 0;
+        MSLane *fromLane = MSLane::dictionary(fromLaneID);
+        if (fromLane!=0&&index>=0&&index<(int) fromLane->getLinkCont().size()) {
+            link = fromLane->getLinkCont()[index];
+        }
+        myLFLinkLanes.push_back(DriveProcessItem(link, vPass, vWait, setRequest, arrivalTime, arrivalSpeed, distance));
+    }
+    if (laneID=="") {
+        // the vehicle is not emitted yet or teleporting
+        return;
+    }
+    MSLane *lane = MSLane::dictionary(laneID);
+    if (lane==0||strips.size()!=myWidth) {
+        MsgHandler::getErrorInstance()->inform("Vehicle '" + getID() + "' cannot be put on lane '" + laneID + "'.");
+        return;
+    }
+    // enter the lane
+    myLane = lane;
+    myStrips = strips;
+    updateStripOccupancy();
+    for (std::vector< MSDevice* >::iterator dev=myDevices.begin(); dev != myDevices.end(); ++dev) {
+        (*dev)->enterLaneAtLoadState(lane, myState);
+    }
+    myMoveReminders = lane->getMoveReminders();
+    activateReminders(false, false);
+    SUMOReal leftLength = myType->getLength() - pos;
+    for (std::vector<MSLane*>::iterator i=furtherLanes.begin(); i!=furtherLanes.end()&&leftLength>0; ++i) {
+        myFurtherLanes.push_back(*i);
+        leftLength -= (*i)->setPartialOccupation(this, leftLength);
+    }
+    for (DriveItemVector::iterator i=myLFLinkLanes.begin(); i!=myLFLinkLanes.end(); ++i) {
+        if ((*i).myLink!=0) {
+            (*i).myLink->setApproaching(this, (*i).myArrivalTime, (*i).myArrivalSpeed, (*i).mySetRequest);
+        }
+    }
 }
 
 
@@ -1965,6 +2159,35 @@ MSVehicle::getBestLanesContinuation(const MSLane * const l) const throw() {
 }
 
 
+bool
+MSVehicle::collectLaneChangeEdges(std::vector<const MSEdge*> &ahead,
+                                  std::vector<const MSEdge*> &behind) const throw() {
+    // rebuildContinuationsFor examines at most 9 edges in front
+    MSRouteIterator next = myCurrEdge;
+    for (int seen=0; seen<10&&next!=myRoute->end(); ++seen) {
+        if (++next!=myRoute->end()) {
+            ahead.push_back(*next);
+        }
+    }
+    // edges partially occupied now or after entering the new lane
+    for (std::vector<MSLane*>::const_iterator i=myFurtherLanes.begin(); i!=myFurtherLanes.end(); ++i) {
+        behind.push_back(&(*i)->getEdge());
+    }
+    SUMOReal leftLength = getVehicleType().getLength();
+    for (MSRouteIterator i=myCurrEdge; i!=myRoute->begin()&&leftLength>0;) {
+        const MSEdge * const prev = *(--i);
+        behind.push_back(prev);
+        const std::vector<MSLane*> &lanes = prev->getLanes();
+        SUMOReal shortest = lanes[0]->getLength();
+        for (std::vector<MSLane*>::const_iterator j=lanes.begin()+1; j!=lanes.end(); ++j) {
+            shortest = MIN2(shortest, (*j)->getLength());
+        }
+        leftLength -= shortest;
+    }
+    return !myMoveReminders.empty()||!myOldLaneMoveReminders.empty();
+}
+
+
 
 SUMOReal
 MSVehicle::getDistanceToPosition(SUMOReal destPos, const MSEdge* destEdge) {
@@ -2069,45 +2292,118 @@ MSVehicle::getPred() const {
 
 bool
 MSVehicle::isMainStrip(const MSStrip &strip) const {
-    //XXX: possible compare just pointers to MSStrip to gain performance
-	#define SUBSTR  std::basic_string<char>::substr
-	std::string strip1 = getMainStrip().getID();
-	std::string strip2 = strip.getID();
-	std::string lane1="";
-	std::string lane2="";
-	std::string stripindex1 = "";
-	std::string stripindex2 = "";
-	lane1 = strip1.SUBSTR(7, strip1.size());
-	lane2 = strip2.SUBSTR(7, strip2.size());
-	 if(lane1 != lane2){
-		 stripindex1 = strip1.SUBSTR(5,2);
-		 stripindex2 = strip2.SUBSTR(5,2);
-		 if(strip1.SUBSTR(5,2) != strip2.SUBSTR(5,2)){
-			 std::cerr<<"Strip numbers are: "<<strip1<<" "<<strip2<<" "<<lane1 <<" "<<lane2<<" "<<stripindex1<<" "<<stripindex2<<"\n";
-		 }
-		 return strip1.SUBSTR(5,2) == strip2.SUBSTR(5,2);
-	}
-	else
-		 return getMainStrip().getID() == strip.getID();
-
-}
-
-std::vector<int> 
-MSVehicle::getStripIDs() const {
-    // Because a vehicle may be in multiple lanes at a time
-    std::vector<int> v;
-    v.reserve(myStrips.size());
-    for (StripCont::const_iterator it = myStrips.begin(); it != myStrips.end(); ++it) {
-        v.push_back((*it)->getNumericalID());
+    if (strip.getLane()==myOccupancy.lane) {
+        return &strip==myOccupancy.mainStrip;
+    }
+    return strip.getNumericalID()==myOccupancy.firstStrip;
+}
+
+
+void
+MSVehicle::updateStripOccupancy() throw() {
+    myOccupancy.stripNumber = myStrips.size();
+    myStripIDs.clear();
+    if (myStrips.empty()) {
+        myOccupancy.lane = 0;
+        myOccupancy.firstStrip = 0;
+        myOccupancy.mainStrip = 0;
+        myLaneStripIDs.resize(1);
+        myLaneStripIDs[0].clear();
+        return;
+    }
+    myOccupancy.mainStrip = myStrips[0];
+    myOccupancy.lane = myStrips[0]->getLane();
+    myOccupancy.firstStrip = myStrips[0]->getNumericalID();
+    // Assumption is that lanes are added from left to right
+    // Holds true because of how strips are arranged in myStrips (left to right)
+    // And also because mainStrip is defined as rightMost strip
+    // coupled to MSStrip::setCritical - push, pop
+    size_t laneNo = 1;
+    for (StripContConstIter it=myStrips.begin()+1; it!=myStrips.end(); ++it) {
+        if ((*it)->getLane()!=(*(it-1))->getLane()) {
+            ++laneNo;
+        }
+    }
+    // resize keeps the inner containers (and their capacity) that are still needed
+    myLaneStripIDs.resize(laneNo);
+    for (size_t i=0; i<laneNo; ++i) {
+        myLaneStripIDs[i].clear();
+    }
+    size_t lane = 0;
+    const MSLane *prev = myOccupancy.lane;
+    for (StripContConstIter it=myStrips.begin(); it!=myStrips.end(); ++it) {
+        if ((*it)->getLane()!=prev) {
+            prev = (*it)->getLane();
+            ++lane;
+        }
+        myStripIDs.push_back((int)(*it)->getNumericalID());
+        myLaneStripIDs[lane].push_back((int)(*it)->getNumericalID());
+    }
+}
+
+
+void
+MSVehicle::setStripPosition(const MSStrip *strip, long pos) throw() {
+    for (std::vector<StripPosition>::iterator i=myStripPositions.begin(); i!=myStripPositions.end(); ++i) {
+        if ((*i).strip==strip) {
+            (*i).pos = pos;
+            return;
+        }
+    }
+    StripPosition handle;
+    handle.strip = strip;
+    handle.pos = pos;
+    handle.countedAsMain = false;
+    myStripPositions.push_back(handle);
+}
+
+
+bool
+MSVehicle::getStripPosition(const MSStrip *strip, long &pos) const throw() {
+    for (std::vector<StripPosition>::const_iterator i=myStripPositions.begin(); i!=myStripPositions.end(); ++i) {
+        if ((*i).strip==strip) {
+            pos = (*i).pos;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+void
+MSVehicle::removeStripPosition(const MSStrip *strip) throw() {
+    for (std::vector<StripPosition>::iterator i=myStripPositions.begin(); i!=myStripPositions.end(); ++i) {
+        if ((*i).strip==strip) {
+            *i = myStripPositions.back();
+            myStripPositions.pop_back();
+            return;
+        }
     }
-    return v;
 }
-//?? ACE ??--
-size_t
-MSVehicle::getMainStripNumericalID() const {
-	//std::cout << this->getMainStrip().getID() << "ssss";
-	return getMainStrip().getNumericalID();
-}//--?? ACE ??
+
+
+void
+MSVehicle::setCountedAsMain(const MSStrip *strip, bool counted) throw() {
+    for (std::vector<StripPosition>::iterator i=myStripPositions.begin(); i!=myStripPositions.end(); ++i) {
+        if ((*i).strip==strip) {
+            (*i).countedAsMain = counted;
+            return;
+        }
+    }
+    assert(false);
+}
+
+
+bool
+MSVehicle::isCountedAsMain(const MSStrip *strip) const throw() {
+    for (std::vector<StripPosition>::const_iterator i=myStripPositions.begin(); i!=myStripPositions.end(); ++i) {
+        if ((*i).strip==strip) {
+            return (*i).countedAsMain;
+        }
+    }
+    return false;
+}
+
 
 void
 MSVehicle::printDebugMsg(const std::string &msg) const {
@@ -2148,39 +2444,6 @@ MSVehicle::eraseFromStrips(MSStrip *strip) {
     return newIter;
 }
 
-const std::vector<std::vector<int> > 
-MSVehicle::getLanes() const {
-    std::vector<std::vector<int> > lanes;
-    const std::vector<int> empty;
-    lanes.push_back(empty);
-    MSLane *prev=0;
-    // Assumption is that lanes are added to map from left to right
-    // Holds true because of how strips are arranged in myStrips (left to right)
-    // And also because mainStrip is defined as rightMost strip
-    // coupled to MSStrip::setCritical - push, pop
-    for (StripContConstIter it = myStrips.begin(); it!=myStrips.end(); ++it) {
-        MSLane *lane = (*it)->getLane();
-        if (prev == 0) prev = lane;
-        if (prev != lane) {
-            lanes.push_back(empty);
-            lanes.back().push_back((*it)->getNumericalID());
-            prev = lane;
-        } else {
-            lanes.back().push_back((*it)->getNumericalID());
-        }
-    }
-  /*  std::cerr<<"getLanes: ";
-    for (int i=0; i<lanes.size(); ++i) {
-        std::cerr<<i<<"[";
-        for (int j=0; j<lanes[i].size(); ++j) {
-            if (isMainStrip(*myLane->getStrip(lanes[i][j]))) std::cerr<<lanes[i][j]<<"*";
-            else std::cerr<<lanes[i][j]<<" ";
-        }
-        std::cerr<<"]\t";
-    }*/
-    return lanes;
-}
-
 #ifndef NO_TRACI
 
 bool
@@ -45,6 +45,7 @@
 #include <utils/common/SUMOVehicle.h>
 #include <utils/common/SUMOVehicleClass.h>
 #include "MSVehicleType.h"
+#include "MSKinematicStore.h"
 #include <utils/common/SUMOAbstractRouter.h>
 
 #ifdef HAVE_MESOSIM
@@ -66,6 +67,7 @@ class MSBusStop;
 class OutputDevice;
 class MSDevice;
 class MSEdgeWeightsStorage;
+class BinaryInputDevice;
 #ifdef _MESSAGES
 class MSMessageEmitter;
 #endif
@@ -91,6 +93,9 @@ public:
     //friend class MSLaneChanger;
     friend class MSStripChanger;
 
+    /// the strips maintain the vehicle's position handles (myStripPositions)
+    friend class MSStrip;
+
     /** @class State
      * @brief Container that holds the vehicles driving state (position+speed).
      */
@@ -166,6 +171,23 @@ public:
     typedef std::vector<MSStrip *> StripCont;
     typedef std::vector<MSStrip *>::iterator StripContIter;
     typedef std::vector<MSStrip *>::const_iterator StripContConstIter;
+
+    /** @struct StripOccupancy
+     * @brief Compact description of the strips a vehicle occupies
+     *
+     * Rebuilt whenever the vehicle's strips change, so that asking whether a
+     *  strip is the vehicle's main strip does not need to look at strip ids.
+     */
+    struct StripOccupancy {
+        /// @brief The lane of the main strip
+        const MSLane *lane;
+        /// @brief The numerical id of the main (first) strip
+        size_t firstStrip;
+        /// @brief The number of strips occupied (over all lanes)
+        size_t stripNumber;
+        /// @brief The main strip
+        const MSStrip *mainStrip;
+    };
     
     /// @name insertion/removal
     //@{
@@ -334,7 +356,15 @@ public:
         return myStrips;
     }
     
-    std::vector<int> getStripIDs() const;
+    /// Returns the numerical ids of the vehicle's strips (in the order of myStrips)
+    const std::vector<int> &getStripIDs() const {
+        return myStripIDs;
+    }
+
+    /// Returns the compact description of the strips the vehicle occupies
+    const StripOccupancy &getStripOccupancy() const {
+        return myOccupancy;
+    }
     
     void enterStripAtMove(MSStrip *strip);
     
@@ -426,15 +456,49 @@ public:
 
 
     /** @brief Moves vehicles which may run out of the lane
+     *
+     * Plans the move (see planCriticalMove) and applies it (see applyCriticalMove).
      *
      * @param[in] lane The lane the vehicle is on
      * @param[in] pred The leader (may be 0)
      * @param[in] neigh The neighbor vehicle (may be 0)
      * @param[in] lengthsInFront Sum of vehicle lengths in front of the vehicle
+     * @param[in] predVSafe The precomputed safe speed towards the leader (computed if 0)
      * @return Whether a collision occured (gap2pred(leader)<=0)
      */
     bool moveRegardingCritical(SUMOTime t, const MSLane* const lane, const MSVehicle * const pred,
-                               const MSVehicle * const neigh, SUMOReal lengthsInFront) throw();
+                               const MSVehicle * const neigh, SUMOReal lengthsInFront,
+                               const SUMOReal *predVSafe=0) throw();
+
+
+    /** @brief Computes the links the vehicle will approach and the speeds to use
+     *
+     * The result is stored in myPlannedLFLinkLanes. Only the vehicle itself is
+     *  changed; links and other vehicles are only read. Therefore, vehicles
+     *  may be planned in parallel as long as no vehicle is planned twice.
+     *
+     * @param[in] lane The lane the vehicle is on
+     * @param[in] pred The leader (may be 0)
+     * @param[in] neigh The neighbor vehicle (may be 0)
+     * @param[in] lengthsInFront Sum of vehicle lengths in front of the vehicle
+     * @param[in] report Whether debug information about collisions shall be written
+     * @param[in] predVSafe The precomputed safe speed towards the leader, see MSCFModel::ffeVBatch (computed if 0)
+     * @return Whether a collision occured (gap2pred(leader)<=0)
+     */
+    bool planCriticalMove(SUMOTime t, const MSLane* const lane, const MSVehicle * const pred,
+                          const MSVehicle * const neigh, SUMOReal lengthsInFront, bool report,
+                          const SUMOReal *predVSafe=0) throw();
+
+
+    /** @brief Applies the previously planned move
+     *
+     * Removes the vehicle from the previously approached links and, if no
+     *  collision occured, approaches the planned ones.
+     *
+     * @param[in] collided Whether the planning reported a collision
+     * @param[in] lengthsInFront Sum of vehicle lengths in front of the vehicle
+     */
+    void applyCriticalMove(bool collided, SUMOReal lengthsInFront) throw();
 
 
     /// @name state setter/getter
@@ -512,6 +576,15 @@ public:
 
     void setPreDawdleAcceleration(SUMOReal accel) {
         myPreDawdleAcceleration = accel;
+        MSKinematicStore::setPreDawdleAcceleration(mySlot, accel);
+    }
+
+
+    /** @brief Returns the vehicle's slot in the kinematic store
+     * @return The index of this vehicle's values in MSKinematicStore
+     */
+    MSKinematicStore::Slot getKinematicSlot() const throw() {
+        return mySlot;
     }
 
 
@@ -542,6 +615,17 @@ public:
 
     /// Saves the states of a vehicle
     void saveState(std::ostream &os);
+
+
+    /** @brief Loads the microscopic part of the state written by saveState
+     *
+     * Restores the driving state, the occupied strips, the lanes lapped into
+     *  and the links approached within the last step. A vehicle which was on
+     *  a lane enters it again; it is not put into the strips' containers,
+     *  this is done in the saved order by MSLane::loadState.
+     * @param[in] bis The stream to read the state from
+     */
+    void loadState(BinaryInputDevice &bis) throw();
     //@}
 
 
@@ -598,13 +682,17 @@ public:
     
     /// Returns the lanes of all the vehicles strips along with the strip IDs of 
     /// the strips each vehicle occupies for the corresponding lane
-    const std::vector<std::vector<int> > getLanes() const;
+    const std::vector<std::vector<int> > &getLanes() const {
+        return myLaneStripIDs;
+    }
 
     /// Returns the main (owner) strip of the vehicle (the first (leftmost) strip)
     const MSStrip &getMainStrip() const;
     
     /// Returns the main (owner) strip's id (the first (leftmost) strip)?? ACE ??
-    virtual size_t getMainStripNumericalID() const;
+    virtual size_t getMainStripNumericalID() const {
+        return myOccupancy.firstStrip;
+    }
 
 
     /// Returns the left most strip of the vehicle
@@ -614,6 +702,11 @@ public:
     /// lane than the left most strip)
     const MSStrip *getRightStrip() const;
     
+    /** @brief Returns whether the given strip is the vehicle's main strip
+     *
+     * On the main strip's lane, only the main strip itself is; on other lanes
+     *  the strip with the main strip's numerical id is regarded as main strip.
+     */
     bool isMainStrip(const MSStrip &strip) const;
     
     virtual SUMOReal getRealWidth() const;//?? ACE ?? made virtual
@@ -714,6 +807,20 @@ public:
      * @todo Describe better
      */
     const std::vector<MSLane*> &getBestLanesContinuation(const MSLane * const l) const throw();
+
+
+    /** @brief Collects the edges besides the current one a lane change of this vehicle may use
+     *
+     * A lane change reads the occupation of the lanes examined by "getBestLanes",
+     *  which lie on the next edges of the route, and may set or reset the partial
+     *  occupation of lanes on the edges behind the vehicle.
+     *
+     * @param[out] ahead Receives the edges whose occupation may be read
+     * @param[out] behind Receives the edges whose partial occupation may be changed
+     * @return Whether move reminders may be notified when the vehicle changes its lane
+     */
+    bool collectLaneChangeEdges(std::vector<const MSEdge*> &ahead,
+                                std::vector<const MSEdge*> &behind) const throw();
     /// @}
 
 
@@ -937,6 +1044,11 @@ protected:
 
     void checkRewindLinkLanes(SUMOReal lengthsInFront) throw();
 
+    /// @brief Writes the current position and speed to the kinematic store
+    void storeState() throw() {
+        MSKinematicStore::setState(mySlot, myState.myPos, myState.mySpeed);
+    }
+
     /// @name Interaction with move reminders
     ///@{
 
@@ -1027,6 +1139,76 @@ protected:
     // The (integral) number of strips that a vehicle occupies
     size_t myWidth;
 
+    /// @brief Compact description of myStrips
+    StripOccupancy myOccupancy;
+
+    /// @brief The numerical ids of myStrips (cached)
+    std::vector<int> myStripIDs;
+
+    /// @brief The numerical ids of myStrips grouped by lane (cached)
+    std::vector<std::vector<int> > myLaneStripIDs;
+
+    /// @brief Rebuilds myOccupancy, myStripIDs and myLaneStripIDs from myStrips
+    void updateStripOccupancy() throw();
+
+    /// @brief A vehicle's position handle within a strip's vehicle container
+    struct StripPosition {
+        /// @brief The strip storing the vehicle
+        const MSStrip *strip;
+        /// @brief The position handle within the strip's container
+        long pos;
+        /// @brief Whether the strip counts the vehicle as one of its main vehicles
+        bool countedAsMain;
+    };
+
+    /** @brief The position handles in the vehicle containers of the strips the vehicle is stored in
+     *
+     * Maintained by MSStrip; may contain strips the vehicle has already left
+     *  (or not yet entered) by a strip change until the changer swaps the containers.
+     */
+    std::vector<StripPosition> myStripPositions;
+
+
+    /// @name Access to the position handles (for MSStrip)
+    /// @{
+
+    /** @brief Sets (or adds) the position handle within the given strip
+     * @param[in] strip The strip which stores the vehicle
+     * @param[in] pos The vehicle's position handle within this strip
+     */
+    void setStripPosition(const MSStrip *strip, long pos) throw();
+
+
+    /** @brief Returns the position handle within the given strip
+     * @param[in] strip The strip to get the handle for
+     * @param[out] pos The vehicle's position handle within this strip
+     * @return Whether the vehicle is stored in the given strip
+     */
+    bool getStripPosition(const MSStrip *strip, long &pos) const throw();
+
+
+    /** @brief Removes the position handle for the given strip
+     * @param[in] strip The strip which does not store the vehicle anymore
+     */
+    void removeStripPosition(const MSStrip *strip) throw();
+
+
+    /** @brief Sets whether the given strip counts the vehicle as a main vehicle
+     *
+     * The vehicle has to be stored in the strip (to have a position handle there).
+     * @param[in] strip The strip which stores the vehicle
+     * @param[in] counted Whether the strip counts the vehicle
+     */
+    void setCountedAsMain(const MSStrip *strip, bool counted) throw();
+
+
+    /** @brief Returns whether the given strip counts the vehicle as a main vehicle
+     * @param[in] strip The strip to ask for
+     * @return Whether the vehicle is stored in and counted by the given strip
+     */
+    bool isCountedAsMain(const MSStrip *strip) const throw();
+    /// @}
+
 
     MSAbstractLaneChangeModel *myLaneChangeModel;
 
@@ -1049,6 +1231,9 @@ protected:
     /// @brief The current acceleration before dawdling
     SUMOReal myPreDawdleAcceleration;
 
+    /// @brief The vehicle's slot in the kinematic store
+    MSKinematicStore::Slot mySlot;
+
     /// @brief The information into which lanes the vehicle laps into
     std::vector<MSLane*> myFurtherLanes;
 
@@ -1081,6 +1266,9 @@ private:
     /// Container for used Links/visited Lanes during lookForward.
     DriveItemVector myLFLinkLanes;
 
+    /// The links/lanes computed by planCriticalMove, not yet approached
+    DriveItemVector myPlannedLFLinkLanes;
+
 
     /// @name Move reminder structures
     /// @{
@@ -32,6 +32,7 @@
 #include "MSVehicle.h"
 #include "MSGlobals.h"
 #include "MSLane.h"
+#include "MSEmitControl.h"
 #include <microsim/devices/MSDevice.h>
 #include <utils/common/FileHelpers.h>
 #include <utils/common/RGBColor.h>
@@ -261,7 +262,6 @@ MSVehicleControl::vehicleEmitted(const MSVehicle &v) throw() {
 }
 
 
-#ifdef HAVE_MESOSIM
 void
 MSVehicleControl::saveState(std::ostream &os) throw() {
     FileHelpers::writeUInt(os, myRunningVehNo);
@@ -305,32 +305,10 @@ MSVehicleControl::loadState(BinaryInputDevice &bis, const SUMOTime offset) throw
     unsigned int size;
     bis >> size;
     while (size-->0) {
-        SUMOReal r, g, b;
-        SUMOVTypeParameter defType;
-        int vehicleClass, emissionClass, shape;
-
-        bis >> defType.id;
-        bis >> defType.length;
-        bis >> defType.maxSpeed;
-        bis >> vehicleClass;
-        defType.vehicleClass = (SUMOVehicleClass) vehicleClass;
-        bis >> emissionClass;
-        defType.emissionClass = (SUMOEmissionClass) emissionClass;
-        bis >> shape;
-        defType.shape = (SUMOVehicleShape) shape;
-        bis >> defType.width;
-        bis >> defType.offset;
-        bis >> defType.defaultProbability;
-        bis >> defType.speedFactor;
-        bis >> defType.speedDev;
-        bis >> r;
-        bis >> g;
-        bis >> b;
-        defType.color = RGBColor(r,g,b);
-        bis >> defType.cfModel;
-        bis >> defType.lcModel;
-        MSVehicleType *t = MSVehicleType::build(defType);
-        addVType(t);
+        MSVehicleType *t = MSVehicleType::loadState(bis);
+        if (!addVType(t)) {
+            delete t;
+        }
     }
     unsigned int numVTypeDists;
     bis >> numVTypeDists;
@@ -393,6 +371,22 @@ MSVehicleControl::loadState(BinaryInputDevice &bis, const SUMOTime offset) throw
         SUMOTime tLastEntry;
         bis >> tLastEntry;
 #endif
+        int procedure;
+        bis >> procedure;
+        p->departProcedure = (DepartDefinition) procedure;
+        bis >> procedure;
+        p->departLaneProcedure = (DepartLaneDefinition) procedure;
+        bis >> p->departLane;
+        bis >> procedure;
+        p->departPosProcedure = (DepartPosDefinition) procedure;
+        bis >> p->departPos;
+        bis >> procedure;
+        p->departSpeedProcedure = (DepartSpeedDefinition) procedure;
+        bis >> p->departSpeed;
+        bis >> procedure;
+        p->arrivalPosProcedure = (ArrivalPosDefinition) procedure;
+        bis >> p->arrivalPos;
+        bis >> p->setParameter;
         route = MSRoute::dictionary(p->routeid);
         assert(route!=0);
         type = getVType(p->vtypeid);
@@ -400,6 +394,8 @@ MSVehicleControl::loadState(BinaryInputDevice &bis, const SUMOTime offset) throw
         assert(getVehicle(p->id)==0);
 
         MSVehicle *v = buildVehicle(p, route, type);
+        v->myLastLaneChangeOffset = lastLaneChangeOffset;
+        v->myWaitingTime = (SUMOTime) waitingTime;
         if (wasEmitted != -1) {
             v->myIntCORNMap[MSCORN::CORN_VEH_DEPART_TIME] = wasEmitted;
         }
@@ -418,12 +414,14 @@ MSVehicleControl::loadState(BinaryInputDevice &bis, const SUMOTime offset) throw
             v->myLastEntryTime = tLastEntry - offset;
         }
 #endif
+        v->loadState(bis);
         if (!addVehicle(p->id, v)) {
             MsgHandler::getErrorInstance()->inform("Error: Could not build vehicle " + p->id + "!");
+        } else if (wasEmitted == -1) {
+            MSNet::getInstance()->getEmitControl().add(v);
         }
     }
 }
-#endif
 
 
 bool
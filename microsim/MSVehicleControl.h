@@ -330,21 +330,26 @@ public:
     MSVehicle *getWaitingVehicle(const MSEdge* const edge, const std::set<std::string> &lines) throw();
 
 
-#ifdef HAVE_MESOSIM
-    /// @name State I/O (mesosim only)
+    /// @name State I/O
     /// @{
 
-    /** @brief Loads the state of this control from the given stream
-     * @todo Does not work for microsim
+    /** @brief Saves the current state into the given stream
+     *
+     * Writes the statistics, the vehicle types, the routes and all vehicles
+     *  including their microscopic state.
+     * @param[in] os The stream to write the state into
      */
     void saveState(std::ostream &os) throw();
 
-    /** @brief Saves the current state into the given stream
-     * @todo Does not work for microsim
+    /** @brief Loads the state of this control from the given stream
+     *
+     * Vehicles which were not emitted yet are given to the emit control again.
+     *  The vehicles are not put into the lanes, see MSEdgeControl::loadState.
+     * @param[in] bis The stream to read the state from
+     * @param[in] offset The time offset for departures
      */
     void loadState(BinaryInputDevice &bis, const SUMOTime offset) throw();
     /// @}
-#endif
 
 
 private:
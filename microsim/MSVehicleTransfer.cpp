@@ -30,6 +30,8 @@
 #include <iostream>
 #include <cassert>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 #include "MSNet.h"
 #include "MSLane.h"
 #include "MSVehicle.h"
@@ -54,14 +56,14 @@ void
 MSVehicleTransfer::addVeh(MSVehicle *veh) throw() {
     // get the current edge of the vehicle
     MSEdge *e = MSEdge::dictionary(veh->getEdge()->getID());
+    // count the teleport
+    myNoTransfered++;
     // let the vehicle be on the one
     veh->onRemovalFromNet(true);
     if (!veh->hasSuccEdge(1)||proceedVirtualReturnWhetherEnded(*veh, MSEdge::dictionary(veh->succEdge(1)->getID()))) {
         MSNet::getInstance()->getVehicleControl().scheduleVehicleRemoval(veh);
         return;
     }
-    // mark the next one
-    myNoTransfered++;
     // save information
     myVehicles.push_back(VehicleInformation(veh, MSNet::getInstance()->getCurrentTimeStep()));
     MSNet::getInstance()->informVehicleStateListener(veh, MSNet::VEHICLE_STATE_STARTING_TELEPORT);
@@ -130,6 +132,40 @@ MSVehicleTransfer::proceedVirtualReturnWhetherEnded(MSVehicle &veh, const MSEdge
 }
 
 
+void
+MSVehicleTransfer::saveState(std::ostream &os) throw() {
+    FileHelpers::writeUInt(os, myNoTransfered);
+    FileHelpers::writeUInt(os, (unsigned int) myVehicles.size());
+    for (VehicleInfVector::const_iterator i=myVehicles.begin(); i!=myVehicles.end(); ++i) {
+        FileHelpers::writeString(os, (*i).myVeh->getID());
+        FileHelpers::writeTime(os, (*i).myInsertTime);
+        FileHelpers::writeTime(os, (*i).myProceedTime);
+    }
+}
+
+
+void
+MSVehicleTransfer::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    unsigned int size;
+    bis >> myNoTransfered;
+    bis >> size;
+    for (unsigned int i=0; i<size; ++i) {
+        std::string id;
+        SUMOTime insertTime, proceedTime;
+        bis >> id;
+        bis >> insertTime;
+        bis >> proceedTime;
+        MSVehicle *veh = vc.getVehicle(id);
+        if (veh==0) {
+            MsgHandler::getErrorInstance()->inform("Unknown teleporting vehicle '" + id + "' in loaded state.");
+            continue;
+        }
+        myVehicles.push_back(VehicleInformation(veh, insertTime));
+        myVehicles.back().myProceedTime = proceedTime;
+    }
+}
+
+
 MSVehicleTransfer *
 MSVehicleTransfer::getInstance() throw() {
     if (myInstance==0) {
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <vector>
+#include <iostream>
 
 
 // ===========================================================================
@@ -39,6 +40,8 @@
 class MSVehicle;
 class MSEdge;
 class MSStrip;
+class MSVehicleControl;
+class BinaryInputDevice;
 
 // ===========================================================================
 // class definitions
@@ -90,6 +93,31 @@ public:
     static MSVehicleTransfer *getInstance() throw();
 
 
+    /** @brief Returns the number of vehicles teleported so far
+     * @return The number of vehicles given to addVeh
+     */
+    unsigned int getTeleportedVehicleNo() const throw() {
+        return myNoTransfered;
+    }
+
+
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the teleport counter and the currently teleporting vehicles
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Restores the teleport counter and the teleporting vehicles
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     */
+    void loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
+
+
 private:
     /// @brief Constructor
     MSVehicleTransfer() throw();
@@ -138,6 +166,7 @@ protected:
     VehicleInfVector myVehicles;
 
     /// @brief A counter for vehicles that had to be moved virtually
+    /// @brief The number of vehicles given to addVeh
     unsigned int myNoTransfered;
 
     /// @brief The static singleton-instance
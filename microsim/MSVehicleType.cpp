@@ -90,7 +90,53 @@ MSVehicleType::saveState(std::ostream &os) {
     FileHelpers::writeFloat(os, myColor.blue());
     FileHelpers::writeInt(os, myCarFollowModel->getModelID());
     FileHelpers::writeString(os, myLaneChangeModel);
-    //myCarFollowModel->saveState(os);
+    FileHelpers::writeUInt(os, (unsigned int) myStripWidth);
+    FileHelpers::writeUInt(os, (unsigned int) myCFParameter.size());
+    for (std::map<std::string, SUMOReal>::const_iterator i=myCFParameter.begin(); i!=myCFParameter.end(); ++i) {
+        FileHelpers::writeString(os, (*i).first);
+        FileHelpers::writeFloat(os, (*i).second);
+    }
+}
+
+
+MSVehicleType *
+MSVehicleType::loadState(BinaryInputDevice &bis) throw(ProcessError) {
+    SUMOReal r, g, b;
+    SUMOVTypeParameter defType;
+    int vehicleClass, emissionClass, shape;
+    unsigned int stripWidth, parameterNo;
+
+    bis >> defType.id;
+    bis >> defType.length;
+    bis >> defType.maxSpeed;
+    bis >> vehicleClass;
+    defType.vehicleClass = (SUMOVehicleClass) vehicleClass;
+    bis >> emissionClass;
+    defType.emissionClass = (SUMOEmissionClass) emissionClass;
+    bis >> shape;
+    defType.shape = (SUMOVehicleShape) shape;
+    bis >> defType.width;
+    bis >> defType.offset;
+    bis >> defType.defaultProbability;
+    bis >> defType.speedFactor;
+    bis >> defType.speedDev;
+    bis >> r;
+    bis >> g;
+    bis >> b;
+    defType.color = RGBColor(r,g,b);
+    bis >> defType.cfModel;
+    bis >> defType.lcModel;
+    bis >> stripWidth;
+    defType.stripWidth = stripWidth;
+    bis >> parameterNo;
+    while (parameterNo-->0) {
+        std::string name;
+        SUMOReal value;
+        bis >> name;
+        bis >> value;
+        defType.cfParameter[name] = value;
+    }
+    return build(defType);
 }
 
 
@@ -159,6 +205,7 @@ MSVehicleType::build(SUMOVTypeParameter &from) throw(ProcessError) {
         break;
     }
     vtype->myCarFollowModel = model;
+    vtype->myCFParameter = from.cfParameter;
     return vtype;
 }
 
@@ -234,6 +234,14 @@ public:
     void saveState(std::ostream &os);
 
 
+    /** @brief Builds a vehicle type from a record written by saveState
+     * @param[in] bis The input to read the record from
+     * @return The built vehicle type
+     * @exception ProcessError If the type can not be built
+     */
+    static MSVehicleType *loadState(BinaryInputDevice &bis) throw(ProcessError);
+
+
 
     /// @name Static methods for building vehicle types from descriptions
     /// @{
@@ -288,6 +296,9 @@ private:
     /// @brief ID of the lane change model.
     std::string myLaneChangeModel;
 
+    /// @brief The parameter the car following model was built with
+    std::map<std::string, SUMOReal> myCFParameter;
+
     /// @brief The emission class of such vehicles
     SUMOEmissionClass myEmissionClass;
 
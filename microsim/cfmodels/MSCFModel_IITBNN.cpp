@@ -16,106 +16,150 @@
 
 
 #include<iostream>
-extern MSCFModel_IITBNN::UT Units[14]; 
-
-float Weights[] =  {
-	-0.143580, 0.201710, 
-	-0.435920, 1.811630, 
-	-0.018860, -0.903730, 
-	0.490110, -2.272230, 
-	-2.654690, 0.155780, 
-	0.167580, 0.458600, 
-	-0.489070, 0.140120, 
-	1.922750, 0.186400, 
-	6.487300, -1.187110, 
-	1.286700, -2.376440, 
-	-0.167980, 1.874670, -0.755620, -2.110800, -1.562800, 0.388300, 0.228530, 1.012770, 4.334710, -2.079650 
-    };
-
-MSCFModel_IITBNN::UT* Sources[] =  {
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 1, Units + 2, 
-        Units + 3, Units + 4, Units + 5, Units + 6, Units + 7, Units + 8, Units + 9, Units + 10, Units + 11, Units + 12 
-    };
-
-MSCFModel_IITBNN::UT Units[] = 
-{
-	{ 0.0, 0.0, 0, 0, 0},
-	{ /* unit 1 (Old: 1) */
-		0.0, 1.000000, 0,
-		&Sources[0] , 
-		&Weights[0] , 
-	},
-	{ /* unit 2 (Old: 2) */
-		0.0, 0.998030, 0,
-		&Sources[0] , 
-		&Weights[0] , 
-	},
-	{ /* unit 3 (Old: 3) */
-		0.0, 0.554370, 2,
-		&Sources[0] , 
-		&Weights[0] , 
-	},
-	{ /* unit 4 (Old: 4) */
-		0.0, -1.292860, 2,
-		&Sources[2] , 
-		&Weights[2] , 
-	},
-	{ /* unit 5 (Old: 5) */
-		0.0, -0.241650, 2,
-		&Sources[4] , 
-		&Weights[4] , 
-	},
-	{ /* unit 6 (Old: 6) */
-		0.0, 0.668520, 2,
-		&Sources[6] , 
-		&Weights[6] , 
-	},
-	{ /* unit 7 (Old: 7) */
-		0.0, -0.427730, 2,
-		&Sources[8] , 
-		&Weights[8] , 
-	},
-	{ /* unit 8 (Old: 8) */
-		0.0, 0.152550, 2,
-		&Sources[10] , 
-		&Weights[10] , 
-	},
-	{ /* unit 9 (Old: 9) */
-		0.0, -1.159520, 2,
-		&Sources[12] , 
-		&Weights[12] , 
-	},
-	{ /* unit 10 (Old: 10) */
-		0.0, -0.509900, 2,
-		&Sources[14] , 
-		&Weights[14] , 
-	},
-	{ /* unit 11 (Old: 11) */
-		0.0, -1.450040, 2,
-		&Sources[16] , 
-		&Weights[16] , 
-	},
-	{ /* unit 12 (Old: 12) */
-		0.0, 0.018010, 2,
-		&Sources[18] , 
-		&Weights[18] , 
-	},
-	{ /* unit 13 (Old: 13) */
-		0.0, -1.762410, 10,
-		&Sources[20] , 
-		&Weights[20] , 
-	}
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+// ===========================================================================
+// network definition
+// ===========================================================================
+// The network has two inputs (the gap and the scaled leader speed), one
+//  logistic hidden layer and one logistic output (the scaled safe speed).
+//  It is evaluated with local buffers only, so that it may be used by
+//  several threads at once.
+
+/// @brief The number of hidden units
+static const int NN_HIDDEN_UNITS = 10;
+
+/// @brief The weights of the inputs (gap, scaled leader speed) of each hidden unit
+static const float NN_HIDDEN_WEIGHTS[NN_HIDDEN_UNITS][2] = {
+    { -0.143580, 0.201710 },
+    { -0.435920, 1.811630 },
+    { -0.018860, -0.903730 },
+    { 0.490110, -2.272230 },
+    { -2.654690, 0.155780 },
+    { 0.167580, 0.458600 },
+    { -0.489070, 0.140120 },
+    { 1.922750, 0.186400 },
+    { 6.487300, -1.187110 },
+    { 1.286700, -2.376440 }
 };
 
+/// @brief The biases of the hidden units
+static const float NN_HIDDEN_BIASES[NN_HIDDEN_UNITS] = {
+    0.554370, -1.292860, -0.241650, 0.668520, -0.427730,
+    0.152550, -1.159520, -0.509900, -1.450040, 0.018010
+};
+
+/// @brief The weights of the hidden units' activations within the output unit
+static const float NN_OUTPUT_WEIGHTS[NN_HIDDEN_UNITS] = {
+    -0.167980, 1.874670, -0.755620, -2.110800, -1.562800,
+    0.388300, 0.228530, 1.012770, 4.334710, -2.079650
+};
+
+/// @brief The bias of the output unit
+static const float NN_OUTPUT_BIAS = -1.762410;
+
+/// @brief The speed range the network was trained with [m/s]
+static const SUMOReal NN_VMAX = 8.888889;
+static const SUMOReal NN_VMIN = 2.777789;
+
+/// @name Constants of the exponential function's approximation (Cephes' expf)
+/// @{
+static const float NN_EXP_MAX = 88.f;
+static const float NN_EXP_MIN = -88.f;
+static const float NN_LOG2E = 1.44269504088896341f;
+static const float NN_LN2_HI = 0.693359375f;
+static const float NN_LN2_LO = -2.12194440e-4f;
+static const float NN_EXP_P0 = 1.9875691500E-4f;
+static const float NN_EXP_P1 = 1.3981999507E-3f;
+static const float NN_EXP_P2 = 8.3334519073E-3f;
+static const float NN_EXP_P3 = 4.1665795894E-2f;
+static const float NN_EXP_P4 = 1.6666665459E-1f;
+static const float NN_EXP_P5 = 5.0000001201E-1f;
+/// @}
+
+
+// ===========================================================================
+// static method definitions
+// ===========================================================================
+/** @brief Returns exp(x)
+ *
+ * Uses the same operations as nnExp4, so that the single and the batched
+ *  evaluation of the network yield the same results.
+ */
+static inline float
+nnExp(float x) {
+    x = MIN2(MAX2(x, NN_EXP_MIN), NN_EXP_MAX);
+    // split into n*ln(2) + r
+    const float fx = x * NN_LOG2E + 0.5f;
+    float n = (float)(int) fx;
+    if (n > fx) {
+        n -= 1.f;
+    }
+    x = x - n * NN_LN2_HI;
+    x = x - n * NN_LN2_LO;
+    const float z = x * x;
+    float y = NN_EXP_P0;
+    y = y * x + NN_EXP_P1;
+    y = y * x + NN_EXP_P2;
+    y = y * x + NN_EXP_P3;
+    y = y * x + NN_EXP_P4;
+    y = y * x + NN_EXP_P5;
+    y = y * z + x + 1.f;
+    // multiply by 2^n
+    union {
+        int i;
+        float f;
+    } pow2n;
+    pow2n.i = ((int) n + 127) << 23;
+    return y * pow2n.f;
+}
+
+
+/// @brief Returns the logistic activation of a unit
+static inline float
+nnLogistic(float sum, float bias) {
+    const float net = sum + bias;
+    return net < 10000.f ? 1.f / (1.f + nnExp(-net)) : 0.f;
+}
+
+
+#ifdef __SSE2__
+/// @brief Returns exp(x) for four values; see nnExp
+static inline __m128
+nnExp4(__m128 x) {
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(NN_EXP_MIN)), _mm_set1_ps(NN_EXP_MAX));
+    const __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(NN_LOG2E)), _mm_set1_ps(0.5f));
+    __m128 n = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, fx), _mm_set1_ps(1.f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(NN_LN2_HI)));
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(NN_LN2_LO)));
+    const __m128 z = _mm_mul_ps(x, x);
+    __m128 y = _mm_set1_ps(NN_EXP_P0);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(NN_EXP_P1));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(NN_EXP_P2));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(NN_EXP_P3));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(NN_EXP_P4));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(NN_EXP_P5));
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.f));
+    const __m128i pow2n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)), 23);
+    return _mm_mul_ps(y, _mm_castsi128_ps(pow2n));
+}
+
+
+/// @brief Returns the logistic activations of a unit for four inputs; see nnLogistic
+static inline __m128
+nnLogistic4(__m128 sum, float bias) {
+    const __m128 net = _mm_add_ps(sum, _mm_set1_ps(bias));
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 act = _mm_div_ps(one, _mm_add_ps(one, nnExp4(_mm_sub_ps(_mm_setzero_ps(), net))));
+    return _mm_and_ps(_mm_cmplt_ps(net, _mm_set1_ps(10000.f)), act);
+}
+#endif
+
 
 // ===========================================================================
 // method definitions
@@ -171,6 +215,17 @@ MSCFModel_IITBNN::ffeV(const MSVehicle * const veh, const MSVehicle *pred) const
 }
 
 
+void
+MSCFModel_IITBNN::ffeVBatch(const MSVehicle * const *, const SUMOReal *speeds,
+                            const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                            SUMOReal *vSafes, size_t n) const throw() {
+    _vsafeBatch(gaps, predSpeeds, vSafes, n);
+    for (size_t i=0; i<n; ++i) {
+        vSafes[i] = MIN2(vSafes[i], maxNextSpeed(speeds[i]));
+    }
+}
+
+
 SUMOReal
 MSCFModel_IITBNN::ffeS(const MSVehicle * const veh, SUMOReal gap) const throw() {
     return MIN2(_vsafe(gap, 0), maxNextSpeed(veh->getSpeed()));
@@ -229,69 +284,56 @@ SUMOReal MSCFModel_IITBNN::_vsafe(SUMOReal gap, SUMOReal predSpeed) const throw(
     if (predSpeed==0&&gap<0.01) {
         return 0;
     }
-    SUMOReal vsafe=0.0;
-    //Const values of traffic vels seen for this particular model
-    const SUMOReal vMax = 8.888889; 
-    const SUMOReal vMin = 2.777789;
-
-    int member, source;
-    float sum;
-    enum{OK, Error, Not_Valid};
-    UT* unit;
-
-    float in[2], out[1];
-    in[0] = (float)gap;
-    float inputVel = (predSpeed - vMin)/(vMax - vMin);
-    in[1] = inputVel;
-
-    /* layer definition section (names & member units) */
-
-    //static UT* Input[2] = {Units + 1, Units + 2}; /* members */
-
-    static UT* Hidden[10] = {Units + 3, Units + 4, Units + 5, Units + 6, Units + 7, Units + 8, Units + 9, Units + 10, Units + 11, Units + 12}; /* members */
-
-    const int outputIndex = 13;
-    static UT* Output = &Units[outputIndex]; /* members */
-
-
-    // Set the input variables
-    for(member = 0; member < 2; member++) {
-            //Input[member]->act = in[member];
-            unit = &Units[member + 1];
-            //TODO: Change this for SUMO
-            unit->act = in[member];
+    const float inputGap = (float) gap;
+    const float inputVel = (float)((predSpeed - NN_VMIN) / (NN_VMAX - NN_VMIN));
+    float sum = 0;
+    for (int member=0; member<NN_HIDDEN_UNITS; ++member) {
+        const float act = nnLogistic(inputGap * NN_HIDDEN_WEIGHTS[member][0] + inputVel * NN_HIDDEN_WEIGHTS[member][1],
+                                     NN_HIDDEN_BIASES[member]);
+        sum = sum + act * NN_OUTPUT_WEIGHTS[member];
     }
+    SUMOReal vsafe = (NN_VMAX - NN_VMIN) * nnLogistic(sum, NN_OUTPUT_BIAS) + NN_VMIN;
+    assert(vsafe >= 0);
+    return vsafe;
+}
 
-    // Run the major algo
-    for (member = 0; member < 10; member++) {
-            unit = Hidden[member];
-            sum = 0.0;
-            for (source = 0; source < unit->NoOfSources; source++) {
-                    sum += unit->sources[source]->act * unit->weights[source];
+
+void
+MSCFModel_IITBNN::_vsafeBatch(const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                              SUMOReal *vSafes, size_t n) const throw() {
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i+4<=n; i+=4) {
+        float inputGaps[4], inputVels[4], outputs[4];
+        for (size_t j=0; j<4; ++j) {
+            inputGaps[j] = (float) gaps[i+j];
+            inputVels[j] = (float)((predSpeeds[i+j] - NN_VMIN) / (NN_VMAX - NN_VMIN));
+        }
+        const __m128 inputGap = _mm_loadu_ps(inputGaps);
+        const __m128 inputVel = _mm_loadu_ps(inputVels);
+        __m128 sum = _mm_setzero_ps();
+        for (int member=0; member<NN_HIDDEN_UNITS; ++member) {
+            const __m128 act = nnLogistic4(
+                                   _mm_add_ps(_mm_mul_ps(inputGap, _mm_set1_ps(NN_HIDDEN_WEIGHTS[member][0])),
+                                              _mm_mul_ps(inputVel, _mm_set1_ps(NN_HIDDEN_WEIGHTS[member][1]))),
+                                   NN_HIDDEN_BIASES[member]);
+            sum = _mm_add_ps(sum, _mm_mul_ps(act, _mm_set1_ps(NN_OUTPUT_WEIGHTS[member])));
+        }
+        _mm_storeu_ps(outputs, nnLogistic4(sum, NN_OUTPUT_BIAS));
+        for (size_t j=0; j<4; ++j) {
+            if (predSpeeds[i+j]==0&&gaps[i+j]<0.01) {
+                vSafes[i+j] = 0;
+            } else {
+                vSafes[i+j] = (NN_VMAX - NN_VMIN) * outputs[j] + NN_VMIN;
             }
-            unit->act = actLogistic(sum, unit->Bias);
+        }
     }
-
-    // Calculate the output
-    unit = Output;
-    sum = 0.0;
-    for (source = 0; source < unit->NoOfSources; source++) {
-            sum += unit->sources[source]->act * unit->weights[source];
+#endif
+    for (; i<n; ++i) {
+        vSafes[i] = _vsafe(gaps[i], predSpeeds[i]);
     }
-    unit->act = actLogistic(sum, unit->Bias);
-
-    // Give the output
-    // TODO: Change this for SUMO
-    out[0] = Units[outputIndex].act;
-    SUMOReal outVel = (vMax - vMin) * out[0] + vMin;
-    vsafe = outVel;
-
-
-    assert(vsafe >= 0);
-    return vsafe;
 }
 
 
-
 //void MSCFModel::saveState(std::ostream &os) {}
 
@@ -81,6 +81,20 @@ public:
     SUMOReal ffeV(const MSVehicle * const veh, const MSVehicle * const pred) const throw();
 
 
+    /** @brief Computes the safe speeds of several vehicles following a leader (no dawdling)
+     * @param[in] vehs The vehicles (EGO); all use this model
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[out] vSafes The EGOs' safe speeds
+     * @param[in] n The number of vehicles
+     * @see MSCFModel::ffeVBatch
+     */
+    void ffeVBatch(const MSVehicle * const *vehs, const SUMOReal *speeds,
+                   const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                   SUMOReal *vSafes, size_t n) const throw();
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      * @param[in] veh The vehicle (EGO)
      * @param[in] gap2pred The (netto) distance to the the obstacle
@@ -157,15 +171,26 @@ private:
     SUMOReal _vsafe(SUMOReal gap, SUMOReal predSpeed) const throw();
 
 
+    /** @brief Returns the "safe" velocities for several gaps and leader speeds
+     *
+     * Evaluates the network for four pairs at once if SSE2 is available; the
+     *  results are the same as the ones of _vsafe.
+     *
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The LEADERs' speeds
+     * @param[out] vSafes The safe velocities
+     * @param[in] n The number of values
+     */
+    void _vsafeBatch(const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                     SUMOReal *vSafes, size_t n) const throw();
+
+
     /** @brief Applies driver imperfection (dawdling / sigma)
      * @param[in] speed The speed with no dawdling
      * @return The speed after dawdling
      */
     SUMOReal dawdle(SUMOReal speed) const throw();
 
-    float actLogistic(const float sum, const float bias) const {
-        return ( (sum+bias<10000.0) ? ( 1.0/(1.0 + exp(-sum-bias) ) ) : 0.0 );
-    }
 private:
     /// @name model parameter
     /// @{
@@ -183,19 +208,6 @@ private:
     SUMOReal myTauDecel;
     /// @}
 
-public:
-    /// @brief The UnitType used in the Neural Network
-    struct UT {
-        float act;         /* Activation       */
-        float Bias;        /* Bias of the Unit */
-        int   NoOfSources; /* Number of predecessor units */
-        struct UT   **sources; /* predecessor units */
-        float *weights; /* weights from predecessor units */
-    };
-
-//    static const float Weights[30];
-//    static UT*   Sources[30];
-//    static UT    Units[14];
 };
 
 #endif	/* MSCFMODEL_IITBNN_H */
@@ -33,6 +33,12 @@
 #include <microsim/MSAbstractLaneChangeModel.h>
 #include <utils/common/RandHelper.h>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 // ===========================================================================
 // method definitions
@@ -88,6 +94,17 @@ MSCFModel_Krauss::ffeV(const MSVehicle * const veh, const MSVehicle *pred) const
 }
 
 
+void
+MSCFModel_Krauss::ffeVBatch(const MSVehicle * const *, const SUMOReal *speeds,
+                            const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                            SUMOReal *vSafes, size_t n) const throw() {
+    vsafeBatch(myTauDecel, myDecel, gaps, predSpeeds, vSafes, n);
+    for (size_t i=0; i<n; ++i) {
+        vSafes[i] = MIN2(vSafes[i], maxNextSpeed(speeds[i]));
+    }
+}
+
+
 SUMOReal
 MSCFModel_Krauss::ffeS(const MSVehicle * const veh, SUMOReal gap) const throw() {
     return MIN2(_vsafe(gap, 0), maxNextSpeed(veh->getSpeed()));
@@ -137,12 +154,65 @@ MSCFModel_Krauss::dawdle(SUMOReal speed) const throw() {
 }
 
 
+void
+MSCFModel_Krauss::vsafeBatch(SUMOReal tauDecel, SUMOReal decel, const SUMOReal *gaps,
+                             const SUMOReal *predSpeeds, SUMOReal *vSafes, size_t n) throw() {
+    size_t i = 0;
+#if defined(__AVX__) || defined(__SSE2__)
+    const SUMOReal tauDecel2 = tauDecel*tauDecel;
+    const SUMOReal twoDecel = 2. * decel;
+#endif
+#if defined(__AVX__)
+    const size_t blockSize = 4;
+    const __m256d vTauDecel = _mm256_set1_pd(tauDecel);
+    const __m256d vTauDecel2 = _mm256_set1_pd(tauDecel2);
+    const __m256d vTwoDecel = _mm256_set1_pd(twoDecel);
+    const __m256d vZero = _mm256_setzero_pd();
+    const __m256d vMinGap = _mm256_set1_pd(0.01);
+#elif defined(__SSE2__)
+    const size_t blockSize = 2;
+    const __m128d vTauDecel = _mm_set1_pd(tauDecel);
+    const __m128d vTauDecel2 = _mm_set1_pd(tauDecel2);
+    const __m128d vTwoDecel = _mm_set1_pd(twoDecel);
+    const __m128d vZero = _mm_setzero_pd();
+    const __m128d vMinGap = _mm_set1_pd(0.01);
+#endif
+#if defined(__AVX__) || defined(__SSE2__)
+    for (; i+blockSize<=n; i+=blockSize) {
+        const SUMOReal *gap = gaps+i;
+        const SUMOReal *predSpeed = predSpeeds+i;
+        SUMOReal *vSafe = vSafes+i;
+#if defined(__AVX__)
+        const __m256d vGap = _mm256_loadu_pd(gap);
+        const __m256d vPredSpeed = _mm256_loadu_pd(predSpeed);
+        __m256d sum = _mm256_add_pd(vTauDecel2, _mm256_mul_pd(vPredSpeed, vPredSpeed));
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(vTwoDecel, vGap));
+        const __m256d vsafe = _mm256_sub_pd(_mm256_sqrt_pd(sum), vTauDecel);
+        // a standing leader right in front
+        const __m256d stop = _mm256_and_pd(_mm256_cmp_pd(vPredSpeed, vZero, _CMP_EQ_OQ),
+                                           _mm256_cmp_pd(vGap, vMinGap, _CMP_LT_OQ));
+        _mm256_storeu_pd(vSafe, _mm256_andnot_pd(stop, vsafe));
+#elif defined(__SSE2__)
+        const __m128d vGap = _mm_loadu_pd(gap);
+        const __m128d vPredSpeed = _mm_loadu_pd(predSpeed);
+        __m128d sum = _mm_add_pd(vTauDecel2, _mm_mul_pd(vPredSpeed, vPredSpeed));
+        sum = _mm_add_pd(sum, _mm_mul_pd(vTwoDecel, vGap));
+        const __m128d vsafe = _mm_sub_pd(_mm_sqrt_pd(sum), vTauDecel);
+        // a standing leader right in front
+        const __m128d stop = _mm_and_pd(_mm_cmpeq_pd(vPredSpeed, vZero), _mm_cmplt_pd(vGap, vMinGap));
+        _mm_storeu_pd(vSafe, _mm_andnot_pd(stop, vsafe));
+#endif
+    }
+#endif
+    for (; i<n; ++i) {
+        vSafes[i] = vsafe(tauDecel, decel, gaps[i], predSpeeds[i]);
+    }
+}
+
+
 /** Returns the SK-vsafe. */
 SUMOReal MSCFModel_Krauss::_vsafe(SUMOReal gap, SUMOReal predSpeed) const throw() {
-    if (predSpeed==0&&gap<0.01) {
-        return 0;
-    }
-    SUMOReal vsafe = (SUMOReal)(-1. * myTauDecel + sqrt(myTauDecel*myTauDecel + (predSpeed*predSpeed) + (2. * myDecel * gap)));
+    SUMOReal vsafe = MSCFModel_Krauss::vsafe(myTauDecel, myDecel, gap, predSpeed);
     assert(vsafe >= 0);
     return vsafe;
 }
@@ -28,6 +28,7 @@
 #include <config.h>
 #endif
 
+#include <cmath>
 #include <microsim/MSCFModel.h>
 #include <utils/xml/SUMOXMLDefinitions.h>
 
@@ -98,6 +99,20 @@ public:
     SUMOReal ffeV(const MSVehicle * const veh, const MSVehicle * const pred) const throw();
 
 
+    /** @brief Computes the safe speeds of several vehicles following a leader (no dawdling)
+     * @param[in] vehs The vehicles (EGO); all use this model
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[out] vSafes The EGOs' safe speeds
+     * @param[in] n The number of vehicles
+     * @see MSCFModel::ffeVBatch
+     */
+    void ffeVBatch(const MSVehicle * const *vehs, const SUMOReal *speeds,
+                   const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                   SUMOReal *vSafes, size_t n) const throw();
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      * @param[in] veh The vehicle (EGO)
      * @param[in] gap2pred The (netto) distance to the the obstacle
@@ -165,6 +180,40 @@ public:
     /// @}
 
 
+    /** @brief Computes the "safe" velocity of the Krauss models for one vehicle
+     *
+     * The operations are done in the same order as in vsafeBatch; as long as
+     *  the models are compiled without contraction of floating point
+     *  operations (-ffp-contract=off), both return the same values.
+     * @param[in] tauDecel The product of the deceleration and the reaction time
+     * @param[in] decel The deceleration
+     * @param[in] gap The (netto) distance to the LEADER
+     * @param[in] predSpeed The LEADER's speed
+     * @return The safe velocity
+     */
+    static inline SUMOReal vsafe(SUMOReal tauDecel, SUMOReal decel, SUMOReal gap, SUMOReal predSpeed) throw() {
+        if (predSpeed==0&&gap<0.01) {
+            return 0;
+        }
+        return (SUMOReal)(sqrt(tauDecel*tauDecel + (predSpeed*predSpeed) + (2. * decel * gap)) - tauDecel);
+    }
+
+
+    /** @brief Computes the "safe" velocities of the Krauss models for several vehicles
+     *
+     * Uses SSE2 or AVX instructions if available; the last, incomplete block
+     *  is computed by vsafe.
+     * @param[in] tauDecel The product of the deceleration and the reaction time
+     * @param[in] decel The deceleration
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The LEADERs' speeds
+     * @param[out] vSafes The safe velocities
+     * @param[in] n The number of vehicles
+     */
+    static void vsafeBatch(SUMOReal tauDecel, SUMOReal decel, const SUMOReal *gaps,
+                           const SUMOReal *predSpeeds, SUMOReal *vSafes, size_t n) throw();
+
+
 private:
     /** @brief Returns the "safe" velocity
      * @param[in] gap2pred The (netto) distance to the LEADER
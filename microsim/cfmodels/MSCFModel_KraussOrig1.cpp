@@ -30,6 +30,7 @@
 #include <microsim/MSVehicle.h>
 #include <microsim/MSLane.h>
 #include "MSCFModel_KraussOrig1.h"
+#include "MSCFModel_Krauss.h"
 #include <microsim/MSAbstractLaneChangeModel.h>
 #include <utils/common/RandHelper.h>
 
@@ -87,6 +88,17 @@ MSCFModel_KraussOrig1::ffeV(const MSVehicle * const veh, const MSVehicle *pred)
 }
 
 
+void
+MSCFModel_KraussOrig1::ffeVBatch(const MSVehicle * const *, const SUMOReal *speeds,
+                                 const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                                 SUMOReal *vSafes, size_t n) const throw() {
+    MSCFModel_Krauss::vsafeBatch(myTauDecel, myDecel, gaps, predSpeeds, vSafes, n);
+    for (size_t i=0; i<n; ++i) {
+        vSafes[i] = MIN2(vSafes[i], maxNextSpeed(speeds[i]));
+    }
+}
+
+
 SUMOReal
 MSCFModel_KraussOrig1::ffeS(const MSVehicle * const veh, SUMOReal gap) const throw() {
     return MIN2(_vsafe(gap, 0), maxNextSpeed(veh->getSpeed()));
@@ -127,15 +139,7 @@ MSCFModel_KraussOrig1::dawdle(SUMOReal speed) const throw() {
 
 /** Returns the SK-vsafe. */
 SUMOReal MSCFModel_KraussOrig1::_vsafe(SUMOReal gap, SUMOReal predSpeed) const throw() {
-    if (predSpeed==0&&gap<0.01) {
-        return 0;
-    }
-    SUMOReal vsafe = (SUMOReal)(-1. * myTauDecel
-                                + sqrt(
-                                    myTauDecel*myTauDecel
-                                    + (predSpeed*predSpeed)
-                                    + (2. * myDecel * gap)
-                                ));
+    SUMOReal vsafe = MSCFModel_Krauss::vsafe(myTauDecel, myDecel, gap, predSpeed);
     assert(vsafe >= 0);
     return vsafe;
 }
@@ -98,6 +98,20 @@ public:
     SUMOReal ffeV(const MSVehicle * const veh, const MSVehicle * const pred) const throw();
 
 
+    /** @brief Computes the safe speeds of several vehicles following a leader (no dawdling)
+     * @param[in] vehs The vehicles (EGO); all use this model
+     * @param[in] speeds The vehicles' speeds
+     * @param[in] gaps The (netto) distances to the LEADERs
+     * @param[in] predSpeeds The speeds of the LEADERs
+     * @param[out] vSafes The EGOs' safe speeds
+     * @param[in] n The number of vehicles
+     * @see MSCFModel::ffeVBatch
+     */
+    void ffeVBatch(const MSVehicle * const *vehs, const SUMOReal *speeds,
+                   const SUMOReal *gaps, const SUMOReal *predSpeeds,
+                   SUMOReal *vSafes, size_t n) const throw();
+
+
     /** @brief Computes the vehicle's safe speed for approaching a non-moving obstacle (no dawdling)
      * @param[in] veh The vehicle (EGO)
      * @param[in] gap2pred The (netto) distance to the the obstacle
@@ -114,6 +114,18 @@ public:
     virtual void enterLaneAtEmit(MSLane* enteredLane, const MSVehicle::State &state) { }
 
 
+    /** @brief Update of members if the vehicle is put into a lane by loading a state
+     *
+     * The vehicle was already emitted when the state was saved; the default
+     *  treats it as an emission.
+     * @param[in] enteredLane The lane the vehicle enters
+     * @param[in] state The vehicle's loaded state
+     */
+    virtual void enterLaneAtLoadState(MSLane* enteredLane, const MSVehicle::State &state) {
+        enterLaneAtEmit(enteredLane, state);
+    }
+
+
     /** @brief Update of members if vehicle enters a new lane in the laneChange step.
      *
      * @param[in] enteredLane The lane the vehicle enters
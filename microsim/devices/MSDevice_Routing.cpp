@@ -30,9 +30,10 @@
 #include <microsim/MSNet.h>
 #include <microsim/MSLane.h>
 #include <utils/options/OptionsCont.h>
-#include <utils/common/WrappingCommand.h>
+#include <microsim/MSEdgeControl.h>
 #include <utils/common/StaticCommand.h>
-#include <utils/common/DijkstraRouterTT.h>
+#include <utils/common/AStarRouterTT.h>
+#include <utils/common/CHRouter.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -43,11 +44,100 @@
 // static member variables
 // ===========================================================================
 int MSDevice_Routing::myVehicleIndex = 0;
-std::map<const MSEdge*, SUMOReal> MSDevice_Routing::myEdgeEfforts;
+std::vector<SUMOReal> MSDevice_Routing::myEdgeEfforts;
+std::vector<SUMOReal> MSDevice_Routing::myEdgeLengths;
+std::vector<SUMOReal> MSDevice_Routing::myCurrentTravelTimes;
 Command *MSDevice_Routing::myEdgeWeightSettingCommand = 0;
 SUMOReal MSDevice_Routing::myAdaptationWeight;
 SUMOTime MSDevice_Routing::myAdaptationInterval;
 bool MSDevice_Routing::myWithTaz;
+MSDevice_Routing::EdgeEffortsProxi MSDevice_Routing::myEffortsProxi;
+SUMOAbstractRouter<MSEdge, SUMOVehicle> *MSDevice_Routing::myRouter = 0;
+LandmarkLookupTable<MSEdge> *MSDevice_Routing::myLandmarks = 0;
+std::map<std::pair<SUMOVehicleClass, SUMOReal>, MSDevice_Routing::CHRouterType*> MSDevice_Routing::myCHRouters;
+std::multimap<SUMOTime, MSDevice_Routing*> MSDevice_Routing::mySchedule;
+StaticCommand<MSDevice_Routing> *MSDevice_Routing::myRerouteCommand = 0;
+SUMOTime MSDevice_Routing::myNextRerouteTime = -1;
+std::map<MSDevice_Routing::RouteKey, std::vector<const MSEdge*> > MSDevice_Routing::myRouteCache;
+MSDevice_Routing::CachingRouter MSDevice_Routing::myCachingRouter;
+std::vector<std::pair<MSDevice_Routing::RouteKey, const SUMOVehicle*> > MSDevice_Routing::myRequests;
+std::vector<std::vector<const MSEdge*> > MSDevice_Routing::myAnswers;
+std::vector<MSDevice_Routing::RouteSolver*> MSDevice_Routing::mySolvers;
+
+
+// ===========================================================================
+// MSDevice_Routing::RouteKey-methods
+// ===========================================================================
+MSDevice_Routing::RouteKey::RouteKey(const MSEdge *f, const MSEdge *t, const SUMOVehicle &v) throw()
+        : from(f), to(t), vClass(v.getVehicleType().getVehicleClass()), maxSpeed(v.getMaxSpeed()) {}
+
+
+bool
+MSDevice_Routing::RouteKey::operator<(const RouteKey &other) const throw() {
+    if (from!=other.from) {
+        return from->getNumericalID() < other.from->getNumericalID();
+    }
+    if (to!=other.to) {
+        return to->getNumericalID() < other.to->getNumericalID();
+    }
+    if (vClass!=other.vClass) {
+        return vClass < other.vClass;
+    }
+    return maxSpeed < other.maxSpeed;
+}
+
+
+// ===========================================================================
+// MSDevice_Routing::CachingRouter-methods
+// ===========================================================================
+void
+MSDevice_Routing::CachingRouter::compute(const MSEdge *from, const MSEdge *to, const SUMOVehicle * const vehicle,
+        SUMOTime time, std::vector<const MSEdge*> &into) {
+    const RouteKey key(from, to, *vehicle);
+    std::map<RouteKey, std::vector<const MSEdge*> >::const_iterator i = myRouteCache.find(key);
+    if (i==myRouteCache.end()) {
+        std::vector<const MSEdge*> edges;
+        getRouter(*vehicle).compute(from, to, vehicle, time, edges);
+        i = myRouteCache.insert(std::make_pair(key, edges)).first;
+    }
+    into.insert(into.end(), i->second.begin(), i->second.end());
+}
+
+
+SUMOReal
+MSDevice_Routing::CachingRouter::recomputeCosts(const std::vector<const MSEdge*> &edges,
+        const SUMOVehicle * const v, SUMOTime time) throw() {
+    return getRouter(*v).recomputeCosts(edges, v, time);
+}
+
+
+// ===========================================================================
+// MSDevice_Routing::RouteSolver-methods
+// ===========================================================================
+MSDevice_Routing::RouteSolver::RouteSolver() throw()
+        : myBegin(0), myEnd(0) {
+    AStarRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, EdgeEffortsProxi> *router =
+        new AStarRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, EdgeEffortsProxi>(
+        MSEdge::dictSize(), true, &myEffortsProxi, &EdgeEffortsProxi::getEffort, myLandmarks);
+    // missing connections are reported when the vehicle is rerouted
+    router->setReportUnbuild(false);
+    myRouter = router;
+}
+
+
+MSDevice_Routing::RouteSolver::~RouteSolver() throw() {
+    delete myRouter;
+}
+
+
+void
+MSDevice_Routing::RouteSolver::run() throw() {
+    const SUMOTime time = MSNet::getInstance()->getCurrentTimeStep();
+    for (size_t i=myBegin; i<myEnd; ++i) {
+        const RouteKey &key = myRequests[i].first;
+        myRouter->compute(key.from, key.to, myRequests[i].second, time, myAnswers[i]);
+    }
+}
 
 
 // ===========================================================================
@@ -85,9 +175,32 @@ MSDevice_Routing::insertOptions() throw() {
     oc.doRegister("device.routing.with-taz", new Option_Bool(false));
     oc.addDescription("device.routing.with-taz", "Routing", "Use zones (districts) as routing end points");
 
+    oc.doRegister("device.routing.landmarks", new Option_Integer(0));
+    oc.addDescription("device.routing.landmarks", "Routing", "The number of landmarks to direct the route search with (0: none)");
+
+    oc.doRegister("device.routing.algorithm", new Option_String("dijkstra"));
+    oc.addDescription("device.routing.algorithm", "Routing", "Select among routing algorithms ['dijkstra', 'CH']");
+
     myVehicleIndex = 0;
     myEdgeWeightSettingCommand = 0;
     myEdgeEfforts.clear();
+    myEdgeLengths.clear();
+    myCurrentTravelTimes.clear();
+    delete myRouter;
+    myRouter = 0;
+    delete myLandmarks;
+    myLandmarks = 0;
+    for (std::map<std::pair<SUMOVehicleClass, SUMOReal>, CHRouterType*>::iterator i=myCHRouters.begin(); i!=myCHRouters.end(); ++i) {
+        delete i->second;
+    }
+    myCHRouters.clear();
+    mySchedule.clear();
+    myRerouteCommand = 0;
+    myRouteCache.clear();
+    for (std::vector<RouteSolver*>::iterator i=mySolvers.begin(); i!=mySolvers.end(); ++i) {
+        delete *i;
+    }
+    mySolvers.clear();
 }
 
 
@@ -114,9 +227,15 @@ MSDevice_Routing::buildVehicleDevices(MSVehicle &v, std::vector<MSDevice*> &into
         into.push_back(device);
         // initialise edge efforts if not done before
         if (myEdgeEfforts.size()==0) {
+            // edges not within the edge control keep a negative effort and are not weighted
+            myEdgeEfforts.assign(MSEdge::dictSize(), -1);
+            myEdgeLengths.assign(MSEdge::dictSize(), 0);
+            myCurrentTravelTimes.assign(MSEdge::dictSize(), -1);
             const std::vector<MSEdge*> &edges = MSNet::getInstance()->getEdgeControl().getEdges();
             for (std::vector<MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
-                myEdgeEfforts[*i] = (*i)->getCurrentTravelTime();
+                const size_t id = (*i)->getNumericalID();
+                myEdgeEfforts[id] = (*i)->getCurrentTravelTime();
+                myEdgeLengths[id] = (*i)->getLanes()[0]->getLength();
             }
         }
         // make the weights be updated
@@ -149,14 +268,14 @@ MSDevice_Routing::buildVehicleDevices(MSVehicle &v, std::vector<MSDevice*> &into
 MSDevice_Routing::MSDevice_Routing(MSVehicle &holder, const std::string &id,
                                    SUMOTime period, SUMOTime preEmitPeriod) throw()
         : MSDevice(holder, id), myPeriod(period), myPreEmitPeriod(period),
-        myLastPreEmitReroute(-1), myRerouteCommand(0) {
+        myLastPreEmitReroute(-1), myAmScheduled(false) {
 }
 
 
 MSDevice_Routing::~MSDevice_Routing() throw() {
-    // make the rerouting command invalid if there is one
-    if (myRerouteCommand!=0) {
-        myRerouteCommand->deschedule();
+    // remove the device from the schedule if it is within
+    if (myAmScheduled) {
+        mySchedule.erase(myScheduleEntry);
     }
 }
 
@@ -167,9 +286,7 @@ MSDevice_Routing::onTryEmit() {
         const SUMOTime now = MSNet::getInstance()->getCurrentTimeStep();
         if (myLastPreEmitReroute == -1 ||
                 (myPreEmitPeriod > 0 && myLastPreEmitReroute + myPreEmitPeriod <= now)) {
-            DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSDevice_Routing>
-            router(MSEdge::dictSize(), true, this, &MSDevice_Routing::getEffort);
-            myHolder.reroute(MSNet::getInstance()->getCurrentTimeStep(), router, true);
+            myHolder.reroute(MSNet::getInstance()->getCurrentTimeStep(), myCachingRouter, true);
             myLastPreEmitReroute = now;
         }
     }
@@ -179,44 +296,176 @@ MSDevice_Routing::onTryEmit() {
 void
 MSDevice_Routing::enterLaneAtEmit(MSLane*, const MSVehicle::State &) {
     if (myLastPreEmitReroute == -1) {
-        DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSDevice_Routing>
-        router(MSEdge::dictSize(), true, this, &MSDevice_Routing::getEffort);
-        myHolder.reroute(MSNet::getInstance()->getCurrentTimeStep(), router);
+        myHolder.reroute(MSNet::getInstance()->getCurrentTimeStep(), myCachingRouter);
+    }
+    // schedule the repeated rerouting if routing shall be done more often
+    if (myPeriod>0&&!myAmScheduled) {
+        schedule(myPeriod+MSNet::getInstance()->getCurrentTimeStep());
     }
-    // build repetition trigger if routing shall be done more often
-    if (myPeriod>0&&myRerouteCommand==0) {
-        myRerouteCommand = new WrappingCommand< MSDevice_Routing >(this, &MSDevice_Routing::wrappedRerouteCommandExecute);
-        MSNet::getInstance()->getBeginOfTimestepEvents().addEvent(
-            myRerouteCommand, myPeriod+MSNet::getInstance()->getCurrentTimeStep(),
-            MSEventControl::ADAPT_AFTER_EXECUTION);
+}
+
+
+void
+MSDevice_Routing::enterLaneAtLoadState(MSLane* enteredLane, const MSVehicle::State &state) {
+    myLastPreEmitReroute = MSNet::getInstance()->getCurrentTimeStep();
+    enterLaneAtEmit(enteredLane, state);
+}
+
+
+void
+MSDevice_Routing::schedule(SUMOTime time) throw() {
+    if (myRerouteCommand==0 || time<myNextRerouteTime) {
+        // the event can not be moved to an earlier time; replace it
+        if (myRerouteCommand!=0) {
+            myRerouteCommand->deschedule();
+        }
+        myRerouteCommand = new StaticCommand< MSDevice_Routing >(&MSDevice_Routing::processReroutes);
+        myNextRerouteTime = MSNet::getInstance()->getBeginOfTimestepEvents().addEvent(
+                                myRerouteCommand, time, MSEventControl::ADAPT_AFTER_EXECUTION);
     }
+    // devices due at the same time keep the order they were scheduled in
+    myScheduleEntry = mySchedule.insert(mySchedule.upper_bound(time), std::make_pair(time, this));
+    myAmScheduled = true;
 }
 
 
 SUMOTime
-MSDevice_Routing::wrappedRerouteCommandExecute(SUMOTime currentTime) throw(ProcessError) {
-    DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSDevice_Routing>
-    router(MSEdge::dictSize(), true, this, &MSDevice_Routing::getEffort);
-    myHolder.reroute(currentTime, router);
-    return myPeriod;
+MSDevice_Routing::processReroutes(SUMOTime currentTime) throw(ProcessError) {
+    std::vector<MSDevice_Routing*> due;
+    while (!mySchedule.empty() && mySchedule.begin()->first<=currentTime) {
+        due.push_back(mySchedule.begin()->second);
+        due.back()->myAmScheduled = false;
+        mySchedule.erase(mySchedule.begin());
+    }
+    if (!due.empty()) {
+        solve(due, currentTime);
+        // the commit point: the vehicles get their routes one after another
+        for (std::vector<MSDevice_Routing*>::const_iterator i=due.begin(); i!=due.end(); ++i) {
+            (*i)->myHolder.reroute(currentTime, myCachingRouter);
+            (*i)->schedule(currentTime + (*i)->myPeriod);
+        }
+    }
+    if (mySchedule.empty()) {
+        // the next scheduled device builds a new event
+        myRerouteCommand = 0;
+        return 0;
+    }
+    myNextRerouteTime = mySchedule.begin()->first;
+    return myNextRerouteTime - currentTime;
+}
+
+
+void
+MSDevice_Routing::solve(const std::vector<MSDevice_Routing*> &devices, SUMOTime) throw() {
+    WorkerPool * const pool = MSNet::getInstance()->getEdgeControl().getWorkerPool();
+    if (pool==0 || OptionsCont::getOptions().getString("device.routing.algorithm")=="CH") {
+        // the routes are computed when the vehicles are rerouted
+        return;
+    }
+    // collect the distinct queries which are not answered yet
+    std::set<RouteKey> seen;
+    myRequests.clear();
+    for (std::vector<MSDevice_Routing*>::const_iterator i=devices.begin(); i!=devices.end(); ++i) {
+        const MSVehicle &veh = (*i)->myHolder;
+        const RouteKey key(veh.getEdge(), veh.getRoute().getLastEdge(), veh);
+        if (myRouteCache.find(key)==myRouteCache.end() && seen.insert(key).second) {
+            myRequests.push_back(std::make_pair(key, &veh));
+        }
+    }
+    if (myRequests.size()<2) {
+        return;
+    }
+    // the landmarks the solvers use are built with the shared router
+    getRouter(*myRequests[0].second);
+    while (mySolvers.size()<pool->size()) {
+        mySolvers.push_back(new RouteSolver());
+    }
+    myAnswers.assign(myRequests.size(), std::vector<const MSEdge*>());
+    std::vector<WorkerPool::Task*> tasks;
+    for (size_t i=0; i<pool->size(); ++i) {
+        mySolvers[i]->assign(i*myRequests.size()/pool->size(), (i+1)*myRequests.size()/pool->size());
+        tasks.push_back(mySolvers[i]);
+    }
+    pool->execute(tasks);
+    // merge the found routes in the order of the queries
+    for (size_t i=0; i<myRequests.size(); ++i) {
+        if (!myAnswers[i].empty()) {
+            myRouteCache[myRequests[i].first].swap(myAnswers[i]);
+        }
+    }
 }
 
 
 SUMOReal
-MSDevice_Routing::getEffort(const MSEdge * const e, const SUMOVehicle * const v, SUMOReal) const {
-    if (myEdgeEfforts.find(e) != myEdgeEfforts.end()) {
-        return MAX2(myEdgeEfforts.find(e)->second, e->getLanes()[0]->getLength()/v->getMaxSpeed());
+MSDevice_Routing::getEffort(const MSEdge * const e, const SUMOVehicle * const v, SUMOReal) {
+    const size_t id = e->getNumericalID();
+    if (id<myEdgeEfforts.size() && myEdgeEfforts[id]>=0) {
+        return MAX2(myEdgeEfforts[id], myEdgeLengths[id]/v->getMaxSpeed());
     }
     return 0;
 }
 
 
+SUMOAbstractRouter<MSEdge, SUMOVehicle> &
+MSDevice_Routing::getRouter(const SUMOVehicle &v) throw() {
+    if (OptionsCont::getOptions().getString("device.routing.algorithm")=="CH") {
+        const std::pair<SUMOVehicleClass, SUMOReal> key(v.getVehicleType().getVehicleClass(), v.getMaxSpeed());
+        CHRouterType *&router = myCHRouters[key];
+        if (router==0) {
+            router = new CHRouterType(MSEdge::dictSize(), true, &myEffortsProxi, &EdgeEffortsProxi::getEffort);
+        }
+        return *router;
+    }
+    if (myRouter==0) {
+        const int landmarkNo = OptionsCont::getOptions().getInt("device.routing.landmarks");
+        if (landmarkNo>0) {
+            // the efforts are not below the time needed at the edges' maximum speed
+            //  as the mean speeds are not above it
+            std::vector<SUMOReal> lowerBounds(MSEdge::dictSize(), 0);
+            const std::vector<MSEdge*> &edges = MSNet::getInstance()->getEdgeControl().getEdges();
+            for (std::vector<MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
+                const std::vector<MSLane*> &lanes = (*i)->getLanes();
+                if ((*i)->getPurpose()==MSEdge::EDGEFUNCTION_DISTRICT || lanes.empty()) {
+                    continue;
+                }
+                SUMOReal maxSpeed = 0;
+                for (std::vector<MSLane*>::const_iterator j=lanes.begin(); j!=lanes.end(); ++j) {
+                    maxSpeed = MAX2(maxSpeed, (*j)->getMaxSpeed());
+                }
+                if (maxSpeed>0) {
+                    lowerBounds[(*i)->getNumericalID()] = lanes[0]->getLength() / maxSpeed;
+                }
+            }
+            myLandmarks = new LandmarkLookupTable<MSEdge>(MSEdge::dictSize(), lowerBounds, (unsigned int) landmarkNo);
+        }
+        myRouter = new AStarRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, EdgeEffortsProxi>(
+            MSEdge::dictSize(), true, &myEffortsProxi, &EdgeEffortsProxi::getEffort, myLandmarks);
+    }
+    return *myRouter;
+}
+
+
 SUMOTime
 MSDevice_Routing::adaptEdgeEfforts(SUMOTime currentTime) throw(ProcessError) {
-    SUMOReal newWeight = (SUMOReal)(1. - myAdaptationWeight);
+    const SUMOReal newWeight = (SUMOReal)(1. - myAdaptationWeight);
+    const SUMOReal oldWeight = myAdaptationWeight;
+    // collect the current travel times first; edges not within the edge
+    //  control stay at -1 and so keep their negative effort below
     const std::vector<MSEdge*> &edges = MSNet::getInstance()->getEdgeControl().getEdges();
     for (std::vector<MSEdge*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
-        myEdgeEfforts[*i] = myEdgeEfforts[*i] * myAdaptationWeight + (*i)->getCurrentTravelTime() * newWeight;
+        myCurrentTravelTimes[(*i)->getNumericalID()] = (*i)->getCurrentTravelTime();
+    }
+    // then blend all efforts within one loop over the dense arrays
+    const size_t edgeNo = myEdgeEfforts.size();
+    SUMOReal * const efforts = edgeNo>0 ? &myEdgeEfforts[0] : 0;
+    const SUMOReal * const travelTimes = edgeNo>0 ? &myCurrentTravelTimes[0] : 0;
+    for (size_t i=0; i<edgeNo; ++i) {
+        efforts[i] = efforts[i] * oldWeight + travelTimes[i] * newWeight;
+    }
+    // the cached routes are outdated, the hierarchies are rebuilt using the new efforts when needed
+    myRouteCache.clear();
+    for (std::map<std::pair<SUMOVehicleClass, SUMOReal>, CHRouterType*>::iterator i=myCHRouters.begin(); i!=myCHRouters.end(); ++i) {
+        i->second->invalidate();
     }
     return myAdaptationInterval;
 }
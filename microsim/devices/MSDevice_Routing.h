@@ -35,13 +35,17 @@
 #include "MSDevice.h"
 #include <utils/common/SUMOTime.h>
 #include <microsim/MSVehicle.h>
-#include <utils/common/WrappingCommand.h>
+#include <utils/common/SUMOVehicleClass.h>
+#include <utils/common/WorkerPool.h>
 
 
 // ===========================================================================
 // class declarations
 // ===========================================================================
 class MSLane;
+template<class E> class LandmarkLookupTable;
+template<class E, class V, class PF, class EC> class CHRouter;
+template<class T> class StaticCommand;
 
 
 // ===========================================================================
@@ -62,8 +66,27 @@ class MSLane;
  *
  * A device computes a new route for a vehicle as soon as the vehicle is emitted
  *  (within "enterLaneAtEmit") - and, if the given period is larger than 0 - each
- *  x time steps where x is the period. This is triggered by an event that executes
- *  "wrappedRerouteCommandExecute".
+ *  x time steps where x is the period. The periodic reroutings are not triggered
+ *  by one event per device but collected: one event ("processReroutes") takes
+ *  all devices which are due at a step, computes the distinct routes they need,
+ *  in parallel if a worker pool exists, and then replaces the vehicles' routes
+ *  one after another in the order the devices were scheduled in.
+ *
+ * Computed routes are cached by their origin and destination edge and the
+ *  vehicle's class and maximum speed (the efforts depend on these only) until
+ *  the efforts are adapted next, so vehicles sharing the same trip within an
+ *  adaptation interval reuse the route.
+ *
+ * All devices share one router, so the router's edge information is built once
+ *  instead of once per query. If "device.routing.landmarks" is set, the router
+ *  searches using landmark lower bounds (see AStarRouterTT_ByProxi) which are
+ *  derived from the edges' lengths and maximum speeds.
+ *
+ * With "device.routing.algorithm" set to "CH", contraction hierarchies are used
+ *  instead (see CHRouter). As the efforts depend on the vehicle's class and
+ *  maximum speed only, one hierarchy is kept for each combination of both. The
+ *  hierarchies are rebuilt on the first query after the efforts were adapted,
+ *  so this pays off for longer adaptation intervals.
  */
 class MSDevice_Routing : public MSDevice {
 public:
@@ -107,7 +130,6 @@ public:
      *
      * @see MSVehicle::reroute
      * @see MSEventHandler
-     * @see WrappingCommand
      */
     void onTryEmit();
 
@@ -116,17 +138,25 @@ public:
      * A new route is computed by calling the vehicle's "reroute" method, supplying
      *  "getEffort" as the edge effort retrieval method.
      *
-     * If the reroute period is larger than 0, an event is generated and added
-     *  to the list of simulation step begin events which executes
-     *  "wrappedRerouteCommandExecute".
+     * If the reroute period is larger than 0, the device is scheduled for
+     *  the periodic rerouting (see processReroutes).
      *
      * @param[in] enteredLane The lane the vehicle enters
      * @param[in] state The vehicle's state during the emission
      * @see MSVehicle::reroute
-     * @see MSEventHandler
-     * @see WrappingCommand
      */
     void enterLaneAtEmit(MSLane* enteredLane, const MSVehicle::State &state);
+
+
+    /** @brief Rebuilds the repetition trigger for a vehicle put into a lane by loading a state
+     *
+     * The vehicle has been rerouted at its emission already; only the
+     *  repetition trigger is rebuilt.
+     *
+     * @param[in] enteredLane The lane the vehicle enters
+     * @param[in] state The vehicle's loaded state
+     */
+    void enterLaneAtLoadState(MSLane* enteredLane, const MSVehicle::State &state);
     /// @}
 
 
@@ -146,21 +176,43 @@ private:
     ~MSDevice_Routing() throw();
 
 
-    /** @brief Performs rerouting after a period
+    /** @brief Schedules the device's next periodic rerouting
+     * @param[in] time The time to reroute at
+     */
+    void schedule(SUMOTime time) throw();
+
+
+    /** @brief Performs the periodic reroutings which are due
      *
-     * A new route is computed by calling the vehicle's "reroute" method, supplying
-     *  "getEffort" as the edge effort retrieval method.
+     * This method is called from the event handler at the begin of each
+     *  simulation step. The routes of the due devices' vehicles are computed
+     *  first (see solve); the vehicles' "reroute" methods are then called
+     *  using the cache, in the order the devices were scheduled in, and the
+     *  devices are scheduled again.
      *
-     * This method is called from the event handler at the begin of a simulation
-     *  step after the rerouting period is over. The reroute period is returned.
+     * The event is executed only when a device is due; it is removed if no
+     *  device is scheduled anymore and rebuilt by the next call to "schedule".
      *
      * @param[in] currentTime The current simulation time
-     * @return The offset to the next call (the rerouting period "myPeriod")
+     * @return The offset to the time the next device is due, 0 if none is scheduled
      * @see MSVehicle::reroute
      * @see MSEventHandler
-     * @see WrappingCommand
+     * @see StaticCommand
+     */
+    static SUMOTime processReroutes(SUMOTime currentTime) throw(ProcessError);
+
+
+    /** @brief Computes the routes the given devices' vehicles need into the cache
+     *
+     * The distinct routes which are not cached yet are computed within the
+     *  worker pool if one exists, each worker using an own router. Routes
+     *  which could not be found are left to the (serial) rerouting, so the
+     *  warnings are reported as before.
+     *
+     * @param[in] devices The devices to reroute
+     * @param[in] currentTime The current simulation time
      */
-    SUMOTime wrappedRerouteCommandExecute(SUMOTime currentTime) throw(ProcessError);
+    static void solve(const std::vector<MSDevice_Routing*> &devices, SUMOTime currentTime) throw();
 
 
     /** @brief Returns the effort to pass an edge
@@ -177,7 +229,99 @@ private:
      * @return The effort (time to pass in this case) for an edge
      * @see DijkstraRouterTT_ByProxi
      */
-    SUMOReal getEffort(const MSEdge * const e, const SUMOVehicle * const v, SUMOReal t) const;
+    static SUMOReal getEffort(const MSEdge * const e, const SUMOVehicle * const v, SUMOReal t);
+
+
+    /** @brief Returns the router shared by all devices, building it if needed
+     *
+     * If landmarks shall be used, the landmark table is built, too. If
+     *  contraction hierarchies shall be used, the router of the vehicle's
+     *  class and maximum speed is returned.
+     *
+     * @param[in] v The vehicle to route
+     * @return The router to use
+     */
+    static SUMOAbstractRouter<MSEdge, SUMOVehicle> &getRouter(const SUMOVehicle &v) throw();
+
+
+    /**
+     * @struct RouteKey
+     * @brief The query a cached route answers
+     */
+    struct RouteKey {
+        /// @brief Constructor
+        RouteKey(const MSEdge *f, const MSEdge *t, const SUMOVehicle &v) throw();
+        /// @brief Comparison for the cache
+        bool operator<(const RouteKey &other) const throw();
+        /// @brief The origin and the destination
+        const MSEdge *from, *to;
+        /// @brief The vehicle class
+        SUMOVehicleClass vClass;
+        /// @brief The vehicle's maximum speed
+        SUMOReal maxSpeed;
+    };
+
+
+    /**
+     * @class CachingRouter
+     * @brief Answers queries from the route cache, computing missing routes by the shared router
+     */
+    class CachingRouter : public SUMOAbstractRouter<MSEdge, SUMOVehicle> {
+    public:
+        /// @brief Copies the cached route into "into", computing and caching it if needed
+        void compute(const MSEdge *from, const MSEdge *to, const SUMOVehicle * const vehicle,
+                     SUMOTime time, std::vector<const MSEdge*> &into);
+
+        /// @brief Recomputes the costs using the shared router
+        SUMOReal recomputeCosts(const std::vector<const MSEdge*> &edges,
+                                const SUMOVehicle * const v, SUMOTime time) throw();
+    };
+
+
+    /**
+     * @class RouteSolver
+     * @brief Computes a share of a batch's routes within the worker pool
+     */
+    class RouteSolver : public WorkerPool::Task {
+    public:
+        /// @brief Constructor; builds the solver's own router
+        RouteSolver() throw();
+
+        /// @brief Destructor
+        ~RouteSolver() throw();
+
+        /// @brief Computes the routes of the requests within the given range
+        void assign(size_t begin, size_t end) throw() {
+            myBegin = begin;
+            myEnd = end;
+        }
+
+        /// @brief Computes the assigned routes
+        void run() throw();
+
+    private:
+        /// @brief The solver's router
+        SUMOAbstractRouter<MSEdge, SUMOVehicle> *myRouter;
+
+        /// @brief The range of the requests to compute
+        size_t myBegin, myEnd;
+    };
+
+
+    /**
+     * @class EdgeEffortsProxi
+     * @brief The receiver of the shared router's effort retrieval
+     *
+     * The shared router can not be directed to a device, as devices are
+     *  removed with their vehicles; the efforts do not depend on the device anyway.
+     */
+    class EdgeEffortsProxi {
+    public:
+        /// @brief Returns the effort to pass an edge (see MSDevice_Routing::getEffort)
+        SUMOReal getEffort(const MSEdge * const e, const SUMOVehicle * const v, SUMOReal t) const {
+            return MSDevice_Routing::getEffort(e, v, t);
+        }
+    };
 
 
     /// @name Network state adaptation
@@ -211,14 +355,45 @@ private:
     /// @brief A static vehicle index for computing deterministic vehicle fractions
     static int myVehicleIndex;
 
-    /// @brief The (optional) command responsible for rerouting
-    WrappingCommand< MSDevice_Routing >* myRerouteCommand;
+    /// @brief Whether the device is scheduled for a periodic rerouting
+    bool myAmScheduled;
+
+    /// @brief The device's entry within the schedule (if scheduled)
+    std::multimap<SUMOTime, MSDevice_Routing*>::iterator myScheduleEntry;
+
+    /// @brief The devices by the time of their next periodic rerouting
+    static std::multimap<SUMOTime, MSDevice_Routing*> mySchedule;
+
+    /// @brief The command performing the periodic reroutings, 0 if none is scheduled
+    static StaticCommand<MSDevice_Routing>* myRerouteCommand;
+
+    /// @brief The time the command performing the periodic reroutings is executed next
+    static SUMOTime myNextRerouteTime;
+
+    /// @brief The computed routes, valid until the efforts are adapted next
+    static std::map<RouteKey, std::vector<const MSEdge*> > myRouteCache;
+
+    /// @brief The router answering the vehicles' queries from the cache
+    static CachingRouter myCachingRouter;
+
+    /// @brief The queries of the current batch (with a vehicle asking) and their computed routes
+    static std::vector<std::pair<RouteKey, const SUMOVehicle*> > myRequests;
+    static std::vector<std::vector<const MSEdge*> > myAnswers;
+
+    /// @brief The route solvers, one per worker
+    static std::vector<RouteSolver*> mySolvers;
 
     /// @brief The weights adaptation/overwriting command
     static Command* myEdgeWeightSettingCommand;
 
-    /// @brief The container of edge efforts
-    static std::map<const MSEdge*, SUMOReal> myEdgeEfforts;
+    /// @brief The edge efforts by the edges' numerical ids, negative for edges which are not weighted
+    static std::vector<SUMOReal> myEdgeEfforts;
+
+    /// @brief The edge lengths by the edges' numerical ids
+    static std::vector<SUMOReal> myEdgeLengths;
+
+    /// @brief The edges' current travel times by their numerical ids, collected when adapting the efforts
+    static std::vector<SUMOReal> myCurrentTravelTimes;
 
     /// @brief Information which weight prior edge efforts have
     static SUMOReal myAdaptationWeight;
@@ -229,6 +404,24 @@ private:
     /// @brief whether taz shall be used at initial rerouting
     static bool myWithTaz;
 
+    /// @brief The receiver of the shared router's effort retrieval
+    static EdgeEffortsProxi myEffortsProxi;
+
+    /// @brief The router shared by all devices
+    static SUMOAbstractRouter<MSEdge, SUMOVehicle> *myRouter;
+
+    /// @brief The landmark table of the shared router (0 if no landmarks are used)
+    static LandmarkLookupTable<MSEdge> *myLandmarks;
+
+    /// @brief The router type using contraction hierarchies
+    typedef CHRouter<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, EdgeEffortsProxi> CHRouterType;
+
+    /// @brief The routers using contraction hierarchies by vehicle class and maximum speed
+    static std::map<std::pair<SUMOVehicleClass, SUMOReal>, CHRouterType*> myCHRouters;
+
+    friend class CachingRouter;
+    friend class RouteSolver;
+
 
 private:
     /// @brief Invalidated copy constructor.
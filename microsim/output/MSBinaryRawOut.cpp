@@ -0,0 +1,244 @@
+/****************************************************************************/
+/// @file    MSBinaryRawOut.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSBinaryRawOut.cpp $
+///
+// Dumps the complete network state as columnar binary frames
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <deque>
+#include <sstream>
+#include <microsim/MSEdgeControl.h>
+#include <microsim/MSEdge.h>
+#include <microsim/MSLane.h>
+#include <microsim/MSStrip.h>
+#include <microsim/MSVehicle.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/OutputDevice.h>
+#include "MSBinaryRawOut.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const unsigned int MSBinaryRawOut::FORMAT_MAGIC = 0x534e4442;
+const unsigned int MSBinaryRawOut::FORMAT_VERSION = 1;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+MSBinaryRawOut::MSBinaryRawOut(OutputDevice &of, const MSEdgeControl &ec,
+                               unsigned int keyFrameInterval, bool omitEmptyEdges) throw()
+        : myDevice(of), myEdgeControl(ec), myKeyFrameInterval(keyFrameInterval),
+        myFrame(0) {
+    std::ostringstream strm;
+    FileHelpers::writeUInt(strm, FORMAT_MAGIC);
+    FileHelpers::writeUInt(strm, FORMAT_VERSION);
+    FileHelpers::writeByte(strm, omitEmptyEdges ? 1 : 0);
+    FileHelpers::writeUInt(strm, keyFrameInterval);
+    const std::vector<MSEdge*> &edges = ec.getEdges();
+    FileHelpers::writeUInt(strm, (unsigned int) edges.size());
+    for (std::vector<MSEdge*>::const_iterator e=edges.begin(); e!=edges.end(); ++e) {
+        const std::vector<MSLane*> &lanes = (*e)->getLanes();
+        FileHelpers::writeString(strm, (*e)->getID());
+        FileHelpers::writeUInt(strm, (unsigned int) lanes.size());
+        for (std::vector<MSLane*>::const_iterator l=lanes.begin(); l!=lanes.end(); ++l) {
+            FileHelpers::writeUInt(strm, (unsigned int)(*l)->getNumericalID());
+            FileHelpers::writeString(strm, (*l)->getID());
+            FileHelpers::writeUInt(strm, (unsigned int)(*l)->getWidth());
+            for (size_t i=0; i<(*l)->getWidth(); ++i) {
+                FileHelpers::writeString(strm, (*l)->getStrip((int) i)->getID());
+            }
+        }
+    }
+    of << strm.str();
+}
+
+
+MSBinaryRawOut::~MSBinaryRawOut() throw() {}
+
+
+void
+MSBinaryRawOut::write(SUMOTime timestep) throw(IOError) {
+    ++myFrame;
+    collect();
+    // the frame is assembled first as the device writes formatted only
+    std::ostringstream strm;
+    const bool full = myKeyFrameInterval==0 || (myFrame-1)%myKeyFrameInterval==0;
+    FileHelpers::writeByte(strm, full ? FRAME_FULL : FRAME_DELTA);
+    FileHelpers::writeInt(strm, timestep);
+    // the vehicles seen first
+    FileHelpers::writeUInt(strm, (unsigned int) myBindingSlots.size());
+    writeArray(strm, myBindingSlots);
+    for (std::vector<std::string>::const_iterator i=myBindingIDs.begin(); i!=myBindingIDs.end(); ++i) {
+        FileHelpers::writeString(strm, *i);
+    }
+    // the vehicles' positions within the network
+    std::vector<unsigned int> lanes;
+    std::vector<unsigned short> strips;
+    std::vector<unsigned char> widths;
+    lanes.reserve(mySlots.size());
+    strips.reserve(mySlots.size());
+    widths.reserve(mySlots.size());
+    for (std::vector<MSKinematicStore::Slot>::const_iterator i=mySlots.begin(); i!=mySlots.end(); ++i) {
+        lanes.push_back(myLanes[*i]);
+        strips.push_back(myStrips[*i]);
+        widths.push_back(myWidths[*i]);
+    }
+    FileHelpers::writeUInt(strm, (unsigned int) mySlots.size());
+    if (full) {
+        writeArray(strm, mySlots);
+        writeArray(strm, lanes);
+        writeArray(strm, strips);
+        writeArray(strm, widths);
+    } else {
+        writeDelta(strm, lanes, strips, widths);
+    }
+    // the kinematic values, read from the store in slot order
+    const std::vector<SUMOReal> &positions = MSKinematicStore::getPositions();
+    const std::vector<SUMOReal> &speeds = MSKinematicStore::getSpeeds();
+    std::vector<float> values(mySlots.size());
+    for (size_t i=0; i<mySlots.size(); ++i) {
+        values[i] = (float) positions[mySlots[i]];
+    }
+    writeArray(strm, values);
+    for (size_t i=0; i<mySlots.size(); ++i) {
+        values[i] = (float) speeds[mySlots[i]];
+    }
+    writeArray(strm, values);
+    myDevice << strm.str();
+    // keep the rows the next delta frame refers to
+    mySlots.swap(myPreviousSlots);
+    lanes.swap(myPreviousLanes);
+    strips.swap(myPreviousStrips);
+    widths.swap(myPreviousWidths);
+}
+
+
+void
+MSBinaryRawOut::collect() throw() {
+    const size_t slotNumber = MSKinematicStore::size();
+    if (mySeen.size()<slotNumber) {
+        mySeen.resize(slotNumber, 0);
+        myBound.resize(slotNumber, 0);
+        myBoundGeneration.resize(slotNumber, 0);
+        myLanes.resize(slotNumber, 0);
+        myStrips.resize(slotNumber, 0);
+        myWidths.resize(slotNumber, 0);
+    }
+    const std::vector<unsigned int> &generations = MSKinematicStore::getGenerations();
+    myBindingSlots.clear();
+    myBindingIDs.clear();
+    const std::vector<MSEdge*> &edges = myEdgeControl.getEdges();
+    for (std::vector<MSEdge*>::const_iterator e=edges.begin(); e!=edges.end(); ++e) {
+        const std::vector<MSLane*> &lanes = (*e)->getLanes();
+        for (std::vector<MSLane*>::const_iterator l=lanes.begin(); l!=lanes.end(); ++l) {
+            const unsigned int lane = (unsigned int)(*l)->getNumericalID();
+            for (size_t i=0; i<(*l)->getWidth(); ++i) {
+                const MSStrip &strip = *(*l)->getStrip((int) i);
+                const std::deque<MSVehicle*> &vehs = strip.getVehiclesSecure();
+                for (std::deque<MSVehicle*>::const_iterator v=vehs.begin(); v!=vehs.end(); ++v) {
+                    const MSVehicle::StripOccupancy &occupancy = (*v)->getStripOccupancy();
+                    // a vehicle is written once, on its main strip
+                    if (occupancy.mainStrip!=&strip) {
+                        continue;
+                    }
+                    const MSKinematicStore::Slot slot = (*v)->getKinematicSlot();
+                    if (myBoundGeneration[slot]!=generations[slot]) {
+                        myBoundGeneration[slot] = generations[slot];
+                        myBound[slot] = myFrame;
+                        myBindingSlots.push_back(slot);
+                        myBindingIDs.push_back((*v)->getID());
+                    }
+                    mySeen[slot] = myFrame;
+                    myLanes[slot] = lane;
+                    myStrips[slot] = (unsigned short) strip.getNumericalID();
+                    myWidths[slot] = (unsigned char) occupancy.stripNumber;
+                }
+                strip.releaseVehicles();
+            }
+        }
+    }
+    mySlots.clear();
+    for (MSKinematicStore::Slot slot=0; slot<mySeen.size(); ++slot) {
+        if (mySeen[slot]==myFrame) {
+            mySlots.push_back(slot);
+        }
+    }
+}
+
+
+void
+MSBinaryRawOut::writeDelta(std::ostream &strm, const std::vector<unsigned int> &lanes,
+                           const std::vector<unsigned short> &strips,
+                           const std::vector<unsigned char> &widths) throw() {
+    std::vector<MSKinematicStore::Slot> left;
+    std::vector<MSKinematicStore::Slot> entered;
+    std::vector<unsigned int> changed;
+    std::vector<unsigned int> changedLanes;
+    std::vector<unsigned short> changedStrips;
+    std::vector<unsigned char> changedWidths;
+    // both row sets are sorted by the slots
+    size_t j = 0;
+    for (size_t i=0; i<mySlots.size(); ++i) {
+        const MSKinematicStore::Slot slot = mySlots[i];
+        while (j<myPreviousSlots.size()&&myPreviousSlots[j]<slot) {
+            left.push_back(myPreviousSlots[j++]);
+        }
+        bool change = true;
+        if (j<myPreviousSlots.size()&&myPreviousSlots[j]==slot) {
+            change = myBound[slot]==myFrame || myPreviousLanes[j]!=lanes[i]
+                     || myPreviousStrips[j]!=strips[i] || myPreviousWidths[j]!=widths[i];
+            ++j;
+        } else {
+            entered.push_back(slot);
+        }
+        if (change) {
+            changed.push_back((unsigned int) i);
+            changedLanes.push_back(lanes[i]);
+            changedStrips.push_back(strips[i]);
+            changedWidths.push_back(widths[i]);
+        }
+    }
+    left.insert(left.end(), myPreviousSlots.begin()+j, myPreviousSlots.end());
+    FileHelpers::writeUInt(strm, (unsigned int) left.size());
+    writeArray(strm, left);
+    FileHelpers::writeUInt(strm, (unsigned int) entered.size());
+    writeArray(strm, entered);
+    FileHelpers::writeUInt(strm, (unsigned int) changed.size());
+    writeArray(strm, changed);
+    writeArray(strm, changedLanes);
+    writeArray(strm, changedStrips);
+    writeArray(strm, changedWidths);
+}
+
+
+
+/****************************************************************************/
+
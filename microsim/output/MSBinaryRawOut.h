@@ -0,0 +1,226 @@
+/****************************************************************************/
+/// @file    MSBinaryRawOut.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: MSBinaryRawOut.h $
+///
+// Dumps the complete network state as columnar binary frames
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef MSBinaryRawOut_h
+#define MSBinaryRawOut_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/UtilExceptions.h>
+#include <microsim/MSKinematicStore.h>
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class OutputDevice;
+class MSEdgeControl;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class MSBinaryRawOut
+ * @brief Dumps the complete network state as columnar binary frames
+ *
+ * The binary counterpart of MSXMLRawOut for bulk runs. Instead of one
+ *  element per edge, lane, strip and vehicle, each step is written as one
+ *  frame holding the vehicles' values as typed arrays, one array per value.
+ *  The ids are written once: the network's ids in the header, a vehicle's id
+ *  within the first frame it is seen in.
+ *
+ * Vehicles are identified by their MSKinematicStore slot. A slot is bound to
+ *  a vehicle id when the vehicle is first seen and keeps this binding until
+ *  a frame binds it again, as slots are reused by later vehicles.
+ *
+ * All values are written in the machine's byte order; "u32", "u16", "u8"
+ *  and "f32" denote unsigned integers of the given bit width and single
+ *  precision floats, a string is a u32 length followed by the characters.
+ *
+ * Header:
+ * - u32 magic (FORMAT_MAGIC), u32 version (FORMAT_VERSION),
+ * - u8 whether edges without vehicles are omitted (see "dump-empty-edges"),
+ * - u32 the key frame interval (0 if delta encoding is disabled),
+ * - u32 number of edges; per edge: string id, u32 number of lanes; per lane:
+ *  u32 lane index, string id, u32 number of strips, per strip: string id.
+ *
+ * Frame (one per written step, until the end of the file):
+ * - u8 frame type (FRAME_FULL or FRAME_DELTA), i32 time in ms,
+ * - u32 number of new bindings, u32[] their slots, string[] their vehicle ids,
+ * - u32 number of vehicles (n).
+ * - A full frame continues with u32[n] slots (ascending), u32[n] lane indices,
+ *  u16[n] main strip indices within the lane, u8[n] numbers of occupied strips.
+ * - A delta frame refers to the previous frame's rows instead: u32 number and
+ *  u32[] slots of the vehicles which left, u32 number and u32[] slots of the
+ *  vehicles which entered; the rows are the remaining and the entered slots,
+ *  ascending. Then u32 number of changed rows, u32[] their row indices,
+ *  u32[] lane indices, u16[] main strip indices, u8[] numbers of occupied
+ *  strips. Entered and newly bound vehicles are always changed rows, the
+ *  other rows keep the previous frame's values.
+ * - Both continue with f32[n] positions and f32[n] speeds.
+ *
+ * With delta encoding, every key frame interval-th frame is a full frame, so
+ *  a reader may start at any full frame.
+ */
+class MSBinaryRawOut {
+public:
+    /// @brief The types of frames
+    enum FrameType {
+        /// @brief A frame holding all values
+        FRAME_FULL = 1,
+        /// @brief A frame holding the changes to the previous frame
+        FRAME_DELTA = 2
+    };
+
+
+    /** @brief Constructor; writes the header
+     * @param[in] of The output device to write into
+     * @param[in] ec The EdgeControl which holds the edges to write
+     * @param[in] keyFrameInterval Every how many frames a full frame is written (0: always)
+     * @param[in] omitEmptyEdges Whether a converted dump shall not contain edges without vehicles
+     */
+    MSBinaryRawOut(OutputDevice &of, const MSEdgeControl &ec,
+                   unsigned int keyFrameInterval, bool omitEmptyEdges) throw();
+
+
+    /// @brief Destructor
+    ~MSBinaryRawOut() throw();
+
+
+    /** @brief Writes the frame of the current network state
+     * @param[in] timestep The current time step
+     * @exception IOError If an error on writing occurs (!!! not yet implemented)
+     */
+    void write(SUMOTime timestep) throw(IOError);
+
+
+    /// @brief The magic number binary netstate dumps start with ("SNDB")
+    static const unsigned int FORMAT_MAGIC;
+
+    /// @brief The version of the format
+    static const unsigned int FORMAT_VERSION;
+
+
+private:
+    /** @brief Collects the vehicles on the edges into the per-slot values
+     *
+     * Fills mySlots (ascending), myBindingSlots and myBindingIDs.
+     */
+    void collect() throw();
+
+
+    /** @brief Writes the rows of a delta frame
+     * @param[in] strm The stream to write into
+     * @param[in] lanes The lane indices of the current rows
+     * @param[in] strips The main strip indices of the current rows
+     * @param[in] widths The numbers of occupied strips of the current rows
+     */
+    void writeDelta(std::ostream &strm, const std::vector<unsigned int> &lanes,
+                    const std::vector<unsigned short> &strips,
+                    const std::vector<unsigned char> &widths) throw();
+
+
+    /** @brief Writes the values as one array
+     * @param[in] strm The stream to write into
+     * @param[in] values The values to write
+     */
+    template<class T>
+    static void writeArray(std::ostream &strm, const std::vector<T> &values) throw() {
+        if (!values.empty()) {
+            strm.write((const char *) &values[0], (std::streamsize)(values.size()*sizeof(T)));
+        }
+    }
+
+
+private:
+    /// @brief The device written into
+    OutputDevice &myDevice;
+
+    /// @brief The EdgeControl which holds the edges to write
+    const MSEdgeControl &myEdgeControl;
+
+    /// @brief Every how many frames a full frame is written
+    unsigned int myKeyFrameInterval;
+
+    /// @brief The number of the current frame (the first is 1)
+    unsigned int myFrame;
+
+    /// @name Values per slot
+    /// @{
+
+    /// @brief The frame the slot's vehicle was seen in last
+    std::vector<unsigned int> mySeen;
+
+    /// @brief The frame the slot was bound in last
+    std::vector<unsigned int> myBound;
+
+    /// @brief The allocation of the slot the binding belongs to (see MSKinematicStore::getGenerations)
+    std::vector<unsigned int> myBoundGeneration;
+
+    /// @brief The lane index of the slot's vehicle
+    std::vector<unsigned int> myLanes;
+
+    /// @brief The main strip index of the slot's vehicle
+    std::vector<unsigned short> myStrips;
+
+    /// @brief The number of strips the slot's vehicle occupies
+    std::vector<unsigned char> myWidths;
+    /// @}
+
+    /// @brief The slots of the current frame, ascending
+    std::vector<MSKinematicStore::Slot> mySlots;
+
+    /// @brief The slots and vehicle ids bound within the current frame
+    std::vector<MSKinematicStore::Slot> myBindingSlots;
+    std::vector<std::string> myBindingIDs;
+
+    /// @brief The previous frame's rows (slots ascending, lane and strip indices, strip numbers)
+    std::vector<MSKinematicStore::Slot> myPreviousSlots;
+    std::vector<unsigned int> myPreviousLanes;
+    std::vector<unsigned short> myPreviousStrips;
+    std::vector<unsigned char> myPreviousWidths;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    MSBinaryRawOut(const MSBinaryRawOut&);
+
+    /// @brief Invalidated assignment operator.
+    MSBinaryRawOut& operator=(const MSBinaryRawOut&);
+
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
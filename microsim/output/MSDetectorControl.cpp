@@ -37,6 +37,9 @@
 #include <microsim/output/MSMeanData_Harmonoise.h>
 #include <utils/options/OptionsCont.h>
 #include <utils/options/Option.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 
 #ifdef _MESSAGES
 #include <microsim/output/MSMsgInductLoop.h>
@@ -229,6 +232,51 @@ MSDetectorControl::writeOutput(SUMOTime step, bool closing) throw(IOError) {
 }
 
 
+void
+MSDetectorControl::saveState(std::ostream &os) throw() {
+    const std::map<std::string, MSInductLoop*> &loops = myLoops.getMyMap();
+    FileHelpers::writeUInt(os, (unsigned int) loops.size());
+    for (std::map<std::string, MSInductLoop*>::const_iterator i=loops.begin(); i!=loops.end(); ++i) {
+        FileHelpers::writeString(os, (*i).first);
+        (*i).second->saveState(os);
+    }
+    FileHelpers::writeUInt(os, (unsigned int) myLastCalls.size());
+    for (std::map<IntervalsKey, SUMOTime>::const_iterator i=myLastCalls.begin(); i!=myLastCalls.end(); ++i) {
+        FileHelpers::writeTime(os, (*i).first.first);
+        FileHelpers::writeTime(os, (*i).first.second);
+        FileHelpers::writeTime(os, (*i).second);
+    }
+}
+
+
+void
+MSDetectorControl::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    unsigned int size;
+    bis >> size;
+    for (unsigned int i=0; i<size; ++i) {
+        std::string id;
+        bis >> id;
+        MSInductLoop *loop = myLoops.get(id);
+        if (loop==0) {
+            MsgHandler::getErrorInstance()->inform("Unknown e1-detector '" + id + "' in loaded state.");
+            return;
+        }
+        loop->loadState(bis, vc);
+    }
+    bis >> size;
+    for (unsigned int i=0; i<size; ++i) {
+        SUMOTime interval, begin, lastCall;
+        bis >> interval;
+        bis >> begin;
+        bis >> lastCall;
+        IntervalsKey key = std::make_pair(interval, begin);
+        if (myLastCalls.find(key)!=myLastCalls.end()) {
+            myLastCalls[key] = lastCall;
+        }
+    }
+}
+
+
 void
 MSDetectorControl::addDetectorAndInterval(MSDetectorFileOutput* det,
         OutputDevice *device,
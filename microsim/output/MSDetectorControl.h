@@ -51,6 +51,8 @@
 // class declarations
 // ===========================================================================
 class MSMeanData_Harmonoise;
+class MSVehicleControl;
+class BinaryInputDevice;
 
 
 // ===========================================================================
@@ -356,6 +358,26 @@ public:
 
 
 
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the state of the induction loops and the begin of the current output intervals
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Restores the state of the induction loops and the output intervals
+     *
+     * Other detectors start a new aggregation at the loaded time step.
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     */
+    void loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
+
+
+
     /** @brief Computes detector values
      *
      * Some detectors need to be touched each time step in order to compute
@@ -44,10 +44,13 @@
 #include <utils/common/ToString.h>
 #include <microsim/MSEventControl.h>
 #include <microsim/MSLane.h>
+#include <microsim/MSVehicleControl.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/UtilExceptions.h>
 #include <utils/common/StringUtils.h>
 #include <utils/iodevices/OutputDevice.h>
+#include <utils/iodevices/BinaryInputDevice.h>
+#include <utils/common/FileHelpers.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -414,6 +417,90 @@ MSInductLoop::removeOnTripEnd(MSVehicle *veh) throw() {
 }
 
 
+void
+MSInductLoop::saveState(std::ostream &os) throw() {
+    FileHelpers::writeUInt(os, myStripCount);
+    FileHelpers::writeUInt(os, myDismissedVehicleNumber);
+    for (unsigned int i=0; i<myStripCount; ++i) {
+        FileHelpers::writeFloat(os, myLastLeaveTime[i]);
+        FileHelpers::writeFloat(os, myLastOccupancy[i]);
+        FileHelpers::writeString(os, myCurrentVehicle[i]!=0 ? myCurrentVehicle[i]->getID() : "");
+        saveVehicleData(os, myVehicleDataCont[i]);
+        saveVehicleData(os, myLastVehicleDataCont[i]);
+        FileHelpers::writeUInt(os, (unsigned int) myVehiclesOnDet[i].size());
+        for (VehicleMap::const_iterator j=myVehiclesOnDet[i].begin(); j!=myVehiclesOnDet[i].end(); ++j) {
+            FileHelpers::writeString(os, (*j).first->getID());
+            FileHelpers::writeFloat(os, (*j).second);
+        }
+    }
+}
+
+
+void
+MSInductLoop::loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw() {
+    unsigned int stripCount;
+    bis >> stripCount;
+    if (stripCount!=myStripCount) {
+        MsgHandler::getErrorInstance()->inform("The state of e1-detector '" + getID() + "' does not match its lane.");
+        return;
+    }
+    bis >> myDismissedVehicleNumber;
+    for (unsigned int i=0; i<myStripCount; ++i) {
+        std::string id;
+        bis >> myLastLeaveTime[i];
+        bis >> myLastOccupancy[i];
+        bis >> id;
+        myCurrentVehicle[i] = id!="" ? vc.getVehicle(id) : 0;
+        loadVehicleData(bis, myVehicleDataCont[i]);
+        loadVehicleData(bis, myLastVehicleDataCont[i]);
+        unsigned int size;
+        bis >> size;
+        myVehiclesOnDet[i].clear();
+        for (unsigned int j=0; j<size; ++j) {
+            SUMOReal entryTime;
+            bis >> id;
+            bis >> entryTime;
+            MSVehicle *veh = vc.getVehicle(id);
+            if (veh==0) {
+                MsgHandler::getErrorInstance()->inform("Unknown vehicle '" + id + "' on e1-detector '" + getID() + "' in loaded state.");
+                continue;
+            }
+            myVehiclesOnDet[i][veh] = entryTime;
+            veh->quitRemindedEntered(this);
+        }
+    }
+}
+
+
+void
+MSInductLoop::saveVehicleData(std::ostream &os, const VehicleDataCont &data) throw() {
+    FileHelpers::writeUInt(os, (unsigned int) data.size());
+    for (VehicleDataCont::const_iterator i=data.begin(); i!=data.end(); ++i) {
+        FileHelpers::writeString(os, (*i).idM);
+        FileHelpers::writeFloat(os, (*i).lengthM);
+        FileHelpers::writeFloat(os, (*i).entryTimeM);
+        FileHelpers::writeFloat(os, (*i).leaveTimeM);
+    }
+}
+
+
+void
+MSInductLoop::loadVehicleData(BinaryInputDevice &bis, VehicleDataCont &data) throw() {
+    unsigned int size;
+    bis >> size;
+    data.clear();
+    for (unsigned int i=0; i<size; ++i) {
+        std::string id;
+        SUMOReal length, entryTime, leaveTime;
+        bis >> id;
+        bis >> length;
+        bis >> entryTime;
+        bis >> leaveTime;
+        data.push_back(VehicleData(id, length, entryTime, leaveTime));
+    }
+}
+
+
 std::vector<MSInductLoop::VehicleData>
 MSInductLoop::collectVehiclesOnDet(SUMOTime tMS) const throw() {
     SUMOReal t = STEPS2TIME(tMS);
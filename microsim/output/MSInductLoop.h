@@ -55,6 +55,8 @@ class MSLane;
 class GUIDetectorWrapper;
 class GUIGlObjectStorage;
 class GUILaneWrapper;
+class MSVehicleControl;
+class BinaryInputDevice;
 
 
 // ===========================================================================
@@ -270,6 +272,27 @@ public:
     /// @}
 
 
+
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the collected data and the vehicles on the detector
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Restores the collected data and the vehicles on the detector
+     *
+     * The vehicles must have been loaded before; vehicles on the detector
+     *  are told to remind it on leaving the simulation.
+     * @param[in] bis The stream to read the state from
+     * @param[in] vc The vehicle control which knows the vehicles
+     */
+    void loadState(BinaryInputDevice &bis, const MSVehicleControl &vc) throw();
+    /// @}
+
+
 protected:
     /// @name Methods that add and remove vehicles from internal container
     /// @{
@@ -381,6 +404,12 @@ protected:
     /// @brief Type of myVehicleDataCont.
     typedef std::deque< VehicleData > VehicleDataCont;
 
+    /// @brief Writes the given vehicle data into the state
+    static void saveVehicleData(std::ostream &os, const VehicleDataCont &data) throw();
+
+    /// @brief Reads vehicle data from the state
+    static void loadVehicleData(BinaryInputDevice &bis, VehicleDataCont &data) throw();
+
     /// @brief Data of vehicles that have completely passed the detector
     std::vector<VehicleDataCont> myVehicleDataCont;
 
@@ -37,6 +37,8 @@
 #include <utils/common/TplConvert.h>
 #include <utils/common/ToString.h>
 #include <utils/common/MsgHandler.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/iodevices/BinaryInputDevice.h>
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -874,6 +876,43 @@ MSTLLogicControl::getPhaseDef(const std::string &tlid) const {
 }
 
 
+void
+MSTLLogicControl::saveState(std::ostream &os) throw() {
+    FileHelpers::writeUInt(os, (unsigned int) myLogics.size());
+    for (std::map<std::string, TLSLogicVariants*>::const_iterator i=myLogics.begin(); i!=myLogics.end(); ++i) {
+        MSTrafficLightLogic *tl = (*i).second->getActive();
+        FileHelpers::writeString(os, (*i).first);
+        FileHelpers::writeString(os, tl->getProgramID());
+        FileHelpers::writeUInt(os, tl->getCurrentPhaseIndex());
+        FileHelpers::writeTime(os, tl->getNextSwitchTime());
+    }
+}
+
+
+void
+MSTLLogicControl::loadState(BinaryInputDevice &bis, SUMOTime step) throw() {
+    unsigned int size;
+    bis >> size;
+    for (unsigned int i=0; i<size; ++i) {
+        std::string id, programID;
+        unsigned int index;
+        SUMOTime nextSwitch;
+        bis >> id;
+        bis >> programID;
+        bis >> index;
+        bis >> nextSwitch;
+        if (myLogics.find(id)==myLogics.end() || !switchTo(id, programID)) {
+            MsgHandler::getWarningInstance()->inform("Could not restore program '" + programID + "' of tls '" + id + "' from the loaded state.");
+            continue;
+        }
+        MSTrafficLightLogic *tl = getActive(id);
+        if (nextSwitch>=step && index<tl->getPhaseNumber()) {
+            tl->changeStepAndDuration(*this, step, index, nextSwitch-step);
+        }
+    }
+}
+
+
 
 /****************************************************************************/
 
@@ -31,12 +31,19 @@
 
 #include <vector>
 #include <map>
+#include <iostream>
 #include "MSTrafficLightLogic.h"
 #include "MSSimpleTrafficLightLogic.h"
 #include <utils/common/Command.h>
 #include <utils/common/UtilExceptions.h>
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class BinaryInputDevice;
+
+
 // ===========================================================================
 // class definitions
 // ===========================================================================
@@ -336,6 +343,25 @@ public:
     std::pair<SUMOTime, MSPhaseDefinition> getPhaseDef(const std::string &tlid) const;
 
 
+    /// @name state io
+    /// @{
+
+    /** @brief Writes the active program, the phase and the next switch time of each tls
+     * @param[in] os The stream to write the state into
+     */
+    void saveState(std::ostream &os) throw();
+
+
+    /** @brief Switches the tls to the loaded programs and phases
+     *
+     * The switch commands are rescheduled to the saved switch times.
+     * @param[in] bis The stream to read the state from
+     * @param[in] step The current (loaded) simulation step
+     */
+    void loadState(BinaryInputDevice &bis, SUMOTime step) throw();
+    /// @}
+
+
 protected:
     /**
      * @class SwitchInitCommand
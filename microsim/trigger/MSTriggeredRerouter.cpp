@@ -89,7 +89,8 @@ MSTriggeredRerouter::MSTriggeredRerouter(const std::string &id,
         const std::vector<MSEdge*> &edges,
         SUMOReal prob, const std::string &file, bool off)
         : MSTrigger(id), SUMOSAXHandler(file),
-        myProbability(prob), myUserProbability(prob), myAmInUserMode(false) {
+        myProbability(prob), myUserProbability(prob), myRouter(0), myWeightsProxi(0),
+        myAmInUserMode(false) {
     // read in the trigger description
     if (!XMLSubSys::runParser(*this, file)) {
         throw ProcessError();
@@ -126,6 +127,8 @@ MSTriggeredRerouter::~MSTriggeredRerouter() throw() {
             delete *i;
         }
     }
+    delete myRouter;
+    delete myWeightsProxi;
 }
 
 // ------------ loading begin
@@ -314,12 +317,14 @@ MSTriggeredRerouter::reroute(SUMOVehicle &veh, const MSEdge &src) {
     }
 
     // we have a new destination, let's replace the vehicle route
-    MSEdgeWeightsStorage empty;
-    MSNet::EdgeWeightsProxi proxi(empty, MSNet::getInstance()->getWeightsStorage());
-    DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSNet::EdgeWeightsProxi> router(MSEdge::dictSize(), true, &proxi, &MSNet::EdgeWeightsProxi::getTravelTime);
-    router.prohibit(rerouteDef.closed);
+    if (myRouter==0) {
+        // the router keeps its edge information between the reroutings
+        myWeightsProxi = new MSNet::EdgeWeightsProxi(myEmptyWeights, MSNet::getInstance()->getWeightsStorage());
+        myRouter = new Router(MSEdge::dictSize(), true, myWeightsProxi, &MSNet::EdgeWeightsProxi::getTravelTime);
+    }
+    myRouter->prohibit(rerouteDef.closed);
     std::vector<const MSEdge*> edges;
-    router.compute(&src, newEdge, &veh, MSNet::getInstance()->getCurrentTimeStep(), edges);
+    myRouter->compute(&src, newEdge, &veh, MSNet::getInstance()->getCurrentTimeStep(), edges);
     veh.replaceRoute(edges, MSNet::getInstance()->getCurrentTimeStep());
 }
 
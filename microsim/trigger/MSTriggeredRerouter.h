@@ -36,6 +36,9 @@
 #include "MSTrigger.h"
 #include <utils/xml/SUMOSAXHandler.h>
 #include <utils/common/RandomDistributor.h>
+#include <utils/common/DijkstraRouterTT.h>
+#include <microsim/MSNet.h>
+#include <microsim/MSEdgeWeightsStorage.h>
 
 
 // ===========================================================================
@@ -230,6 +233,18 @@ protected:
     /// The probability and the user-given probability
     SUMOReal myProbability, myUserProbability;
 
+    /// @brief The router type used for computing new routes
+    typedef DijkstraRouterTT_ByProxi<MSEdge, SUMOVehicle, prohibited_withRestrictions<MSEdge, SUMOVehicle>, MSNet::EdgeWeightsProxi> Router;
+
+    /// @brief The router used for all reroutings (built on first use)
+    Router *myRouter;
+
+    /// @brief Empty vehicle knowledge for the weights proxi
+    MSEdgeWeightsStorage myEmptyWeights;
+
+    /// @brief The weights proxi the router uses (built on first use)
+    MSNet::EdgeWeightsProxi *myWeightsProxi;
+
     /// Information whether the current rerouting probability is the user-given
     bool myAmInUserMode;
 
@@ -46,6 +46,7 @@
 #include <microsim/MSVehicleTransfer.h>
 #include <microsim/MSRouteLoaderControl.h>
 #include <microsim/MSRouteLoader.h>
+#include <microsim/MSBinaryRouteLoader.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StringTokenizer.h>
 #include <utils/options/Option.h>
@@ -55,6 +56,7 @@
 #include <utils/common/SysUtils.h>
 #include <utils/common/ToString.h>
 #include <utils/xml/XMLSubSys.h>
+#include <utils/xml/SAXBinaryCache.h>
 #include <microsim/output/MSDetectorControl.h>
 #include <microsim/MSFrame.h>
 #include <microsim/MSEdgeWeightsStorage.h>
@@ -99,6 +101,29 @@ NLBuilder::EdgeFloatTimeLineRetriever_EdgeTravelTime::addEdgeWeight(const std::s
 }
 
 
+// ---------------------------------------------------------------------------
+// NLBuilder::ScenarioFork - methods
+// ---------------------------------------------------------------------------
+void
+NLBuilder::ScenarioFork::loadAdditional(MSNet &net, const std::string &file) throw(ProcessError) {
+    NLEdgeControlBuilder eb;
+    NLDetectorBuilder db(net);
+    NLJunctionControlBuilder jb(net, OptionsCont::getOptions());
+    // let the programs be added to the running network's tls control
+    delete jb.buildTLLogics();
+    NLGeomShapeBuilder sb(net);
+    NLTriggerBuilder tb;
+    NLHandler handler(file, net, db, tb, eb, jb, sb);
+    tb.setHandler(&handler);
+    MsgHandler::getMessageInstance()->beginProcessMsg("Loading variant from '" + file + "' ...");
+    long before = SysUtils::getCurrentMillis();
+    if (!XMLSubSys::runParser(handler, file)) {
+        throw ProcessError("Could not load the variant '" + file + "'.");
+    }
+    MsgHandler::getMessageInstance()->endProcessMsg(" done (" + toString(SysUtils::getCurrentMillis()-before) + "ms).");
+}
+
+
 // ---------------------------------------------------------------------------
 // NLBuilder - methods
 // ---------------------------------------------------------------------------
@@ -123,29 +148,6 @@ NLBuilder::build() throw(ProcessError) {
         return false;
     }
     buildNet();
-#ifdef HAVE_MESOSIM
-    // load the previous state if wished
-    if (myOptions.isSet("load-state")) {
-        long before = SysUtils::getCurrentMillis();
-        BinaryInputDevice strm(myOptions.getString("load-state"));
-        if (!strm.good()) {
-            MsgHandler::getErrorInstance()->inform("Could not read state from '" + myOptions.getString("load-state") + "'!");
-        } else {
-            MsgHandler::getMessageInstance()->beginProcessMsg("Loading state from '" + myOptions.getString("load-state") + "'...");
-            unsigned int step = myNet.loadState(strm);
-            if (myOptions.isDefault("begin")) {
-                myOptions.set("begin", time2string(step));
-            }
-            if (step != string2time(myOptions.getString("begin"))) {
-                WRITE_WARNING("State was written at a different time " + time2string(step) + " than the begin time " + myOptions.getString("begin") + "!");
-            }
-        }
-        if (MsgHandler::getErrorInstance()->wasInformed()) {
-            return false;
-        }
-        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(SysUtils::getCurrentMillis()-before) + "ms).");
-    }
-#endif
     // load weights if wished
     if (myOptions.isSet("weight-files")) {
         if (!myOptions.isUsableFileList("weight-files")) {
@@ -179,8 +181,9 @@ NLBuilder::build() throw(ProcessError) {
             }
         }
     }
-    // load routes
-    if (myOptions.isSet("route-files")&&myOptions.getInt("route-steps")<=0) {
+    // load routes (after the state if one is loaded, the vehicles saved therein are kept)
+    const bool loadRoutes = myOptions.isSet("route-files")&&myOptions.getInt("route-steps")<=0;
+    if (loadRoutes&&!myOptions.isSet("load-state")) {
         if (!load("route-files")) {
             return false;
         }
@@ -191,6 +194,36 @@ NLBuilder::build() throw(ProcessError) {
             return false;
         }
     }
+    // load the previous state if wished; detectors have to be known by now
+    if (myOptions.isSet("load-state")) {
+        long before = SysUtils::getCurrentMillis();
+        BinaryInputDevice strm(myOptions.getString("load-state"));
+        if (!strm.good()) {
+            MsgHandler::getErrorInstance()->inform("Could not read state from '" + myOptions.getString("load-state") + "'!");
+        } else {
+            MsgHandler::getMessageInstance()->beginProcessMsg("Loading state from '" + myOptions.getString("load-state") + "'...");
+            unsigned int step = myNet.loadState(strm);
+            if (myOptions.isDefault("begin")) {
+                myOptions.set("begin", time2string(step));
+            }
+            if (step != string2time(myOptions.getString("begin"))) {
+                WRITE_WARNING("State was written at a different time " + time2string(step) + " than the begin time " + myOptions.getString("begin") + "!");
+            }
+        }
+        if (MsgHandler::getErrorInstance()->wasInformed()) {
+            return false;
+        }
+        MsgHandler::getMessageInstance()->endProcessMsg("done (" + toString(SysUtils::getCurrentMillis()-before) + "ms).");
+        if (loadRoutes&&!load("route-files")) {
+            return false;
+        }
+    }
+    // prepare forking variants if wished
+    if (myOptions.isSet("fork.variants")) {
+        myNet.setScenarioFork(new ScenarioFork(string2time(myOptions.getString("fork.time")),
+                                               myOptions.getStringVector("fork.variants"),
+                                               myOptions.getString("fork.output-prefix")));
+    }
     WRITE_MESSAGE("Loading done.");
     return true;
 }
@@ -211,7 +244,6 @@ NLBuilder::buildNet() throw(ProcessError) {
         MSFrame::buildStreams();
         std::vector<SUMOTime> stateDumpTimes;
         std::vector<std::string> stateDumpFiles;
-#ifdef HAVE_MESOSIM
         const std::vector<int> times = myOptions.getIntVector("save-state.times");
         for (std::vector<int>::const_iterator i = times.begin(); i != times.end(); ++i) {
             stateDumpTimes.push_back(TIME2STEPS(*i));
@@ -224,7 +256,6 @@ NLBuilder::buildNet() throw(ProcessError) {
         } else {
             stateDumpFiles = StringTokenizer(myOptions.getString("save-state.files")).getVector() ;
         }
-#endif
         myNet.closeBuilding(edges, junctions, routeLoaders, tlc, stateDumpTimes, stateDumpFiles);
     } catch (IOError &e) {
         delete edges;
@@ -248,12 +279,20 @@ NLBuilder::load(const std::string &mmlWhat) {
         return false;
     }
     std::vector<std::string> files = OptionsCont::getOptions().getStringVector(mmlWhat);
+    const bool useCache = mmlWhat=="net-file" && OptionsCont::getOptions().getBool("net-cache");
     for (std::vector<std::string>::const_iterator fileIt=files.begin(); fileIt!=files.end(); ++fileIt) {
+        if (mmlWhat=="route-files" && MSBinaryRouteLoader::isBinary(*fileIt)) {
+            // binary demand files are always loaded step-wise
+            continue;
+        }
         if (!gSuppressMessages) {
             MsgHandler::getMessageInstance()->beginProcessMsg("Loading " + mmlWhat + " from '" + *fileIt + "' ...");
         }
         long before = SysUtils::getCurrentMillis();
-        if (!XMLSubSys::runParser(myXMLHandler, *fileIt)) {
+        const bool ok = useCache
+                        ? SAXBinaryCache::runParser(myXMLHandler, *fileIt, *fileIt + ".bin")
+                        : XMLSubSys::runParser(myXMLHandler, *fileIt);
+        if (!ok) {
             WRITE_MESSAGE("Loading of " + mmlWhat + " failed.");
             return false;
         }
@@ -270,16 +309,20 @@ NLBuilder::buildRouteLoaderControl(const OptionsCont &oc) throw(ProcessError) {
     // build the loaders
     MSRouteLoaderControl::LoaderVector loaders;
     // check whether a list is existing
-    if (oc.isSet("route-files")&&oc.getInt("route-steps")>0) {
+    if (oc.isSet("route-files")) {
         std::vector<std::string> files = oc.getStringVector("route-files");
         for (std::vector<std::string>::const_iterator fileIt=files.begin(); fileIt!=files.end(); ++fileIt) {
             if (!FileHelpers::exists(*fileIt)) {
                 throw ProcessError("The route file '" + *fileIt + "' does not exist.");
             }
         }
-        // open files for reading
+        // open files for reading; XML files were loaded completely if route-steps<=0
         for (std::vector<std::string>::const_iterator fileIt=files.begin(); fileIt!=files.end(); ++fileIt) {
-            loaders.push_back(new MSRouteLoader(myNet, new MSRouteHandler(*fileIt, false)));
+            if (MSBinaryRouteLoader::isBinary(*fileIt)) {
+                loaders.push_back(new MSBinaryRouteLoader(*fileIt));
+            } else if (oc.getInt("route-steps")>0) {
+                loaders.push_back(new MSRouteLoader(myNet, new MSRouteHandler(*fileIt, false)));
+            }
         }
     }
     // build the route control
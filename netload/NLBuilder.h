@@ -34,6 +34,7 @@
 #include <vector>
 #include <utils/xml/SAXWeightsHandler.h>
 #include <microsim/MSNet.h>
+#include <microsim/MSScenarioFork.h>
 #include "NLGeomShapeBuilder.h"
 
 
@@ -198,6 +199,37 @@ protected:
     };
 
 
+    /**
+     * @class ScenarioFork
+     * @brief Forks scenario variants, loading additional files with new builders
+     * @see MSScenarioFork
+     */
+    class ScenarioFork : public MSScenarioFork {
+    public:
+        /// @brief Constructor
+        ScenarioFork(SUMOTime time, const std::vector<std::string> &variants,
+                     const std::string &outputPrefix) throw()
+                : MSScenarioFork(time, variants, outputPrefix) {}
+
+        /// @brief Destructor
+        ~ScenarioFork() throw() { }
+
+    protected:
+        /** @brief Loads the given additional file into the running network
+         *
+         * Traffic light programs defined therein are added to the network's
+         *  tls control.
+         *
+         * @param[in] net The running network
+         * @param[in] file The file to load
+         * @exception ProcessError If the file could not be loaded
+         * @see MSScenarioFork::loadAdditional
+         */
+        void loadAdditional(MSNet &net, const std::string &file) throw(ProcessError);
+
+    };
+
+
 protected:
     /// @brief The options to get the names of the files to load and further information from
     OptionsCont &myOptions;
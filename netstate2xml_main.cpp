@@ -0,0 +1,493 @@
+/****************************************************************************/
+/// @file    netstate2xml_main.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: netstate2xml_main.cpp $
+///
+// Main for the conversion of binary netstate dumps into XML
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#ifdef HAVE_VERSION_H
+#include <version.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <microsim/output/MSBinaryRawOut.h>
+#include <utils/options/Option.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/options/OptionsIO.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/SystemFrame.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/ToString.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/xml/XMLSubSys.h>
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class NetstateConverter
+ * @brief Reads a binary netstate dump and writes it as XML netstate dump
+ *
+ * The file format is described at MSBinaryRawOut. The written XML has the
+ *  structure MSXMLRawOut writes; each vehicle is listed within its main strip
+ *  only, ordered by its position. Positions and speeds are stored with single
+ *  precision.
+ */
+class NetstateConverter {
+public:
+    /** @brief Constructor; reads the header
+     * @param[in] file The binary netstate dump to read
+     * @exception ProcessError If the file is not a binary netstate dump
+     */
+    NetstateConverter(const std::string &file) throw(ProcessError)
+            : myFile(file), myStrm(file.c_str(), std::ios::in|std::ios::binary), myFrames(0), myTime(0) {
+        if (readUInt()!=MSBinaryRawOut::FORMAT_MAGIC || readUInt()!=MSBinaryRawOut::FORMAT_VERSION) {
+            throw ProcessError("'" + file + "' is not a binary netstate dump of version " + toString(MSBinaryRawOut::FORMAT_VERSION) + ".");
+        }
+        myOmitEmptyEdges = readByte()!=0;
+        // the key frame interval is not needed as the frames are read in order
+        readUInt();
+        unsigned int edgeNo = readUInt();
+        myEdges.reserve(edgeNo);
+        while (edgeNo-->0) {
+            Edge edge;
+            edge.id = readString();
+            unsigned int laneNo = readUInt();
+            while (laneNo-->0) {
+                const unsigned int index = readUInt();
+                if (index>=myLanes.size()) {
+                    myLanes.resize(index+1);
+                }
+                myLanes[index].id = readString();
+                unsigned int stripNo = readUInt();
+                while (stripNo-->0) {
+                    myLanes[index].strips.push_back(readString());
+                }
+                edge.lanes.push_back(index);
+            }
+            myEdges.push_back(edge);
+        }
+    }
+
+
+    /** @brief Converts all frames
+     * @param[in] into The device to write the XML into
+     * @exception ProcessError If the file is corrupt
+     */
+    void convert(OutputDevice &into) throw(ProcessError) {
+        while (myStrm.peek()!=EOF) {
+            readFrame();
+            writeFrame(into);
+            ++myFrames;
+        }
+    }
+
+
+    /// @brief Returns the number of converted frames
+    unsigned int getFrameNumber() const throw() {
+        return myFrames;
+    }
+
+
+private:
+    /// @brief A lane and the ids of its strips
+    struct Lane {
+        std::string id;
+        std::vector<std::string> strips;
+    };
+
+    /// @brief An edge and the indices of its lanes
+    struct Edge {
+        std::string id;
+        std::vector<unsigned int> lanes;
+    };
+
+
+    /// @brief Orders rows by their lane, strip and position
+    class row_by_place {
+    public:
+        /// @brief Constructor
+        explicit row_by_place(const NetstateConverter &c) : myConverter(c) {}
+
+        /// @brief Comparing operator
+        bool operator()(unsigned int r1, unsigned int r2) const {
+            const NetstateConverter &c = myConverter;
+            if (c.myRowLanes[r1]!=c.myRowLanes[r2]) {
+                return c.myRowLanes[r1] < c.myRowLanes[r2];
+            }
+            if (c.myRowStrips[r1]!=c.myRowStrips[r2]) {
+                return c.myRowStrips[r1] < c.myRowStrips[r2];
+            }
+            return c.myPositions[r1] < c.myPositions[r2];
+        }
+
+    private:
+        /// @brief The converter holding the rows
+        const NetstateConverter &myConverter;
+    };
+    friend class row_by_place;
+
+
+    /// @brief Reads the next frame into the rows
+    void readFrame() throw(ProcessError) {
+        const unsigned char type = readByte();
+        myTime = readInt();
+        // the new bindings of slots to vehicle ids
+        std::vector<unsigned int> bound;
+        readArray(bound, readUInt());
+        for (std::vector<unsigned int>::const_iterator i=bound.begin(); i!=bound.end(); ++i) {
+            if (*i>=myIDs.size()) {
+                myIDs.resize(*i+1);
+            }
+            myIDs[*i] = readString();
+        }
+        const unsigned int rowNo = readUInt();
+        if (type==MSBinaryRawOut::FRAME_FULL) {
+            readArray(mySlots, rowNo);
+            readArray(myRowLanes, rowNo);
+            readArray(myRowStrips, rowNo);
+            readArray(myRowWidths, rowNo);
+        } else if (type==MSBinaryRawOut::FRAME_DELTA) {
+            if (myFrames==0) {
+                corrupt();
+            }
+            readDelta(rowNo);
+        } else {
+            corrupt();
+        }
+        readArray(myPositions, rowNo);
+        readArray(mySpeeds, rowNo);
+        for (size_t i=0; i<rowNo; ++i) {
+            if (mySlots[i]>=myIDs.size()||myRowLanes[i]>=myLanes.size()
+                    ||myRowStrips[i]>=myLanes[myRowLanes[i]].strips.size()) {
+                corrupt();
+            }
+        }
+    }
+
+
+    /** @brief Applies a delta frame's changes to the previous frame's rows
+     * @param[in] rowNo The number of rows of the frame
+     */
+    void readDelta(unsigned int rowNo) throw(ProcessError) {
+        std::vector<unsigned int> left;
+        std::vector<unsigned int> entered;
+        readArray(left, readUInt());
+        readArray(entered, readUInt());
+        // rebuild the rows: the previous rows without the left ones, merged with the entered ones
+        std::vector<unsigned int> slots;
+        std::vector<unsigned int> lanes;
+        std::vector<unsigned short> strips;
+        std::vector<unsigned char> widths;
+        size_t l = 0;
+        size_t e = 0;
+        for (size_t i=0; i<=mySlots.size(); ++i) {
+            const bool previous = i<mySlots.size();
+            while (e<entered.size()&&(!previous||entered[e]<mySlots[i])) {
+                slots.push_back(entered[e++]);
+                lanes.push_back(0);
+                strips.push_back(0);
+                widths.push_back(0);
+            }
+            if (!previous) {
+                break;
+            }
+            if (l<left.size()&&left[l]==mySlots[i]) {
+                ++l;
+                continue;
+            }
+            slots.push_back(mySlots[i]);
+            lanes.push_back(myRowLanes[i]);
+            strips.push_back(myRowStrips[i]);
+            widths.push_back(myRowWidths[i]);
+        }
+        if (slots.size()!=rowNo||l!=left.size()) {
+            corrupt();
+        }
+        // the changed rows
+        std::vector<unsigned int> changed;
+        std::vector<unsigned int> changedLanes;
+        std::vector<unsigned short> changedStrips;
+        std::vector<unsigned char> changedWidths;
+        const unsigned int changedNo = readUInt();
+        readArray(changed, changedNo);
+        readArray(changedLanes, changedNo);
+        readArray(changedStrips, changedNo);
+        readArray(changedWidths, changedNo);
+        for (size_t i=0; i<changedNo; ++i) {
+            if (changed[i]>=rowNo) {
+                corrupt();
+            }
+            lanes[changed[i]] = changedLanes[i];
+            strips[changed[i]] = changedStrips[i];
+            widths[changed[i]] = changedWidths[i];
+        }
+        mySlots.swap(slots);
+        myRowLanes.swap(lanes);
+        myRowStrips.swap(strips);
+        myRowWidths.swap(widths);
+    }
+
+
+    /** @brief Writes the current rows as XML timestep
+     * @param[in] into The device to write into
+     */
+    void writeFrame(OutputDevice &into) throw() {
+        // order the rows as the strips hold their vehicles
+        std::vector<unsigned int> order(mySlots.size());
+        for (unsigned int i=0; i<order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), row_by_place(*this));
+        std::vector<std::pair<size_t, size_t> > laneRows(myLanes.size(), std::make_pair((size_t) 0, (size_t) 0));
+        for (size_t i=0; i<order.size();) {
+            const unsigned int lane = myRowLanes[order[i]];
+            const size_t begin = i;
+            while (i<order.size()&&myRowLanes[order[i]]==lane) {
+                ++i;
+            }
+            laneRows[lane] = std::make_pair(begin, i);
+        }
+        into.openTag("timestep") << " time=\"" << time2string(myTime) << "\">\n";
+        for (std::vector<Edge>::const_iterator e=myEdges.begin(); e!=myEdges.end(); ++e) {
+            bool dump = !myOmitEmptyEdges;
+            for (std::vector<unsigned int>::const_iterator l=(*e).lanes.begin(); !dump&&l!=(*e).lanes.end(); ++l) {
+                dump = laneRows[*l].first!=laneRows[*l].second;
+            }
+            if (!dump) {
+                continue;
+            }
+            into.openTag("edge") << " id=\"" << (*e).id << "\">\n";
+            for (std::vector<unsigned int>::const_iterator l=(*e).lanes.begin(); l!=(*e).lanes.end(); ++l) {
+                const Lane &lane = myLanes[*l];
+                size_t row = laneRows[*l].first;
+                into.openTag("lane") << " id=\"" << lane.id << "\">\n";
+                for (unsigned short s=0; s<lane.strips.size(); ++s) {
+                    into.openTag("strip") << " id=\"" << lane.strips[s] << "\"";
+                    const bool empty = row==laneRows[*l].second||myRowStrips[order[row]]!=s;
+                    if (!empty) {
+                        into << ">\n";
+                    }
+                    for (; row<laneRows[*l].second&&myRowStrips[order[row]]==s; ++row) {
+                        const unsigned int r = order[row];
+                        into.openTag("vehicle") << " id=\"" << myIDs[mySlots[r]] << "\" pos=\""
+                        << (SUMOReal) myPositions[r] << "\" speed=\"" << (SUMOReal) mySpeeds[r] << "\"";
+                        into.closeTag(true);
+                    }
+                    into.closeTag(empty);
+                }
+                into.closeTag();
+            }
+            into.closeTag();
+        }
+        into.closeTag();
+    }
+
+
+    /// @name reading of values
+    /// @{
+
+    /// @brief Reads the given number of values
+    template<class T>
+    void readArray(std::vector<T> &into, unsigned int size) throw(ProcessError) {
+        into.resize(size);
+        if (size!=0) {
+            myStrm.read((char *) &into[0], (std::streamsize)(size*sizeof(T)));
+            if (!myStrm.good()) {
+                corrupt();
+            }
+        }
+    }
+
+    /// @brief Reads an unsigned integer
+    unsigned int readUInt() throw(ProcessError) {
+        unsigned int value = 0;
+        myStrm.read((char *) &value, sizeof(value));
+        if (!myStrm.good()) {
+            corrupt();
+        }
+        return value;
+    }
+
+    /// @brief Reads an integer
+    int readInt() throw(ProcessError) {
+        return (int) readUInt();
+    }
+
+    /// @brief Reads a byte
+    unsigned char readByte() throw(ProcessError) {
+        unsigned char value = 0;
+        myStrm.read((char *) &value, sizeof(value));
+        if (!myStrm.good()) {
+            corrupt();
+        }
+        return value;
+    }
+
+    /// @brief Reads a string
+    std::string readString() throw(ProcessError) {
+        std::vector<char> value;
+        readArray(value, readUInt());
+        return std::string(value.begin(), value.end());
+    }
+    /// @}
+
+
+    /// @brief Throws the error reporting a corrupt file
+    void corrupt() const throw(ProcessError) {
+        throw ProcessError("The binary netstate dump '" + myFile + "' is corrupt (frame " + toString(myFrames) + ").");
+    }
+
+
+private:
+    /// @brief The read file
+    const std::string myFile;
+
+    /// @brief The stream to read from
+    std::ifstream myStrm;
+
+    /// @brief Whether edges without vehicles are omitted
+    bool myOmitEmptyEdges;
+
+    /// @brief The edges in the order they are written
+    std::vector<Edge> myEdges;
+
+    /// @brief The lanes by their index
+    std::vector<Lane> myLanes;
+
+    /// @brief The vehicle ids by the slots they are bound to
+    std::vector<std::string> myIDs;
+
+    /// @brief The number of read frames
+    unsigned int myFrames;
+
+    /// @brief The current frame's time
+    SUMOTime myTime;
+
+    /// @name The current frame's rows
+    /// @{
+    std::vector<unsigned int> mySlots;
+    std::vector<unsigned int> myRowLanes;
+    std::vector<unsigned short> myRowStrips;
+    std::vector<unsigned char> myRowWidths;
+    std::vector<float> myPositions;
+    std::vector<float> mySpeeds;
+    /// @}
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    NetstateConverter(const NetstateConverter &src);
+
+    /// @brief Invalidated assignment operator.
+    NetstateConverter &operator=(const NetstateConverter &src);
+
+};
+
+
+// ===========================================================================
+// functions
+// ===========================================================================
+/// @brief Registers the converter's options
+void
+fillOptions(OptionsCont &oc) {
+    oc.addCallExample("-i netstate.bin -o netstate.xml");
+    SystemFrame::addConfigurationOptions(oc);
+    oc.addOptionSubTopic("Input");
+    oc.addOptionSubTopic("Output");
+
+    oc.doRegister("input-file", 'i', new Option_FileName());
+    oc.addDescription("input-file", "Input", "Convert the binary netstate dump FILE");
+
+    oc.doRegister("output-file", 'o', new Option_FileName());
+    oc.addDescription("output-file", "Output", "Write the netstate dump as XML into FILE");
+
+    SystemFrame::addReportOptions(oc);
+}
+
+
+/* -------------------------------------------------------------------------
+ * main
+ * ----------------------------------------------------------------------- */
+int
+main(int argc, char **argv) {
+    OptionsCont &oc = OptionsCont::getOptions();
+    // give some application descriptions
+    oc.setApplicationDescription("Converts binary netstate dumps into XML.");
+#ifdef WIN32
+    oc.setApplicationName("netstate2xml.exe", "SUMO netstate2xml Version " + (std::string)VERSION_STRING);
+#else
+    oc.setApplicationName("netstate2xml", "SUMO netstate2xml Version " + (std::string)VERSION_STRING);
+#endif
+    int ret = 0;
+    try {
+        // initialise subsystems
+        XMLSubSys::init(false);
+        fillOptions(oc);
+        OptionsIO::getOptions(true, argc, argv);
+        if (oc.processMetaOptions(argc < 2)) {
+            SystemFrame::close();
+            return 0;
+        }
+        MsgHandler::initOutputOptions();
+        if (!oc.isSet("input-file")||!oc.isSet("output-file")) {
+            throw ProcessError("Both, the input file and the output file must be given.");
+        }
+        NetstateConverter converter(oc.getString("input-file"));
+        OutputDevice &into = OutputDevice::getDevice(oc.getString("output-file"));
+        into.writeXMLHeader("sumo-netstate");
+        converter.convert(into);
+        WRITE_MESSAGE("Converted " + toString(converter.getFrameNumber()) + " frames.");
+    } catch (ProcessError &e) {
+        if (std::string(e.what())!=std::string("Process Error") && std::string(e.what())!=std::string("")) {
+            MsgHandler::getErrorInstance()->inform(e.what());
+        }
+        MsgHandler::getErrorInstance()->inform("Quitting (on error).", false);
+        ret = 1;
+#ifndef _DEBUG
+    } catch (std::exception &e) {
+        MsgHandler::getErrorInstance()->inform("Quitting (on unknown error).", false);
+        ret = 1;
+#endif
+    }
+    SystemFrame::close();
+    OutputDevice::closeAll();
+    return ret;
+}
+
+
+
+/****************************************************************************/
+
@@ -0,0 +1,555 @@
+/****************************************************************************/
+/// @file    route2bin_main.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: route2bin_main.cpp $
+///
+// Main for the conversion of XML route files into binary demand files
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#ifdef HAVE_VERSION_H
+#include <version.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <algorithm>
+#include <sstream>
+#include <fstream>
+#include <microsim/MSBinaryRouteLoader.h>
+#include <utils/options/Option.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/options/OptionsIO.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/StdDefs.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/SystemFrame.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/common/StringTokenizer.h>
+#include <utils/common/TplConvert.h>
+#include <utils/common/ToString.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/RGBColor.h>
+#include <utils/common/SUMOVehicleParameter.h>
+#include <utils/xml/SUMOSAXHandler.h>
+#include <utils/xml/SUMOSAXAttributes.h>
+#include <utils/xml/SUMOVehicleParserHelper.h>
+#include <utils/xml/SAXBinaryCache.h>
+#include <utils/xml/XMLSubSys.h>
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class DemandConverter
+ * @brief Collects the demand of XML route files and writes it as binary demand file
+ *
+ * The top-level vehicle types, routes and distributions are recorded as
+ *  they are (see SAXBinaryCache) and replayed by MSBinaryRouteLoader. The
+ *  vehicles and flows are parsed into SUMOVehicleParameter records; their
+ *  embedded routes are converted into edge indices, equal routes are
+ *  stored once.
+ *
+ * Stops, persons and trips can not be converted.
+ */
+class DemandConverter : public SUMOSAXHandler {
+public:
+    /// @brief Constructor
+    DemandConverter() throw()
+            : myDepth(0), myAmRecording(false), myRecorder(myDefinitions),
+            myVehicleParameter(0), myIsFlow(false), myHaveRoute(false) {}
+
+
+    /// @brief Destructor
+    ~DemandConverter() throw() {
+        delete myVehicleParameter;
+    }
+
+
+    /// @brief Starts recording if a top-level definition begins
+    void startElement(const XMLCh* const uri, const XMLCh* const localname,
+                      const XMLCh* const qname, const Attributes& attrs) {
+        const std::string name = TplConvert<XMLCh>::_2str(qname);
+        if (name=="include"||name=="xi:include") {
+            throw ProcessError("Included files can not be converted, convert them separately.");
+        }
+        ++myDepth;
+        if (myDepth==2&&(name=="vtype"||name=="vtypeDistribution"||name=="route"||name=="routeDistribution")) {
+            myAmRecording = true;
+            setRecorder(&myRecorder);
+        }
+        SUMOSAXHandler::startElement(uri, localname, qname, attrs);
+    }
+
+
+    /// @brief Stops recording if a top-level definition ends
+    void endElement(const XMLCh* const uri, const XMLCh* const localname,
+                    const XMLCh* const qname) {
+        SUMOSAXHandler::endElement(uri, localname, qname);
+        if (myDepth==2&&myAmRecording) {
+            myAmRecording = false;
+            setRecorder(0);
+        }
+        --myDepth;
+    }
+
+
+    /** @brief Writes the binary demand file
+     * @param[in] strm The stream to write into
+     * @param[in] chunkSize The number of vehicles per chunk
+     */
+    void write(std::ostream &strm, unsigned int chunkSize) throw() {
+        FileHelpers::writeUInt(strm, MSBinaryRouteLoader::FORMAT_MAGIC);
+        FileHelpers::writeUInt(strm, MSBinaryRouteLoader::FORMAT_VERSION);
+        FileHelpers::writeUInt(strm, (unsigned int) myEdges.size());
+        for (std::vector<std::string>::const_iterator i=myEdges.begin(); i!=myEdges.end(); ++i) {
+            FileHelpers::writeString(strm, *i);
+        }
+        FileHelpers::writeUInt(strm, (unsigned int) myTypes.size());
+        for (std::vector<std::string>::const_iterator i=myTypes.begin(); i!=myTypes.end(); ++i) {
+            FileHelpers::writeString(strm, *i);
+        }
+        FileHelpers::writeUInt(strm, (unsigned int) myRoutes.size());
+        for (std::vector<Route>::const_iterator i=myRoutes.begin(); i!=myRoutes.end(); ++i) {
+            FileHelpers::writeString(strm, (*i).id);
+            FileHelpers::writeByte(strm, (*i).shared);
+            FileHelpers::writeFloat(strm, (*i).color.red());
+            FileHelpers::writeFloat(strm, (*i).color.green());
+            FileHelpers::writeFloat(strm, (*i).color.blue());
+            FileHelpers::writeUInt(strm, (unsigned int) (*i).edges.size());
+            for (std::vector<unsigned int>::const_iterator j=(*i).edges.begin(); j!=(*i).edges.end(); ++j) {
+                FileHelpers::writeUInt(strm, *j);
+            }
+        }
+        myRecorder.recordEndOfFile();
+        FileHelpers::writeString(strm, myDefinitions.str());
+        // the vehicles sorted by their departure
+        std::stable_sort(myVehicles.begin(), myVehicles.end(), departsBefore);
+        for (size_t i=0; i<myVehicles.size(); i+=chunkSize) {
+            const size_t end = MIN2(i+chunkSize, myVehicles.size());
+            FileHelpers::writeUInt(strm, (unsigned int)(end-i));
+            for (size_t j=i; j<end; ++j) {
+                strm << myVehicles[j].second;
+            }
+        }
+        FileHelpers::writeUInt(strm, 0);
+    }
+
+
+    /// @brief Returns the number of converted vehicles and flows
+    size_t getVehicleNumber() const throw() {
+        return myVehicles.size();
+    }
+
+
+    /// @brief Returns the number of distinct routes
+    size_t getRouteNumber() const throw() {
+        return myRoutes.size();
+    }
+
+
+protected:
+    /// @name inherited from GenericSAXHandler
+    //@{
+
+    /// @brief Parses vehicles, flows and their embedded routes
+    void myStartElement(SumoXMLTag element, const SUMOSAXAttributes &attrs) throw(ProcessError) {
+        if (myAmRecording) {
+            return;
+        }
+        bool ok = true;
+        switch (element) {
+        case SUMO_TAG_VEHICLE:
+            delete myVehicleParameter;
+            myVehicleParameter = SUMOVehicleParserHelper::parseVehicleAttributes(attrs);
+            myIsFlow = false;
+            myHaveRoute = false;
+            myRouteEdges.clear();
+            break;
+        case SUMO_TAG_FLOW:
+            delete myVehicleParameter;
+            myVehicleParameter = SUMOVehicleParserHelper::parseFlowAttributes(attrs);
+            myIsFlow = true;
+            myHaveRoute = false;
+            myRouteEdges.clear();
+            if (attrs.hasAttribute(SUMO_ATTR_FROM) && attrs.hasAttribute(SUMO_ATTR_TO)) {
+                addEdges(attrs.getStringReporting(SUMO_ATTR_FROM, "flow", myVehicleParameter->id.c_str(), ok));
+                addEdges(attrs.getStringReporting(SUMO_ATTR_TO, "flow", myVehicleParameter->id.c_str(), ok));
+                myRouteColor = RGBColor::getDefaultColor();
+                myHaveRoute = true;
+            }
+            break;
+        case SUMO_TAG_ROUTE:
+            if (myVehicleParameter!=0) {
+                if (attrs.hasAttribute(SUMO_ATTR_EDGES)) {
+                    addEdges(attrs.getStringReporting(SUMO_ATTR_EDGES, "route", myVehicleParameter->id.c_str(), ok));
+                }
+                myRouteColor = attrs.hasAttribute(SUMO_ATTR_COLOR)
+                               ? RGBColor::parseColorReporting(attrs.getString(SUMO_ATTR_COLOR), "route", myVehicleParameter->id.c_str(), true, ok)
+                               : RGBColor::getDefaultColor();
+                myHaveRoute = true;
+            }
+            break;
+        case SUMO_TAG_STOP:
+        case SUMO_TAG_PERSON:
+        case SUMO_TAG_RIDE:
+        case SUMO_TAG_WALK:
+        case SUMO_TAG_TRIPDEF:
+            throw ProcessError("Stops, persons and trips can not be converted into a binary demand file.");
+        default:
+            break;
+        }
+        if (!ok) {
+            throw ProcessError();
+        }
+    }
+
+
+    /// @brief Parses routes given as characters
+    void myCharacters(SumoXMLTag element, const std::string &chars) throw(ProcessError) {
+        if (!myAmRecording&&element==SUMO_TAG_ROUTE&&myVehicleParameter!=0) {
+            addEdges(chars);
+        }
+    }
+
+
+    /// @brief Converts closed vehicles and flows
+    void myEndElement(SumoXMLTag element) throw(ProcessError) {
+        if (myAmRecording||(element!=SUMO_TAG_VEHICLE&&element!=SUMO_TAG_FLOW)) {
+            return;
+        }
+        if (element==SUMO_TAG_VEHICLE&&myVehicleParameter->repetitionNumber>0) {
+            // see MSRouteHandler::myEndElement
+            myVehicleParameter->repetitionNumber++;
+            myIsFlow = true;
+        }
+        std::ostringstream record;
+        writeVehicle(record, getRouteIndex(), getIndex(myVehicleParameter->vtypeid, myTypeIndices, myTypes));
+        myVehicles.push_back(std::make_pair(myVehicleParameter->depart, record.str()));
+        delete myVehicleParameter;
+        myVehicleParameter = 0;
+    }
+    //@}
+
+
+private:
+    /**
+     * @struct Route
+     * @brief A route of the route table
+     */
+    struct Route {
+        /// @brief The route's id
+        std::string id;
+        /// @brief Whether the route is used by several vehicles
+        bool shared;
+        /// @brief The route's color
+        RGBColor color;
+        /// @brief The indices of the route's edges (empty for routes defined by id only)
+        std::vector<unsigned int> edges;
+    };
+
+
+    /** @brief Returns the index of the given id within the given table, adding it if it is new
+     * @param[in] id The id to look up
+     * @param[in, out] indices The indices of the ids
+     * @param[in, out] table The table of the ids
+     * @return The id's index
+     */
+    static unsigned int getIndex(const std::string &id, std::map<std::string, unsigned int> &indices,
+                                 std::vector<std::string> &table) throw() {
+        std::map<std::string, unsigned int>::const_iterator i = indices.find(id);
+        if (i!=indices.end()) {
+            return (*i).second;
+        }
+        const unsigned int index = (unsigned int) table.size();
+        indices[id] = index;
+        table.push_back(id);
+        return index;
+    }
+
+
+    /** @brief Appends the given edges to the embedded route
+     * @param[in] edges The edge ids, separated by spaces
+     */
+    void addEdges(const std::string &edges) throw() {
+        StringTokenizer st(edges);
+        while (st.hasNext()) {
+            myRouteEdges.push_back(getIndex(st.next(), myEdgeIndices, myEdges));
+        }
+    }
+
+
+    /** @brief Returns the index of the current vehicle's route, adding it if it is new
+     * @return The route's index
+     * @exception ProcessError If the vehicle has no route
+     */
+    unsigned int getRouteIndex() throw(ProcessError) {
+        std::string key;
+        if (myHaveRoute) {
+            if (myRouteEdges.empty()) {
+                throw ProcessError("Vehicle's '" + myVehicleParameter->id + "' route has no edges.");
+            }
+            // equal edges with an equal color give the same route
+            std::ostringstream strm;
+            strm << "!" << myRouteColor;
+            for (std::vector<unsigned int>::const_iterator i=myRouteEdges.begin(); i!=myRouteEdges.end(); ++i) {
+                strm << " " << *i;
+            }
+            key = strm.str();
+        } else if (myVehicleParameter->routeid!="") {
+            key = myVehicleParameter->routeid;
+        } else {
+            throw ProcessError("Vehicle '" + myVehicleParameter->id + "' has no route.");
+        }
+        std::map<std::string, unsigned int>::const_iterator i = myRouteIndices.find(key);
+        if (i!=myRouteIndices.end()) {
+            myRoutes[(*i).second].shared = true;
+            return (*i).second;
+        }
+        Route route;
+        if (myHaveRoute) {
+            route.id = "!" + myVehicleParameter->id;
+            route.shared = myIsFlow;
+            route.color = myRouteColor;
+            route.edges = myRouteEdges;
+        } else {
+            route.id = myVehicleParameter->routeid;
+            route.shared = true;
+        }
+        const unsigned int index = (unsigned int) myRoutes.size();
+        myRouteIndices[key] = index;
+        myRoutes.push_back(route);
+        return index;
+    }
+
+
+    /** @brief Writes the current vehicle's record
+     * @param[in] strm The stream to write into
+     * @param[in] route The index of the vehicle's route
+     * @param[in] type The index of the vehicle's type
+     * @see MSBinaryRouteLoader::readVehicle
+     */
+    void writeVehicle(std::ostream &strm, unsigned int route, unsigned int type) const throw() {
+        const SUMOVehicleParameter &pars = *myVehicleParameter;
+        FileHelpers::writeString(strm, pars.id);
+        FileHelpers::writeByte(strm, myIsFlow);
+        FileHelpers::writeTime(strm, pars.depart);
+        FileHelpers::writeInt(strm, pars.departProcedure);
+        FileHelpers::writeUInt(strm, route);
+        FileHelpers::writeUInt(strm, type);
+        FileHelpers::writeInt(strm, pars.departLaneProcedure);
+        FileHelpers::writeInt(strm, pars.departLane);
+        FileHelpers::writeInt(strm, pars.departPosProcedure);
+        FileHelpers::writeFloat(strm, pars.departPos);
+        FileHelpers::writeInt(strm, pars.departSpeedProcedure);
+        FileHelpers::writeFloat(strm, pars.departSpeed);
+        FileHelpers::writeInt(strm, pars.arrivalLaneProcedure);
+        FileHelpers::writeInt(strm, pars.arrivalLane);
+        FileHelpers::writeInt(strm, pars.arrivalPosProcedure);
+        FileHelpers::writeFloat(strm, pars.arrivalPos);
+        FileHelpers::writeInt(strm, pars.arrivalSpeedProcedure);
+        FileHelpers::writeFloat(strm, pars.arrivalSpeed);
+        FileHelpers::writeInt(strm, pars.repetitionNumber);
+#ifdef HAVE_SUBSECOND_TIMESTEPS
+        FileHelpers::writeTime(strm, pars.repetitionOffset);
+#else
+        FileHelpers::writeFloat(strm, pars.repetitionOffset);
+#endif
+        FileHelpers::writeInt(strm, pars.setParameter);
+        FileHelpers::writeFloat(strm, pars.color.red());
+        FileHelpers::writeFloat(strm, pars.color.green());
+        FileHelpers::writeFloat(strm, pars.color.blue());
+        FileHelpers::writeString(strm, pars.line);
+        FileHelpers::writeString(strm, pars.fromTaz);
+        FileHelpers::writeString(strm, pars.toTaz);
+    }
+
+
+    /// @brief Compares the departures of two vehicle records
+    static bool departsBefore(const std::pair<SUMOTime, std::string> &v1,
+                              const std::pair<SUMOTime, std::string> &v2) {
+        return v1.first < v2.first;
+    }
+
+
+private:
+    /// @brief The depth of the current element
+    unsigned int myDepth;
+
+    /// @brief Whether a top-level definition is recorded
+    bool myAmRecording;
+
+    /// @brief The recorded definitions
+    std::ostringstream myDefinitions;
+
+    /// @brief Records the definitions into myDefinitions
+    SAXBinaryCache myRecorder;
+
+    /// @brief The currently parsed vehicle or flow
+    SUMOVehicleParameter *myVehicleParameter;
+
+    /// @brief Whether the current vehicle is a flow
+    bool myIsFlow;
+
+    /// @brief Whether the current vehicle has an embedded route
+    bool myHaveRoute;
+
+    /// @brief The edge indices of the current vehicle's embedded route
+    std::vector<unsigned int> myRouteEdges;
+
+    /// @brief The color of the current vehicle's embedded route
+    RGBColor myRouteColor;
+
+    /// @brief The edge table and the edges' indices
+    std::vector<std::string> myEdges;
+    std::map<std::string, unsigned int> myEdgeIndices;
+
+    /// @brief The vehicle type table and the types' indices
+    std::vector<std::string> myTypes;
+    std::map<std::string, unsigned int> myTypeIndices;
+
+    /// @brief The route table and the routes' indices by their edges (or by their id)
+    std::vector<Route> myRoutes;
+    std::map<std::string, unsigned int> myRouteIndices;
+
+    /// @brief The vehicle records with their departures
+    std::vector<std::pair<SUMOTime, std::string> > myVehicles;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    DemandConverter(const DemandConverter &src);
+
+    /// @brief Invalidated assignment operator.
+    DemandConverter &operator=(const DemandConverter &src);
+
+};
+
+
+// ===========================================================================
+// functions
+// ===========================================================================
+/// @brief Registers the converter's options
+void
+fillOptions(OptionsCont &oc) {
+    oc.addCallExample("-r routes.xml -o routes.bin");
+    SystemFrame::addConfigurationOptions(oc);
+    oc.addOptionSubTopic("Input");
+    oc.addOptionSubTopic("Output");
+    oc.addOptionSubTopic("Time");
+
+    oc.doRegister("route-files", 'r', new Option_FileName());
+    oc.addSynonyme("route-files", "routes");
+    oc.addDescription("route-files", "Input", "Convert the routes descriptions of FILE(s)");
+
+    oc.doRegister("output-file", 'o', new Option_FileName());
+    oc.addDescription("output-file", "Output", "Write the binary demand file into FILE");
+
+    oc.doRegister("chunk-size", new Option_Integer(1024));
+    oc.addDescription("chunk-size", "Output", "Write the vehicles in chunks of INT");
+
+    oc.doRegister("begin", 'b', new Option_String("0", "TIME"));
+    oc.addDescription("begin", "Time", "Defines the default begin time of flows");
+
+    oc.doRegister("end", 'e', new Option_String("-1", "TIME"));
+    oc.addDescription("end", "Time", "Defines the default end time of flows");
+
+    SystemFrame::addReportOptions(oc);
+}
+
+
+/* -------------------------------------------------------------------------
+ * main
+ * ----------------------------------------------------------------------- */
+int
+main(int argc, char **argv) {
+    OptionsCont &oc = OptionsCont::getOptions();
+    // give some application descriptions
+    oc.setApplicationDescription("Converts XML route files into a binary demand file.");
+#ifdef WIN32
+    oc.setApplicationName("route2bin.exe", "SUMO route2bin Version " + (std::string)VERSION_STRING);
+#else
+    oc.setApplicationName("route2bin", "SUMO route2bin Version " + (std::string)VERSION_STRING);
+#endif
+    int ret = 0;
+    try {
+        // initialise subsystems
+        XMLSubSys::init(false);
+        fillOptions(oc);
+        OptionsIO::getOptions(true, argc, argv);
+        if (oc.processMetaOptions(argc < 2)) {
+            SystemFrame::close();
+            return 0;
+        }
+        MsgHandler::initOutputOptions();
+        if (!oc.isSet("route-files")||!oc.isSet("output-file")) {
+            throw ProcessError("Both, the route files and the output file must be given.");
+        }
+        if (oc.getInt("chunk-size")<=0) {
+            throw ProcessError("The chunk size must be positive.");
+        }
+        DemandConverter converter;
+        const std::vector<std::string> files = oc.getStringVector("route-files");
+        for (std::vector<std::string>::const_iterator i=files.begin(); i!=files.end(); ++i) {
+            MsgHandler::getMessageInstance()->beginProcessMsg("Loading routes from '" + *i + "' ...");
+            if (!XMLSubSys::runParser(converter, *i)) {
+                throw ProcessError();
+            }
+            MsgHandler::getMessageInstance()->endProcessMsg(" done.");
+        }
+        const std::string output = oc.getString("output-file");
+        std::ofstream strm(output.c_str(), std::ios::out|std::ios::binary);
+        converter.write(strm, (unsigned int) oc.getInt("chunk-size"));
+        strm.close();
+        if (!strm.good()) {
+            throw ProcessError("Could not write the binary demand file '" + output + "'.");
+        }
+        WRITE_MESSAGE("Wrote " + toString(converter.getVehicleNumber()) + " vehicles and flows using "
+                      + toString(converter.getRouteNumber()) + " routes.");
+    } catch (ProcessError &e) {
+        if (std::string(e.what())!=std::string("Process Error") && std::string(e.what())!=std::string("")) {
+            MsgHandler::getErrorInstance()->inform(e.what());
+        }
+        MsgHandler::getErrorInstance()->inform("Quitting (on error).", false);
+        ret = 1;
+#ifndef _DEBUG
+    } catch (std::exception &e) {
+        MsgHandler::getErrorInstance()->inform("Quitting (on unknown error).", false);
+        ret = 1;
+#endif
+    }
+    SystemFrame::close();
+    return ret;
+}
+
+
+
+/****************************************************************************/
+
@@ -0,0 +1,154 @@
+/****************************************************************************/
+/// @file    sumo_main.cpp
+/// @author  Daniel Krajzewicz, agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: sumo_main.cpp $
+///
+// Main for SUMO, the simulation without a gui
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#ifdef HAVE_VERSION_H
+#include <version.h>
+#endif
+
+#include <ctime>
+#include <string>
+#include <iostream>
+#include <microsim/MSNet.h>
+#include <microsim/MSVehicleControl.h>
+#include <microsim/MSEventControl.h>
+#include <microsim/MSFrame.h>
+#include <netload/NLBuilder.h>
+#include <netload/NLHandler.h>
+#include <netload/NLTriggerBuilder.h>
+#include <netload/NLEdgeControlBuilder.h>
+#include <netload/NLJunctionControlBuilder.h>
+#include <netload/NLDetectorBuilder.h>
+#include <netload/NLGeomShapeBuilder.h>
+#include <utils/options/Option.h>
+#include <utils/options/OptionsCont.h>
+#include <utils/options/OptionsIO.h>
+#include <utils/common/UtilExceptions.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/SystemFrame.h>
+#include <utils/common/RandHelper.h>
+#include <utils/common/SUMOTime.h>
+#include <utils/iodevices/OutputDevice.h>
+#include <utils/xml/XMLSubSys.h>
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif
+
+
+// ===========================================================================
+// functions
+// ===========================================================================
+/* -------------------------------------------------------------------------
+ * data processing methods
+ * ----------------------------------------------------------------------- */
+/**
+ * loads the net, additional routes and the detectors
+ */
+MSNet *
+load(OptionsCont &oc) {
+    MSFrame::setMSGlobals(oc);
+    MSNet *net = new MSNet(new MSVehicleControl(), new MSEventControl(),
+                           new MSEventControl(), new MSEventControl());
+    NLEdgeControlBuilder eb;
+    NLDetectorBuilder db(*net);
+    NLJunctionControlBuilder jb(*net, oc);
+    NLGeomShapeBuilder sb(*net);
+    NLTriggerBuilder tb;
+    NLHandler handler("", *net, db, tb, eb, jb, sb);
+    tb.setHandler(&handler);
+    NLBuilder builder(oc, *net, eb, jb, db, handler);
+    if (!builder.build()) {
+        delete net;
+        throw ProcessError();
+    }
+    return net;
+}
+
+
+/* -------------------------------------------------------------------------
+ * main
+ * ----------------------------------------------------------------------- */
+int
+main(int argc, char **argv) {
+    OptionsCont &oc = OptionsCont::getOptions();
+    // give some application descriptions
+    oc.setApplicationDescription("A microscopic road traffic simulation.");
+#ifdef WIN32
+    oc.setApplicationName("sumo.exe", "SUMO sumo Version " + (std::string)VERSION_STRING);
+#else
+    oc.setApplicationName("sumo", "SUMO sumo Version " + (std::string)VERSION_STRING);
+#endif
+    int ret = 0;
+    MSNet *net = 0;
+    try {
+        // initialise subsystems
+        XMLSubSys::init(false);
+        MSFrame::fillOptions();
+        OptionsIO::getOptions(true, argc, argv);
+        if (oc.processMetaOptions(argc < 2)) {
+            SystemFrame::close();
+            return 0;
+        }
+        MsgHandler::initOutputOptions();
+        if (!MSFrame::checkOptions()) {
+            throw ProcessError();
+        }
+        RandHelper::initRandGlobal();
+        // load the net
+        net = load(oc);
+        if (net!=0) {
+            ret = net->simulate(string2time(oc.getString("begin")), string2time(oc.getString("end")));
+        }
+    } catch (ProcessError &e) {
+        if (std::string(e.what())!=std::string("Process Error") && std::string(e.what())!=std::string("")) {
+            MsgHandler::getErrorInstance()->inform(e.what());
+        }
+        MsgHandler::getErrorInstance()->inform("Quitting (on error).", false);
+        ret = 1;
+#ifndef _DEBUG
+    } catch (std::exception &e) {
+        MsgHandler::getErrorInstance()->inform("Quitting (on unknown error).", false);
+        ret = 1;
+#endif
+    }
+    delete net;
+    SystemFrame::close();
+    // write the remaining (buffered) outputs, also after an error
+    OutputDevice::closeAll();
+    if (ret==0) {
+        std::cout << "Success." << std::endl;
+    }
+    return ret;
+}
+
+
+
+/****************************************************************************/
+
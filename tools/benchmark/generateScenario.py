@@ -0,0 +1,247 @@
+#!/usr/bin/env python
+"""
+@file    generateScenario.py
+@author  agent
+@date    2026-10-17
+@version $Id: generateScenario.py $
+
+Generates a synthetic mixed traffic scenario for benchmarking: a grid or
+arterial network of strip-based lanes joined by unregulated junctions and
+a route file with two-wheelers, autos, cars and buses at a target density.
+
+Copyright (C) 2001-2010 DLR (http://www.dlr.de/) and contributors
+All rights reserved
+"""
+from __future__ import print_function
+
+import math
+import random
+import sys
+from optparse import OptionParser
+
+# id, strips, length [m], max speed [m/s], accel, decel, sigma
+VEHICLE_TYPES = [
+    ("twoWheeler", 1, 1.8, 16.67, 2.5, 4.5, .5),
+    ("auto", 2, 2.6, 13.89, 1.8, 4.0, .5),
+    ("car", 3, 4.2, 19.44, 2.6, 4.5, .5),
+    ("bus", 5, 11.0, 13.89, 1.2, 4.0, .5),
+]
+DEFAULT_MIX = "twoWheeler:0.45,auto:0.2,car:0.3,bus:0.05"
+LANE_OFFSET = 3.2
+# the assumed mean speed relative to the speed limit, used for the demand
+SPEED_RATIO = .6
+
+
+class Edge:
+
+    def __init__(self, fromNode, toNode, lanes, speed):
+        self.fromNode = fromNode
+        self.toNode = toNode
+        self.id = "%s_%s_%s_%s" % (fromNode + toNode)
+        self.lanes = lanes
+        self.speed = speed
+
+    def laneIDs(self):
+        return ["%s_%s" % (self.id, i) for i in range(self.lanes)]
+
+
+class Network:
+
+    def __init__(self, options):
+        self.options = options
+        self.edges = {}
+        self.outgoing = {}
+        self.incoming = {}
+        self.nodes = [(x, y) for x in range(options.x) for y in range(options.y)]
+        arterialRow = options.y // 2
+        for x, y in self.nodes:
+            for dx, dy in ((1, 0), (0, 1), (-1, 0), (0, -1)):
+                x2, y2 = x + dx, y + dy
+                if x2 < 0 or x2 >= options.x or y2 < 0 or y2 >= options.y:
+                    continue
+                lanes, speed = options.lanes, options.speed
+                if options.type == "arterial" and y == arterialRow and y2 == arterialRow:
+                    lanes, speed = options.arterial_lanes, options.arterial_speed
+                edge = Edge((x, y), (x2, y2), lanes, speed)
+                self.edges[edge.fromNode, edge.toNode] = edge
+                self.outgoing.setdefault((x, y), []).append(edge)
+                self.incoming.setdefault((x2, y2), []).append(edge)
+
+    def position(self, node):
+        return node[0] * self.options.length, node[1] * self.options.length
+
+    def laneShape(self, edge, index):
+        (x1, y1), (x2, y2) = self.position(edge.fromNode), self.position(edge.toNode)
+        dx = (x2 - x1) / self.options.length
+        dy = (y2 - y1) / self.options.length
+        # lanes lie right of their edge's axis
+        offset = LANE_OFFSET * (index + .5)
+        return "%.2f,%.2f %.2f,%.2f" % (x1 + dy * offset, y1 - dx * offset,
+                                        x2 + dy * offset, y2 - dx * offset)
+
+    def laneKilometres(self):
+        return sum([e.lanes for e in self.edges.values()]) * self.options.length / 1000.
+
+    def direction(self, edge, follower):
+        ax, ay = edge.toNode[0] - edge.fromNode[0], edge.toNode[1] - edge.fromNode[1]
+        bx, by = follower.toNode[0] - follower.fromNode[0], follower.toNode[1] - follower.fromNode[1]
+        cross = ax * by - ay * bx
+        if follower.toNode == edge.fromNode:
+            return "t"
+        if cross > 0:
+            return "l"
+        if cross < 0:
+            return "r"
+        return "s"
+
+    def write(self, fileName):
+        options = self.options
+        out = open(fileName, "w")
+        print('<?xml version="1.0" encoding="UTF-8"?>\n', file=out)
+        print('<!-- generated by generateScenario.py -->', file=out)
+        print('<net>', file=out)
+        for key in sorted(self.edges):
+            edge = self.edges[key]
+            print('    <edge id="%s" function="normal" numstrips="%s">' % (edge.id, options.strips), file=out)
+            print('        <lanes>', file=out)
+            for index, lane in enumerate(edge.laneIDs()):
+                print('            <lane id="%s" depart="%s" maxspeed="%.2f" length="%.2f" shape="%s"/>' % (
+                    lane, int(index == 0), edge.speed, options.length, self.laneShape(edge, index)), file=out)
+            print('        </lanes>', file=out)
+            print('    </edge>', file=out)
+        for node in self.nodes:
+            x, y = self.position(node)
+            incLanes = []
+            for edge in self.incoming.get(node, []):
+                incLanes += edge.laneIDs()
+            shape = "%.2f,%.2f %.2f,%.2f %.2f,%.2f %.2f,%.2f" % (x - 5, y - 5, x + 5, y - 5, x + 5, y + 5, x - 5, y + 5)
+            print('    <junction id="%s_%s" type="unregulated" x="%.2f" y="%.2f" incLanes="%s" intLanes="" shape="%s"/>' % (
+                node + (x, y, " ".join(incLanes), shape)), file=out)
+        for key in sorted(self.edges):
+            edge = self.edges[key]
+            followers = [f for f in self.outgoing[edge.toNode] if f.toNode != edge.fromNode]
+            if not followers:
+                # dead ends allow turning
+                followers = self.outgoing[edge.toNode]
+            for lane in edge.laneIDs():
+                print('    <succ edge="%s" lane="%s" junction="%s_%s">' % ((edge.id, lane) + edge.toNode), file=out)
+                for follower in followers:
+                    for succ in follower.laneIDs():
+                        print('        <succlane lane="%s" yield="0" dir="%s" state="M"/>' % (
+                            succ, self.direction(edge, follower)), file=out)
+                print('    </succ>', file=out)
+        print('</net>', file=out)
+        out.close()
+
+    def route(self, origin, destination):
+        """Returns the edges of a path along the grid's axes (x or y first)"""
+        nodes = [origin]
+        x, y = origin
+        axes = [0, 1]
+        random.shuffle(axes)
+        for axis in axes:
+            while (x, y)[axis] != destination[axis]:
+                step = 1 if destination[axis] > (x, y)[axis] else -1
+                if axis == 0:
+                    x += step
+                else:
+                    y += step
+                nodes.append((x, y))
+        return [self.edges[a, b] for a, b in zip(nodes[:-1], nodes[1:])]
+
+
+def parseMix(definition):
+    types = dict([(t[0], t) for t in VEHICLE_TYPES])
+    mix = []
+    for entry in definition.split(","):
+        name, share = entry.split(":")
+        if name not in types:
+            raise ValueError("unknown vehicle type '%s'" % name)
+        mix.append((types[name], float(share)))
+    return mix
+
+
+def chooseType(mix):
+    r = random.random() * sum([share for t, share in mix])
+    for vtype, share in mix:
+        if r < share:
+            return vtype
+        r -= share
+    return mix[-1][0]
+
+
+def writeRoutes(net, fileName):
+    """Writes vehicles departing at a constant rate such that the mean
+    number of vehicles in the network matches the wished density"""
+    options = net.options
+    mix = parseMix(options.mix)
+    for vtype, share in mix:
+        if vtype[1] > options.strips:
+            raise ValueError("vehicles of type '%s' do not fit into a lane" % vtype[0])
+    target = options.density * net.laneKilometres()
+    # the mean length of a path between two random junctions
+    meanSteps = (options.x * options.x - 1) / (3. * options.x) + (options.y * options.y - 1) / (3. * options.y)
+    travelTime = meanSteps * options.length / (SPEED_RATIO * options.speed)
+    number = int(target / travelTime * options.duration + .5) if travelTime > 0 else 0
+    departs = sorted([random.random() * options.duration for i in range(number)])
+    out = open(fileName, "w")
+    print('<?xml version="1.0" encoding="UTF-8"?>\n', file=out)
+    print('<!-- generated by generateScenario.py -->', file=out)
+    print('<routes>', file=out)
+    for vid, strips, length, speed, accel, decel, sigma in VEHICLE_TYPES:
+        print('    <vtype id="%s" stripWidth="%s" length="%.2f" maxspeed="%.2f" accel="%.2f" decel="%.2f" sigma="%.2f"/>' % (
+            vid, strips, length, speed, accel, decel, sigma), file=out)
+    for index, depart in enumerate(departs):
+        origin = random.choice(net.nodes)
+        destination = random.choice(net.nodes)
+        while destination == origin:
+            destination = random.choice(net.nodes)
+        edges = net.route(origin, destination)
+        print('    <vehicle id="%s" type="%s" depart="%.2f" departlane="free" departspeed="max">' % (
+            index, chooseType(mix)[0], depart), file=out)
+        print('        <route edges="%s"/>' % " ".join([e.id for e in edges]), file=out)
+        print('    </vehicle>', file=out)
+    print('</routes>', file=out)
+    out.close()
+    return number
+
+
+def getOptionParser():
+    optParser = OptionParser(usage="usage: %prog [options]")
+    optParser.add_option("-t", "--type", default="grid", help="network type (grid or arterial)")
+    optParser.add_option("-x", "--x", type="int", default=5, help="number of junctions in x-direction")
+    optParser.add_option("-y", "--y", type="int", default=5, help="number of junctions in y-direction")
+    optParser.add_option("-l", "--length", type="float", default=200., help="length of the edges [m]")
+    optParser.add_option("--strips", type="int", default=8, help="number of strips per lane")
+    optParser.add_option("--lanes", type="int", default=1, help="number of lanes per edge")
+    optParser.add_option("--speed", type="float", default=13.89, help="speed limit [m/s]")
+    optParser.add_option("--arterial-lanes", type="int", default=2, help="number of lanes of the arterial's edges")
+    optParser.add_option("--arterial-speed", type="float", default=16.67, help="speed limit of the arterial [m/s]")
+    optParser.add_option("-d", "--density", type="float", default=50., help="target density [vehicles/km/lane]")
+    optParser.add_option("--duration", type="float", default=3600., help="time span of the departures [s]")
+    optParser.add_option("-m", "--mix", default=DEFAULT_MIX, help="vehicle mix (type:share,...)")
+    optParser.add_option("-s", "--seed", type="int", default=42, help="random seed")
+    optParser.add_option("-o", "--output-prefix", dest="prefix", default="scenario", help="prefix of the written files")
+    return optParser
+
+
+def generate(options):
+    """Writes <prefix>.net.xml and <prefix>.rou.xml; returns the number of vehicles"""
+    if options.type not in ("grid", "arterial"):
+        raise ValueError("unknown network type '%s'" % options.type)
+    if options.x * options.y < 2:
+        raise ValueError("the network needs at least two junctions")
+    random.seed(options.seed)
+    net = Network(options)
+    net.write(options.prefix + ".net.xml")
+    return writeRoutes(net, options.prefix + ".rou.xml")
+
+
+if __name__ == "__main__":
+    options, args = getOptionParser().parse_args()
+    try:
+        number = generate(options)
+    except ValueError as e:
+        print("Error: %s" % e, file=sys.stderr)
+        sys.exit(1)
+    print("Wrote %s.net.xml and %s.rou.xml (%s vehicles)." % (options.prefix, options.prefix, number))
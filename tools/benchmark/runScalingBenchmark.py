@@ -0,0 +1,122 @@
+#!/usr/bin/env python
+"""
+@file    runScalingBenchmark.py
+@author  agent
+@date    2026-10-17
+@version $Id: runScalingBenchmark.py $
+
+Runs the simulation without gui over a matrix of network sizes, demand
+levels and thread counts using scenarios built by generateScenario.py and
+reports steps/second, vehicle updates/second, peak RSS and load time as
+JSON.
+
+Copyright (C) 2001-2010 DLR (http://www.dlr.de/) and contributors
+All rights reserved
+"""
+from __future__ import print_function
+
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+from optparse import OptionParser
+
+import generateScenario
+
+LOAD_PATTERN = re.compile(r"Loading net-file from '.*' \.\.\.\s*done \((\d+)ms\)")
+DURATION_PATTERN = re.compile(r"Duration: (\d+) ms")
+UPS_PATTERN = re.compile(r"UPS: ([0-9.]+)")
+EMITTED_PATTERN = re.compile(r"Emitted: (\d+)")
+
+
+def parseMatrix(definition, cast):
+    return [cast(value) for value in definition.split(",") if value != ""]
+
+
+def parseSize(definition):
+    x, y = definition.lower().split("x")
+    return int(x), int(y)
+
+
+def buildScenario(options, size, density):
+    """Generates the scenario (once) and returns its file prefix"""
+    prefix = os.path.join(options.work_dir, "%s_%sx%s_d%s" % (options.type, size[0], size[1], density))
+    if not os.path.exists(prefix + ".rou.xml"):
+        genOptions, args = generateScenario.getOptionParser().parse_args([])
+        genOptions.type = options.type
+        genOptions.x, genOptions.y = size
+        genOptions.strips = options.strips
+        genOptions.density = density
+        genOptions.duration = options.end
+        genOptions.seed = options.seed
+        genOptions.prefix = prefix
+        generateScenario.generate(genOptions)
+    return prefix
+
+
+def run(options, prefix, threads):
+    """Runs the simulation and returns the measured values"""
+    call = [options.sumo, "-n", prefix + ".net.xml", "-r", prefix + ".rou.xml",
+            "-b", "0", "-e", str(int(options.end)), "--threads", str(threads),
+            "--srand", str(options.seed), "-v", "--no-step-log"]
+    begin = time.time()
+    process = subprocess.Popen(call, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    output = process.stdout.read()
+    pid, status, usage = os.wait4(process.pid, 0)
+    wallTime = time.time() - begin
+    result = {"returnCode": os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1,
+              "wallTime": wallTime,
+              # ru_maxrss is given in kilobytes on Linux
+              "peakRSS": usage.ru_maxrss * 1024}
+    match = LOAD_PATTERN.search(output)
+    result["loadTime"] = float(match.group(1)) / 1000. if match else None
+    match = DURATION_PATTERN.search(output)
+    duration = float(match.group(1)) / 1000. if match else None
+    result["simulationTime"] = duration
+    result["stepsPerSecond"] = options.end / duration if duration else None
+    match = UPS_PATTERN.search(output)
+    result["vehicleUpdatesPerSecond"] = float(match.group(1)) if match else None
+    match = EMITTED_PATTERN.search(output)
+    result["emittedVehicles"] = int(match.group(1)) if match else None
+    if result["returnCode"] != 0:
+        result["output"] = output[-2000:]
+    return result
+
+
+def main():
+    optParser = OptionParser(usage="usage: %prog [options]")
+    optParser.add_option("--sumo", default=os.path.join("Debug", "iSUMO"), help="the simulation executable")
+    optParser.add_option("-t", "--type", default="grid", help="network type (grid or arterial)")
+    optParser.add_option("--sizes", default="5x5,10x10,20x20", help="network sizes (XxY,...)")
+    optParser.add_option("--densities", default="25,50,100", help="target densities [vehicles/km/lane]")
+    optParser.add_option("--threads", default="1,2,4", help="thread counts")
+    optParser.add_option("--strips", type="int", default=8, help="number of strips per lane")
+    optParser.add_option("-e", "--end", type="float", default=600., help="simulated time [s]")
+    optParser.add_option("-s", "--seed", type="int", default=42, help="random seed")
+    optParser.add_option("-w", "--work-dir", default="scaling", help="directory for the scenarios")
+    optParser.add_option("-o", "--output", help="write the JSON into FILE instead of stdout")
+    options, args = optParser.parse_args()
+    if not os.path.exists(options.work_dir):
+        os.makedirs(options.work_dir)
+    results = []
+    for size in parseMatrix(options.sizes, parseSize):
+        for density in parseMatrix(options.densities, float):
+            prefix = buildScenario(options, size, density)
+            for threads in parseMatrix(options.threads, int):
+                print("running %sx%s, density %s, %s thread(s)" % (size + (density, threads)), file=sys.stderr)
+                result = run(options, prefix, threads)
+                result.update({"type": options.type, "size": "%sx%s" % size,
+                               "density": density, "threads": threads})
+                results.append(result)
+    out = open(options.output, "w") if options.output else sys.stdout
+    json.dump({"end": options.end, "strips": options.strips, "seed": options.seed, "runs": results},
+              out, indent=2, sort_keys=True)
+    print(file=out)
+    if options.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python
+"""
+@file    binaryNetstate.py
+@author  agent
+@date    2026-10-17
+@version $Id: binaryNetstate.py $
+
+Reads binary netstate dumps (written with --netstate-dump.binary, see
+MSBinaryRawOut.h for the format). Each frame is returned with its values
+as typed arrays (array.array) which numpy.asarray converts without
+copying the data element-wise.
+
+Used as a script, prints the number of vehicles per frame.
+
+Copyright (C) 2001-2010 DLR (http://www.dlr.de/) and contributors
+All rights reserved
+"""
+from __future__ import print_function
+
+import array
+import struct
+import sys
+
+FORMAT_MAGIC = 0x534e4442
+FORMAT_VERSION = 1
+FRAME_FULL = 1
+FRAME_DELTA = 2
+
+
+class Frame:
+
+    def __init__(self, time, slots, lanes, strips, widths, positions, speeds, ids):
+        self.time = time
+        self.slots = slots
+        self.lanes = lanes
+        self.strips = strips
+        self.widths = widths
+        self.positions = positions
+        self.speeds = speeds
+        self._ids = ids
+
+    def vehicleIDs(self):
+        return list(self._ids)
+
+
+class BinaryNetstateReader:
+
+    def __init__(self, path):
+        self._file = open(path, "rb")
+        magic = struct.unpack("<I", self._read(4))[0]
+        if magic == FORMAT_MAGIC:
+            self._order = "<"
+        elif struct.unpack(">I", struct.pack("<I", magic))[0] == FORMAT_MAGIC:
+            self._order = ">"
+        else:
+            raise IOError("'%s' is not a binary netstate dump" % path)
+        self._swap = (self._order == "<") != (sys.byteorder == "little")
+        if self._uint() != FORMAT_VERSION:
+            raise IOError("'%s' is not of version %s" % (path, FORMAT_VERSION))
+        self.omitEmptyEdges = self._byte() != 0
+        self.keyFrameInterval = self._uint()
+        # edges: (id, [lane index, ...]), lanes: index -> (id, [strip id, ...])
+        self.edges = []
+        self.lanes = {}
+        for _ in range(self._uint()):
+            edgeID = self._string()
+            laneIndices = []
+            for _ in range(self._uint()):
+                index = self._uint()
+                laneID = self._string()
+                self.lanes[index] = (laneID, [self._string() for _ in range(self._uint())])
+                laneIndices.append(index)
+            self.edges.append((edgeID, laneIndices))
+        self._ids = {}
+        self._previous = None
+
+    def __iter__(self):
+        while True:
+            head = self._file.read(1)
+            if not head:
+                return
+            yield self._readFrame(ord(head))
+
+    def close(self):
+        self._file.close()
+
+    def _readFrame(self, frameType):
+        time = struct.unpack(self._order + "i", self._read(4))[0] / 1000.
+        bound = self._array("I", self._uint())
+        for slot in bound:
+            self._ids[slot] = self._string()
+        rowNo = self._uint()
+        if frameType == FRAME_FULL:
+            slots = self._array("I", rowNo)
+            lanes = self._array("I", rowNo)
+            strips = self._array("H", rowNo)
+            widths = self._array("B", rowNo)
+        elif frameType == FRAME_DELTA and self._previous is not None:
+            slots, lanes, strips, widths = self._readDelta(rowNo)
+        else:
+            raise IOError("corrupt frame")
+        positions = self._array("f", rowNo)
+        speeds = self._array("f", rowNo)
+        self._previous = (slots, lanes, strips, widths)
+        # slots are rebound to other vehicles later on, so each frame keeps
+        # the ids of its own rows
+        ids = [self._ids[slot] for slot in slots]
+        return Frame(time, slots, lanes, strips, widths, positions, speeds, ids)
+
+    def _readDelta(self, rowNo):
+        left = set(self._array("I", self._uint()))
+        entered = self._array("I", self._uint())
+        pSlots, pLanes, pStrips, pWidths = self._previous
+        rows = [(pSlots[i], pLanes[i], pStrips[i], pWidths[i])
+                for i in range(len(pSlots)) if pSlots[i] not in left]
+        rows += [(slot, 0, 0, 0) for slot in entered]
+        rows.sort()
+        if len(rows) != rowNo:
+            raise IOError("corrupt delta frame")
+        slots = array.array("I", [r[0] for r in rows])
+        lanes = array.array("I", [r[1] for r in rows])
+        strips = array.array("H", [r[2] for r in rows])
+        widths = array.array("B", [r[3] for r in rows])
+        changedNo = self._uint()
+        changed = self._array("I", changedNo)
+        for target, values in ((lanes, self._array("I", changedNo)),
+                               (strips, self._array("H", changedNo)),
+                               (widths, self._array("B", changedNo))):
+            for row, value in zip(changed, values):
+                target[row] = value
+        return slots, lanes, strips, widths
+
+    def _read(self, size):
+        data = self._file.read(size)
+        if len(data) != size:
+            raise IOError("unexpected end of file")
+        return data
+
+    def _array(self, typecode, size):
+        values = array.array(typecode)
+        if size:
+            data = self._read(size * values.itemsize)
+            if hasattr(values, "frombytes"):
+                values.frombytes(data)
+            else:
+                values.fromstring(data)
+            if self._swap:
+                values.byteswap()
+        return values
+
+    def _uint(self):
+        return struct.unpack(self._order + "I", self._read(4))[0]
+
+    def _byte(self):
+        return ord(self._read(1))
+
+    def _string(self):
+        return self._read(self._uint()).decode("utf8")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s <binary netstate dump>" % sys.argv[0])
+    reader = BinaryNetstateReader(sys.argv[1])
+    for frame in reader:
+        print(frame.time, len(frame.slots))
+    reader.close()
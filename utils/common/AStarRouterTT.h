@@ -0,0 +1,270 @@
+/****************************************************************************/
+/// @file    AStarRouterTT.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: AStarRouterTT.h $
+///
+// A* shortest path algorithm using travel time and landmark lower bounds (ALT)
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef AStarRouterTT_h
+#define AStarRouterTT_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <queue>
+#include <limits>
+#include <functional>
+#include <utils/common/StdDefs.h>
+#include "DijkstraRouterTT.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class LandmarkLookupTable
+ * @brief Lower bounds of the effort between any two edges, derived from landmarks
+ *
+ * For a few chosen landmark edges, the efforts from each landmark to all edges
+ *  and from all edges to each landmark are computed once, using a lower bound
+ *  of each edge's effort. By the triangle inequality, the differences of these
+ *  efforts bound the effort between any two edges from below.
+ *
+ * As in DijkstraRouterTTBase, the effort of a path is the sum of the efforts
+ *  of its edges except the last one. Landmarks are chosen one after another,
+ *  each being the edge farthest from the ones already chosen.
+ *
+ * The table only stays valid as long as no edge's effort falls below the
+ *  lower bound given for it.
+ */
+template<class E>
+class LandmarkLookupTable {
+public:
+    /** @brief Constructor; chooses the landmarks and computes the efforts
+     * @param[in] noE The number of edges
+     * @param[in] lowerBounds The lower bound of each edge's effort, by the edges' numerical ids
+     * @param[in] landmarkNo The number of landmarks to use
+     */
+    LandmarkLookupTable(size_t noE, const std::vector<SUMOReal> &lowerBounds, unsigned int landmarkNo)
+            : myLowerBounds(lowerBounds), myReverse(noE) {
+        for (size_t i = 0; i < noE; i++) {
+            const E * const edge = E::dictionary(i);
+            if (edge == 0) {
+                continue;
+            }
+            const unsigned int length_size = edge->getNoFollowing();
+            for (unsigned int j=0; j<length_size; j++) {
+                myReverse[edge->getFollower(j)->getNumericalID()].push_back(edge);
+            }
+        }
+        // the distance of each edge to the next chosen landmark; missing edges
+        //  are marked as reached so that they are never chosen
+        std::vector<SUMOReal> closest(noE, std::numeric_limits<SUMOReal>::max());
+        for (size_t i=0; i<noE; ++i) {
+            if (E::dictionary(i)==0) {
+                closest[i] = 0;
+            }
+        }
+        for (unsigned int l=0; l<landmarkNo && noE>0; ++l) {
+            // choose the edge farthest from all chosen landmarks; unreached ones
+            //  first, so the first landmark is the first existing edge
+            size_t landmark = 0;
+            for (size_t i=1; i<noE; ++i) {
+                if (closest[i]>closest[landmark]) {
+                    landmark = i;
+                }
+            }
+            if (closest[landmark]==0) {
+                // all edges are landmarks already (or there is none)
+                break;
+            }
+            myFromLandmark.push_back(std::vector<SUMOReal>());
+            myToLandmark.push_back(std::vector<SUMOReal>());
+            computeEfforts(E::dictionary(landmark), true, myFromLandmark.back());
+            computeEfforts(E::dictionary(landmark), false, myToLandmark.back());
+            for (size_t i=0; i<noE; ++i) {
+                const SUMOReal dist = myFromLandmark.back()[i];
+                if (dist!=std::numeric_limits<SUMOReal>::max()) {
+                    closest[i] = closest[i]==std::numeric_limits<SUMOReal>::max() ? dist : MIN2(closest[i], dist);
+                }
+            }
+        }
+    }
+
+
+    /// @brief Destructor
+    ~LandmarkLookupTable() { }
+
+
+    /** @brief Returns a lower bound of the effort to get from the first edge to the second
+     * @param[in] from The edge to start at
+     * @param[in] to The edge to reach
+     * @return The lower bound, std::numeric_limits<SUMOReal>::max() if "to" can not be reached
+     */
+    SUMOReal lowerBound(const E * const from, const E * const to) const {
+        const size_t fi = from->getNumericalID();
+        const size_t ti = to->getNumericalID();
+        const SUMOReal inf = std::numeric_limits<SUMOReal>::max();
+        SUMOReal result = 0;
+        for (size_t l=0; l<myFromLandmark.size(); ++l) {
+            // d(L,to) <= d(L,from) + d(from,to)
+            const SUMOReal fromL = myFromLandmark[l][fi];
+            const SUMOReal toL = myFromLandmark[l][ti];
+            if (fromL!=inf) {
+                if (toL==inf) {
+                    // the landmark reaches "from" but not "to", so "from" does not reach "to"
+                    return inf;
+                }
+                result = MAX2(result, toL - fromL);
+            }
+            // d(from,L) <= d(from,to) + d(to,L)
+            const SUMOReal fromR = myToLandmark[l][fi];
+            const SUMOReal toR = myToLandmark[l][ti];
+            if (toR!=inf) {
+                if (fromR==inf) {
+                    // "to" reaches the landmark but "from" does not, so "from" does not reach "to"
+                    return inf;
+                }
+                result = MAX2(result, fromR - toR);
+            }
+        }
+        return result;
+    }
+
+
+    /// @brief Returns the number of used landmarks
+    size_t size() const {
+        return myFromLandmark.size();
+    }
+
+
+private:
+    /** @brief Computes the efforts from (or to) the given edge to (or from) all edges
+     * @param[in] landmark The edge to start (or end) at
+     * @param[in] forward Whether the efforts from the landmark shall be computed
+     * @param[filled] into The efforts by the edges' numerical ids
+     */
+    void computeEfforts(const E * const landmark, bool forward, std::vector<SUMOReal> &into) const {
+        typedef std::pair<SUMOReal, size_t> Entry;
+        into.assign(myReverse.size(), std::numeric_limits<SUMOReal>::max());
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > frontier;
+        into[landmark->getNumericalID()] = 0;
+        frontier.push(Entry(0, landmark->getNumericalID()));
+        while (!frontier.empty()) {
+            const Entry current = frontier.top();
+            frontier.pop();
+            if (current.first>into[current.second]) {
+                // outdated entry
+                continue;
+            }
+            if (forward) {
+                const E * const edge = E::dictionary(current.second);
+                const SUMOReal dist = current.first + myLowerBounds[current.second];
+                const unsigned int length_size = edge->getNoFollowing();
+                for (unsigned int i=0; i<length_size; i++) {
+                    relax(edge->getFollower(i)->getNumericalID(), dist, into, frontier);
+                }
+            } else {
+                const std::vector<const E*> &preds = myReverse[current.second];
+                for (typename std::vector<const E*>::const_iterator i=preds.begin(); i!=preds.end(); ++i) {
+                    const size_t pred = (*i)->getNumericalID();
+                    relax(pred, current.first + myLowerBounds[pred], into, frontier);
+                }
+            }
+        }
+    }
+
+
+    /// @brief Lowers the effort of the given edge if the given one is smaller
+    template<class Q>
+    static void relax(size_t edge, SUMOReal dist, std::vector<SUMOReal> &into, Q &frontier) {
+        if (dist<into[edge]) {
+            into[edge] = dist;
+            frontier.push(typename Q::value_type(dist, edge));
+        }
+    }
+
+
+private:
+    /// @brief The lower bounds of the edges' efforts
+    std::vector<SUMOReal> myLowerBounds;
+
+    /// @brief The edges leading to each edge
+    std::vector<std::vector<const E*> > myReverse;
+
+    /// @brief The efforts from each landmark to all edges
+    std::vector<std::vector<SUMOReal> > myFromLandmark;
+
+    /// @brief The efforts from all edges to each landmark
+    std::vector<std::vector<SUMOReal> > myToLandmark;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    LandmarkLookupTable(const LandmarkLookupTable&);
+
+    /// @brief Invalidated assignment operator.
+    LandmarkLookupTable& operator=(const LandmarkLookupTable&);
+
+};
+
+
+/**
+ * @class AStarRouterTT_ByProxi
+ * @brief A DijkstraRouterTT_ByProxi which directs its search using landmark lower bounds
+ *
+ * Computes the same routes as DijkstraRouterTT_ByProxi as long as the efforts
+ *  retrieved from the receiver are not below the lower bounds the lookup table
+ *  was built with. Without a lookup table, it is a plain Dijkstra router.
+ */
+template<class E, class V, class PF, class EC>
+class AStarRouterTT_ByProxi : public DijkstraRouterTT_ByProxi<E, V, PF, EC> {
+public:
+    /// Type of the function that is used to retrieve the edge effort.
+    typedef typename DijkstraRouterTT_ByProxi<E, V, PF, EC>::Operation Operation;
+
+    /** @brief Constructor
+     * @param[in] lookup The landmark table to use (not owned, may be 0)
+     */
+    AStarRouterTT_ByProxi(size_t noE, bool unbuildIsWarningOnly, EC* receiver, Operation operation,
+                          const LandmarkLookupTable<E> *lookup)
+            : DijkstraRouterTT_ByProxi<E, V, PF, EC>(noE, unbuildIsWarningOnly, receiver, operation),
+            myLookupTable(lookup) {}
+
+    SUMOReal getLowerBound(const E * const from, const E * const to) const {
+        if (myLookupTable==0) {
+            return 0;
+        }
+        return myLookupTable->lowerBound(from, to);
+    }
+
+private:
+    /// @brief The landmark table the lower bounds are taken from
+    const LandmarkLookupTable<E> * const myLookupTable;
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -0,0 +1,519 @@
+/****************************************************************************/
+/// @file    CHRouter.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: CHRouter.h $
+///
+// Shortest path search using a contraction hierarchy
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef CHRouter_h
+#define CHRouter_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <queue>
+#include <limits>
+#include <functional>
+#include <utility>
+#include <utils/common/MsgHandler.h>
+#include <utils/common/StdDefs.h>
+#include "SUMOAbstractRouter.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class CHRouter
+ * @brief Computes the shortest path using a contraction hierarchy
+ *
+ * The edges are ordered by their importance and contracted one after another
+ *  (the least important first): the paths leading over a contracted edge are
+ *  replaced by shortcuts between its neighbours unless a witness path of at
+ *  most the same effort exists. A query is then a bidirectional Dijkstra search
+ *  which only follows arcs to more important edges; the shortcuts of the found
+ *  path are unpacked afterwards.
+ *
+ * As in DijkstraRouterTTBase, the graph's nodes are the edges and the effort
+ *  of a path is the sum of the efforts of its edges except the last one.
+ *
+ * The hierarchy is built on the first query, using the efforts (and the
+ *  prohibitions given by the PF policy) for the query's vehicle at the query's
+ *  time. The efforts must not depend on the time, then, and the hierarchy is
+ *  only valid for vehicles with the same efforts and prohibitions. Once the
+ *  efforts change, the hierarchy has to be invalidated (see invalidate) so it
+ *  is rebuilt on the next query.
+ */
+template<class E, class V, class PF, class EC>
+class CHRouter : public SUMOAbstractRouter<E, V>, public PF {
+public:
+    /// Type of the function that is used to retrieve the edge effort.
+    typedef SUMOReal(EC::* Operation)(const E * const, const V * const, SUMOReal) const;
+
+    /// Constructor
+    CHRouter(size_t noE, bool unbuildIsWarningOnly, EC* receiver, Operation operation)
+            : myNoE(noE), myUnbuildIsWarningOnly(unbuildIsWarningOnly),
+            myReceiver(receiver), myOperation(operation), myAmValid(false),
+            myForwardInfos(noE), myBackwardInfos(noE) {}
+
+    /// Destructor
+    virtual ~CHRouter() { }
+
+
+    /// @brief Marks the hierarchy as outdated, so it is rebuilt on the next query
+    void invalidate() {
+        myAmValid = false;
+    }
+
+
+    /** @brief Builds the route between the given edges using the minimum effort
+        The hierarchy is built first if it is not valid */
+    virtual void compute(const E *from, const E *to, const V * const vehicle,
+                         SUMOTime msTime, std::vector<const E*> &into) {
+        if (!myAmValid) {
+            buildHierarchy(vehicle, msTime);
+        }
+        myForward.reset(myForwardInfos);
+        myBackward.reset(myBackwardInfos);
+        myForward.add(myForwardInfos, from->getNumericalID(), 0, NO_NODE, NO_NODE);
+        myBackward.add(myBackwardInfos, to->getNumericalID(), 0, NO_NODE, NO_NODE);
+        SUMOReal best = std::numeric_limits<SUMOReal>::max();
+        size_t meeting = NO_NODE;
+        // both searches go on until they can not find a better meeting edge
+        while (true) {
+            const bool forwardDone = myForward.done(myForwardInfos, best);
+            const bool backwardDone = myBackward.done(myBackwardInfos, best);
+            if (forwardDone && backwardDone) {
+                break;
+            }
+            const bool forward = backwardDone || (!forwardDone && myForward.top().first <= myBackward.top().first);
+            Search &search = forward ? myForward : myBackward;
+            std::vector<NodeInfo> &infos = forward ? myForwardInfos : myBackwardInfos;
+            std::vector<NodeInfo> &otherInfos = forward ? myBackwardInfos : myForwardInfos;
+            const size_t node = search.top().second;
+            search.pop();
+            const SUMOReal dist = infos[node].dist;
+            if (otherInfos[node].dist != std::numeric_limits<SUMOReal>::max() && dist + otherInfos[node].dist < best) {
+                best = dist + otherInfos[node].dist;
+                meeting = node;
+            }
+            const std::vector<Arc> &arcs = forward ? myUp[node] : myDown[node];
+            for (typename std::vector<Arc>::const_iterator i=arcs.begin(); i!=arcs.end(); ++i) {
+                search.add(infos, i->node, dist + i->weight, node, i->via);
+            }
+        }
+        if (meeting == NO_NODE) {
+            if (!myUnbuildIsWarningOnly) {
+                MsgHandler::getErrorInstance()->inform("No connection between '" + from->getID() + "' and '" + to->getID() + "' found.");
+            } else {
+                WRITE_WARNING("No connection between '" + from->getID() + "' and '" + to->getID() + "' found.");
+            }
+            return;
+        }
+        buildPathFrom(meeting, into);
+    }
+
+
+    SUMOReal recomputeCosts(const std::vector<const E*> &edges, const V * const v, SUMOTime msTime) throw() {
+        SUMOReal time = (SUMOReal) msTime / 1000.;
+        SUMOReal costs = 0;
+        for (typename std::vector<const E*>::const_iterator i=edges.begin(); i!=edges.end(); ++i) {
+            if (PF::operator()(*i, v)) {
+                return -1;
+            }
+            costs += getEffort(*i, v, (SUMOTime)(time + costs));
+        }
+        return costs;
+    }
+
+
+    inline SUMOReal getEffort(const E * const e, const V * const v, SUMOReal t) {
+        return (myReceiver->*myOperation)(e, v, t);
+    }
+
+
+    /** @brief Builds the hierarchy using the efforts for the given vehicle at the given time
+     * @param[in] vehicle The vehicle to retrieve the efforts and prohibitions for
+     * @param[in] msTime The time to retrieve the efforts for
+     */
+    void buildHierarchy(const V * const vehicle, SUMOTime msTime) {
+        SUMOReal time = (SUMOReal) msTime / 1000.;
+        myUp.assign(myNoE, std::vector<Arc>());
+        myDown.assign(myNoE, std::vector<Arc>());
+        myOut.assign(myNoE, std::vector<Arc>());
+        myIn.assign(myNoE, std::vector<Arc>());
+        myContracted.assign(myNoE, false);
+        myContractedNeighbours.assign(myNoE, 0);
+        myWitnessInfos.assign(myNoE, NodeInfo());
+        // the graph to contract; as in the Dijkstra search, a prohibited edge is only entered as first edge
+        for (size_t i=0; i<myNoE; ++i) {
+            const E * const edge = E::dictionary(i);
+            if (edge == 0) {
+                continue;
+            }
+            const SUMOReal effort = getEffort(edge, vehicle, time);
+            const unsigned int length_size = edge->getNoFollowing();
+            for (unsigned int j=0; j<length_size; j++) {
+                const E* const follower = edge->getFollower(j);
+                if (!PF::operator()(follower, vehicle)) {
+                    addArc(i, follower->getNumericalID(), effort, NO_NODE);
+                }
+            }
+        }
+        // contract the edges, the one with the least priority first; priorities are updated lazily
+        typedef std::pair<int, size_t> Entry;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+        std::vector<Arc> shortcuts;
+        for (size_t i=0; i<myNoE; ++i) {
+            queue.push(Entry(getPriority(i, shortcuts), i));
+        }
+        while (!queue.empty()) {
+            const size_t node = queue.top().second;
+            queue.pop();
+            const int priority = getPriority(node, shortcuts);
+            if (!queue.empty() && priority > queue.top().first) {
+                queue.push(Entry(priority, node));
+                continue;
+            }
+            contract(node, shortcuts);
+        }
+        // the contraction graph is not needed any longer
+        std::vector<std::vector<Arc> >().swap(myOut);
+        std::vector<std::vector<Arc> >().swap(myIn);
+        std::vector<NodeInfo>().swap(myWitnessInfos);
+        myAmValid = true;
+    }
+
+
+private:
+    /// @brief Marks unset nodes
+    static const size_t NO_NODE = (size_t) -1;
+
+    /**
+     * @struct Arc
+     * @brief An arc of the hierarchy; a shortcut if it is given a node it leads over
+     */
+    struct Arc {
+        Arc(size_t n, SUMOReal w, size_t v) : node(n), weight(w), via(v) {}
+        /// @brief The node the arc leads to (or comes from if it is an incoming arc)
+        size_t node;
+        /// @brief The effort along the arc
+        SUMOReal weight;
+        /// @brief The contracted node the shortcut leads over (NO_NODE for an original arc)
+        size_t via;
+    };
+
+    /**
+     * @struct NodeInfo
+     * @brief The search state of a node
+     */
+    struct NodeInfo {
+        NodeInfo() : dist(std::numeric_limits<SUMOReal>::max()), prev(NO_NODE), via(NO_NODE) {}
+        /// @brief The effort to reach the node
+        SUMOReal dist;
+        /// @brief The node the node was reached from
+        size_t prev;
+        /// @brief The node the arc the node was reached over leads over
+        size_t via;
+    };
+
+    /**
+     * @class Search
+     * @brief A Dijkstra search which resets only the nodes it has reached
+     */
+    class Search {
+    public:
+        typedef std::pair<SUMOReal, size_t> Entry;
+
+        /// @brief Resets the nodes reached by the last search
+        void reset(std::vector<NodeInfo> &infos) {
+            for (typename std::vector<size_t>::const_iterator i=myFound.begin(); i!=myFound.end(); ++i) {
+                infos[*i] = NodeInfo();
+            }
+            myFound.clear();
+            myFrontier = std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> >();
+        }
+
+        /// @brief Lowers the effort to reach the node if the given one is smaller
+        void add(std::vector<NodeInfo> &infos, size_t node, SUMOReal dist, size_t prev, size_t via) {
+            NodeInfo &info = infos[node];
+            if (dist < info.dist) {
+                if (info.dist == std::numeric_limits<SUMOReal>::max()) {
+                    myFound.push_back(node);
+                }
+                info.dist = dist;
+                info.prev = prev;
+                info.via = via;
+                myFrontier.push(Entry(dist, node));
+            }
+        }
+
+        /// @brief Returns whether no node with an effort below the given one is left
+        bool done(const std::vector<NodeInfo> &infos, SUMOReal bound) {
+            // drop outdated entries
+            while (!myFrontier.empty() && myFrontier.top().first > infos[myFrontier.top().second].dist) {
+                myFrontier.pop();
+            }
+            return myFrontier.empty() || myFrontier.top().first >= bound;
+        }
+
+        /// @brief Returns the frontier's node with the least effort
+        const Entry &top() const {
+            return myFrontier.top();
+        }
+
+        /// @brief Removes the frontier's node with the least effort
+        void pop() {
+            myFrontier.pop();
+        }
+
+    private:
+        /// @brief The frontier
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > myFrontier;
+
+        /// @brief The nodes reached by the search
+        std::vector<size_t> myFound;
+    };
+
+
+    /// @brief Adds the arc to the contraction graph or lowers the weight of an existing one
+    void addArc(size_t from, size_t to, SUMOReal weight, size_t via) {
+        if (from == to) {
+            return;
+        }
+        std::vector<Arc> &out = myOut[from];
+        for (typename std::vector<Arc>::iterator i=out.begin(); i!=out.end(); ++i) {
+            if (i->node == to) {
+                if (weight < i->weight) {
+                    i->weight = weight;
+                    i->via = via;
+                    std::vector<Arc> &in = myIn[to];
+                    for (typename std::vector<Arc>::iterator j=in.begin(); j!=in.end(); ++j) {
+                        if (j->node == from) {
+                            j->weight = weight;
+                            j->via = via;
+                        }
+                    }
+                }
+                return;
+            }
+        }
+        out.push_back(Arc(to, weight, via));
+        myIn[to].push_back(Arc(from, weight, via));
+    }
+
+
+    /** @brief Computes the shortcuts needed when contracting the node
+     * @param[in] node The node to contract
+     * @param[filled] shortcuts The shortcuts (with the node they start at as via)
+     */
+    void computeShortcuts(size_t node, std::vector<Arc> &shortcuts) {
+        shortcuts.clear();
+        const std::vector<Arc> &in = myIn[node];
+        const std::vector<Arc> &out = myOut[node];
+        SUMOReal maxOut = 0;
+        for (typename std::vector<Arc>::const_iterator j=out.begin(); j!=out.end(); ++j) {
+            if (!myContracted[j->node]) {
+                maxOut = MAX2(maxOut, j->weight);
+            }
+        }
+        for (typename std::vector<Arc>::const_iterator i=in.begin(); i!=in.end(); ++i) {
+            if (myContracted[i->node]) {
+                continue;
+            }
+            witnessSearch(i->node, node, i->weight + maxOut);
+            for (typename std::vector<Arc>::const_iterator j=out.begin(); j!=out.end(); ++j) {
+                if (!myContracted[j->node] && j->node != i->node
+                        && myWitnessInfos[j->node].dist > i->weight + j->weight) {
+                    shortcuts.push_back(Arc(j->node, i->weight + j->weight, i->node));
+                }
+            }
+        }
+    }
+
+
+    /** @brief Searches the efforts from the given node avoiding the contracted one
+     * @param[in] start The node to start at
+     * @param[in] avoid The node to contract
+     * @param[in] bound The effort up to which witnesses are searched
+     */
+    void witnessSearch(size_t start, size_t avoid, SUMOReal bound) {
+        myWitness.reset(myWitnessInfos);
+        myWitness.add(myWitnessInfos, start, 0, NO_NODE, NO_NODE);
+        unsigned int settled = 0;
+        while (!myWitness.done(myWitnessInfos, bound) && settled < MAX_WITNESS_SETTLED) {
+            const size_t node = myWitness.top().second;
+            myWitness.pop();
+            ++settled;
+            const SUMOReal dist = myWitnessInfos[node].dist;
+            const std::vector<Arc> &out = myOut[node];
+            for (typename std::vector<Arc>::const_iterator i=out.begin(); i!=out.end(); ++i) {
+                if (i->node != avoid && !myContracted[i->node]) {
+                    myWitness.add(myWitnessInfos, i->node, dist + i->weight, node, NO_NODE);
+                }
+            }
+        }
+    }
+
+
+    /// @brief Returns the contraction priority of the node (the edge difference plus the contracted neighbours)
+    int getPriority(size_t node, std::vector<Arc> &shortcuts) {
+        computeShortcuts(node, shortcuts);
+        int degree = 0;
+        for (typename std::vector<Arc>::const_iterator i=myIn[node].begin(); i!=myIn[node].end(); ++i) {
+            degree += myContracted[i->node] ? 0 : 1;
+        }
+        for (typename std::vector<Arc>::const_iterator i=myOut[node].begin(); i!=myOut[node].end(); ++i) {
+            degree += myContracted[i->node] ? 0 : 1;
+        }
+        return (int) shortcuts.size() - degree + myContractedNeighbours[node];
+    }
+
+
+    /// @brief Contracts the node, moving its arcs to more important nodes into the hierarchy
+    void contract(size_t node, std::vector<Arc> &shortcuts) {
+        computeShortcuts(node, shortcuts);
+        for (typename std::vector<Arc>::const_iterator i=myOut[node].begin(); i!=myOut[node].end(); ++i) {
+            if (!myContracted[i->node]) {
+                myUp[node].push_back(*i);
+                myContractedNeighbours[i->node]++;
+            }
+        }
+        for (typename std::vector<Arc>::const_iterator i=myIn[node].begin(); i!=myIn[node].end(); ++i) {
+            if (!myContracted[i->node]) {
+                myDown[node].push_back(*i);
+                myContractedNeighbours[i->node]++;
+            }
+        }
+        myContracted[node] = true;
+        for (typename std::vector<Arc>::const_iterator i=shortcuts.begin(); i!=shortcuts.end(); ++i) {
+            addArc(i->via, i->node, i->weight, node);
+        }
+        std::vector<Arc>().swap(myOut[node]);
+        std::vector<Arc>().swap(myIn[node]);
+    }
+
+
+    /// @brief Returns the node the arc between the given nodes leads over
+    size_t getVia(const std::vector<Arc> &arcs, size_t node) const {
+        for (typename std::vector<Arc>::const_iterator i=arcs.begin(); i!=arcs.end(); ++i) {
+            if (i->node == node) {
+                return i->via;
+            }
+        }
+        return NO_NODE;
+    }
+
+
+    /// @brief Appends the edges of the arc between the given nodes (without the first one)
+    void unpack(size_t from, size_t to, size_t via, std::vector<const E*> &into) const {
+        if (via == NO_NODE) {
+            into.push_back(E::dictionary(to));
+            return;
+        }
+        // both arcs of a shortcut lead to more important nodes than the one it leads over
+        unpack(from, via, getVia(myDown[via], from), into);
+        unpack(via, to, getVia(myUp[via], to), into);
+    }
+
+
+    /// @brief Builds the path over the given meeting node
+    void buildPathFrom(size_t meeting, std::vector<const E *> &into) const {
+        std::vector<size_t> forward;
+        for (size_t node=meeting; node!=NO_NODE; node=myForwardInfos[node].prev) {
+            forward.push_back(node);
+        }
+        into.push_back(E::dictionary(forward.back()));
+        for (size_t i=forward.size()-1; i>0; --i) {
+            unpack(forward[i], forward[i-1], myForwardInfos[forward[i-1]].via, into);
+        }
+        for (size_t node=meeting; myBackwardInfos[node].prev!=NO_NODE; node=myBackwardInfos[node].prev) {
+            unpack(node, myBackwardInfos[node].prev, myBackwardInfos[node].via, into);
+        }
+    }
+
+
+private:
+    /// @brief The number of edges
+    size_t myNoE;
+
+    bool myUnbuildIsWarningOnly;
+
+    /// @brief The object the action is directed to.
+    EC* myReceiver;
+
+    /// @brief The object's operation to perform.
+    Operation myOperation;
+
+    /// @brief Whether the hierarchy is built and valid
+    bool myAmValid;
+
+    /// @name The hierarchy
+    /// @{
+
+    /// @brief The arcs from each node to more important ones
+    std::vector<std::vector<Arc> > myUp;
+
+    /// @brief The arcs from more important nodes to each node (given by their origin)
+    std::vector<std::vector<Arc> > myDown;
+    /// @}
+
+    /// @name The graph during the contraction
+    /// @{
+
+    /// @brief The outgoing and the incoming arcs of the nodes not yet contracted
+    std::vector<std::vector<Arc> > myOut, myIn;
+
+    /// @brief Whether a node is contracted
+    std::vector<bool> myContracted;
+
+    /// @brief The number of contracted neighbours of each node
+    std::vector<int> myContractedNeighbours;
+
+    /// @brief The search for witness paths
+    Search myWitness;
+    std::vector<NodeInfo> myWitnessInfos;
+    /// @}
+
+    /// @brief The searches of a query
+    Search myForward, myBackward;
+    std::vector<NodeInfo> myForwardInfos, myBackwardInfos;
+
+    /// @brief The number of nodes a witness search settles at most
+    static const unsigned int MAX_WITNESS_SETTLED = 500;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    CHRouter(const CHRouter&);
+
+    /// @brief Invalidated assignment operator.
+    CHRouter& operator=(const CHRouter&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -35,6 +35,9 @@
 #include <set>
 #include <limits>
 #include <algorithm>
+#include <deque>
+#include <iterator>
+#include <cassert>
 #include <utils/common/InstancePool.h>
 #include <utils/common/MsgHandler.h>
 #include <utils/common/StdDefs.h>
@@ -64,7 +67,7 @@ class DijkstraRouterTTBase : public SUMOAbstractRouter<E, V>, public PF {
 public:
     /// Constructor
     DijkstraRouterTTBase(size_t noE, bool unbuildIsWarningOnly)
-            : myUnbuildIsWarningOnly(unbuildIsWarningOnly) {
+            : myUnbuildIsWarningOnly(unbuildIsWarningOnly), myReportUnbuild(true) {
         for (size_t i = 0; i < noE; i++) {
             myEdgeInfos.push_back(EdgeInfo(i));
         }
@@ -82,7 +85,9 @@ public:
     public:
         /// Constructor
         EdgeInfo(size_t id)
-                : edge(E::dictionary(id)), traveltime(0), prev(0), visited(false) {}
+                : edge(E::dictionary(id)), traveltime(std::numeric_limits<SUMOReal>::max()),
+                estimate(std::numeric_limits<SUMOReal>::max()), prev(0), visited(false),
+                heapIndex(NOT_IN_HEAP) {}
 
         /// The current edge
         const E *edge;
@@ -90,56 +95,81 @@ public:
         /// Effort to reach the edge
         SUMOReal traveltime;
 
+        /// Effort to reach the edge plus the lower bound of the effort from the edge to the destination
+        SUMOReal estimate;
+
         /// The previous edge
         EdgeInfo *prev;
 
-        /// The previous edge
+        /// Whether the edge was already taken from the frontier
         bool visited;
 
+        /// The edge's position within the frontier heap (NOT_IN_HEAP if it is not in the frontier)
+        size_t heapIndex;
+
     };
 
+    /// @brief The heap index of edges which are not in the frontier
+    static const size_t NOT_IN_HEAP = (size_t) -1;
+
     /**
-     * @class EdgeInfoByEffortComparator
+     * @class EdgeInfoByTTComparator
      * Class to compare (and so sort) nodes by their effort
      */
     class EdgeInfoByTTComparator {
     public:
         /// Comparing method
         bool operator()(const EdgeInfo *nod1, const EdgeInfo *nod2) const {
-            if (nod1->traveltime == nod2->traveltime) {
+            if (nod1->estimate == nod2->estimate) {
                 return nod1->edge->getNumericalID() > nod2->edge->getNumericalID();
             }
-            return nod1->traveltime>nod2->traveltime;
+            return nod1->estimate>nod2->estimate;
         }
     };
 
     virtual SUMOReal getEffort(const E * const e, const V * const v, SUMOReal t) = 0;
 
 
+    /** @brief Returns a lower bound of the effort to get from the first edge to the second
+     *
+     * The default implementation returns 0, so the search is a Dijkstra search;
+     *  routers which know better bounds perform an A* search this way. The bound
+     *  must not be larger than the effort of any path (std::numeric_limits<SUMOReal>::max()
+     *  signals that there is none).
+     */
+    virtual SUMOReal getLowerBound(const E * const, const E * const) const {
+        return 0;
+    }
+
+
     /** @brief Builds the route between the given edges using the minimum afford at the given time
         The definition of the afford depends on the wished routing scheme */
     virtual void compute(const E *from, const E *to, const V * const vehicle,
                          SUMOTime msTime, std::vector<const E*> &into) {
 
         SUMOReal time = (SUMOReal) msTime / 1000.;
-        for (typename std::vector<EdgeInfo>::iterator i=myEdgeInfos.begin(); i!=myEdgeInfos.end(); i++) {
-            (*i).traveltime = std::numeric_limits<SUMOReal>::max();
-            (*i).visited = false;
+        // reset only the edges the previous search has reached
+        for (typename std::vector<EdgeInfo*>::iterator i=myFound.begin(); i!=myFound.end(); i++) {
+            (*i)->traveltime = std::numeric_limits<SUMOReal>::max();
+            (*i)->estimate = std::numeric_limits<SUMOReal>::max();
+            (*i)->visited = false;
+            (*i)->heapIndex = NOT_IN_HEAP;
         }
+        myFound.clear();
         assert(from!=0&&to!=0);
         myFrontierList.clear();
         // add begin node
         EdgeInfo* const fromInfo = &(myEdgeInfos[from->getNumericalID()]);
         fromInfo->traveltime = 0;
+        fromInfo->estimate = getLowerBound(from, to);
         fromInfo->prev = 0;
-        myFrontierList.push_back(fromInfo);
+        myFound.push_back(fromInfo);
+        heapPush(fromInfo);
         // loop
         while (!myFrontierList.empty()) {
             // use the node with the minimal length
-            EdgeInfo * const minimumInfo = myFrontierList.front();
+            EdgeInfo * const minimumInfo = heapPop();
             const E * const minEdge = minimumInfo->edge;
-            pop_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
-            myFrontierList.pop_back();
             // check whether the destination node was already reached
             if (minEdge == to) {
                 buildPathFrom(minimumInfo, into);
@@ -159,19 +189,30 @@ public:
                 }
                 const SUMOReal oldEffort = followerInfo->traveltime;
                 if (!followerInfo->visited && traveltime < oldEffort) {
-                    followerInfo->traveltime = traveltime;
-                    followerInfo->prev = minimumInfo;
                     if (oldEffort == std::numeric_limits<SUMOReal>::max()) {
-                        myFrontierList.push_back(followerInfo);
-                        push_heap(myFrontierList.begin(), myFrontierList.end(), myComparator);
+                        const SUMOReal bound = getLowerBound(follower, to);
+                        if (bound == std::numeric_limits<SUMOReal>::max()) {
+                            // the destination can not be reached from here
+                            continue;
+                        }
+                        followerInfo->traveltime = traveltime;
+                        followerInfo->estimate = traveltime + bound;
+                        followerInfo->prev = minimumInfo;
+                        myFound.push_back(followerInfo);
+                        heapPush(followerInfo);
                     } else {
-                        push_heap(myFrontierList.begin(),
-                                  find(myFrontierList.begin(), myFrontierList.end(), followerInfo) + 1,
-                                  myComparator);
+                        // the bound is the same, so the estimate decreases as the travel time does
+                        followerInfo->estimate -= oldEffort - traveltime;
+                        followerInfo->traveltime = traveltime;
+                        followerInfo->prev = minimumInfo;
+                        heapSiftUp(followerInfo->heapIndex);
                     }
                 }
             }
         }
+        if (!myReportUnbuild) {
+            return;
+        }
         if (!myUnbuildIsWarningOnly) {
             MsgHandler::getErrorInstance()->inform("No connection between '" + from->getID() + "' and '" + to->getID() + "' found.");
         } else {
@@ -180,6 +221,16 @@ public:
     }
 
 
+    /** @brief Sets whether a missing connection is reported
+     *
+     * Routers used outside the simulation thread must not report, as the
+     *  message handlers are not thread-safe.
+     */
+    void setReportUnbuild(bool report) {
+        myReportUnbuild = report;
+    }
+
+
     SUMOReal recomputeCosts(const std::vector<const E*> &edges, const V * const v, SUMOTime msTime) throw() {
         SUMOReal time = (SUMOReal) msTime / 1000.;
         SUMOReal costs = 0;
@@ -203,17 +254,85 @@ public:
         std::copy(tmp.begin(), tmp.end(), std::back_inserter(edges));
     }
 
+protected:
+    /// @name Frontier heap operations
+    /// @{
+
+    /// @brief Adds the edge to the frontier
+    void heapPush(EdgeInfo *info) {
+        info->heapIndex = myFrontierList.size();
+        myFrontierList.push_back(info);
+        heapSiftUp(info->heapIndex);
+    }
+
+    /// @brief Removes and returns the edge with the minimal estimate
+    EdgeInfo *heapPop() {
+        EdgeInfo * const minimumInfo = myFrontierList.front();
+        minimumInfo->heapIndex = NOT_IN_HEAP;
+        EdgeInfo * const last = myFrontierList.back();
+        myFrontierList.pop_back();
+        if (!myFrontierList.empty()) {
+            myFrontierList[0] = last;
+            last->heapIndex = 0;
+            heapSiftDown(0);
+        }
+        return minimumInfo;
+    }
+
+    /// @brief Moves the edge at the given position up until its parent is not larger (after its estimate decreased)
+    void heapSiftUp(size_t index) {
+        EdgeInfo * const info = myFrontierList[index];
+        while (index>0) {
+            const size_t parent = (index-1) / 2;
+            if (!myComparator(myFrontierList[parent], info)) {
+                break;
+            }
+            myFrontierList[index] = myFrontierList[parent];
+            myFrontierList[index]->heapIndex = index;
+            index = parent;
+        }
+        myFrontierList[index] = info;
+        info->heapIndex = index;
+    }
+
+    /// @brief Moves the edge at the given position down until its children are not smaller
+    void heapSiftDown(size_t index) {
+        EdgeInfo * const info = myFrontierList[index];
+        const size_t size = myFrontierList.size();
+        while (2*index+1<size) {
+            size_t child = 2*index+1;
+            if (child+1<size && myComparator(myFrontierList[child], myFrontierList[child+1])) {
+                ++child;
+            }
+            if (!myComparator(info, myFrontierList[child])) {
+                break;
+            }
+            myFrontierList[index] = myFrontierList[child];
+            myFrontierList[index]->heapIndex = index;
+            index = child;
+        }
+        myFrontierList[index] = info;
+        info->heapIndex = index;
+    }
+    /// @}
+
 protected:
     /// The container of edge information
     std::vector<EdgeInfo> myEdgeInfos;
 
-    /// A container for reusage of the min edge heap
+    /// The frontier as binary heap, the edge with the minimal estimate first; EdgeInfo::heapIndex is kept up to date
     std::vector<EdgeInfo*> myFrontierList;
 
+    /// The edges reached by the last search (the ones to reset before the next search)
+    std::vector<EdgeInfo*> myFound;
+
     EdgeInfoByTTComparator myComparator;
 
     bool myUnbuildIsWarningOnly;
 
+    /// @brief Whether a missing connection is reported
+    bool myReportUnbuild;
+
 };
 
 
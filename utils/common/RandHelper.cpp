@@ -28,6 +28,8 @@
 #endif
 
 #include <utils/options/OptionsCont.h>
+#include <utils/iodevices/BinaryInputDevice.h>
+#include "FileHelpers.h"
 #include "RandHelper.h"
 #include <ctime>
 #include <cmath>
@@ -71,5 +73,27 @@ RandHelper::initRandGlobal() {
 }
 
 
+void
+RandHelper::saveState(std::ostream &os) throw() {
+    MTRand::uint32 state[MTRand::SAVE];
+    myRandomNumberGenerator.save(state);
+    for (int i=0; i<MTRand::SAVE; ++i) {
+        FileHelpers::writeUInt(os, (unsigned int) state[i]);
+    }
+}
+
+
+void
+RandHelper::loadState(BinaryInputDevice &bis) throw() {
+    MTRand::uint32 state[MTRand::SAVE];
+    for (int i=0; i<MTRand::SAVE; ++i) {
+        unsigned int value;
+        bis >> value;
+        state[i] = value;
+    }
+    myRandomNumberGenerator.load(state);
+}
+
+
 /****************************************************************************/
 
@@ -30,6 +30,7 @@
 #endif
 
 #include <vector>
+#include <iostream>
 #include <foreign/mersenne/MersenneTwister.h>
 
 
@@ -37,6 +38,7 @@
 // class declarations
 // ===========================================================================
 class OptionsCont;
+class BinaryInputDevice;
 
 
 // ===========================================================================
@@ -54,6 +56,12 @@ public:
     /// Reads the given random number options and initialises the random number geerator in accordance
     static void initRandGlobal();
 
+    /// Writes the state of the random number generator
+    static void saveState(std::ostream &os) throw();
+
+    /// Reads the state of the random number generator
+    static void loadState(BinaryInputDevice &bis) throw();
+
     /// Returns a random real number in [0, 1)
     static inline SUMOReal rand() {
         return (SUMOReal) RandHelper::myRandomNumberGenerator.randExc();
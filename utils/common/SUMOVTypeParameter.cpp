@@ -49,7 +49,7 @@ SUMOVTypeParameter::SUMOVTypeParameter() throw()
         defaultProbability(DEFAULT_VEH_PROB),
         speedFactor(DEFAULT_VEH_SPEEDFACTOR), speedDev(DEFAULT_VEH_SPEEDDEV),
         emissionClass(SVE_UNKNOWN), color(RGBColor::DEFAULT_COLOR),
-        vehicleClass(SVC_UNKNOWN), width(DEFAULT_VEH_GUIWIDTH),
+        vehicleClass(SVC_UNKNOWN), stripWidth(DEFAULT_VEH_STRIPWIDTH), width(DEFAULT_VEH_GUIWIDTH),
         offset(DEFAULT_VEH_GUIOFFSET), shape(DEFAULT_VEH_SHAPE),
         cfModel(-1),
         //cfModel(), lcModel(),
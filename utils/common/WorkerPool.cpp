@@ -0,0 +1,192 @@
+/****************************************************************************/
+/// @file    WorkerPool.cpp
+/// @author  agent
+/// @date    Fri, 16 Oct 2026
+/// @version $Id: WorkerPool.cpp $
+///
+// A fixed set of threads which process batches of independent tasks
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include "WorkerPool.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+WorkerPool::WorkerPool(unsigned int numWorkers) throw(ProcessError)
+        : myNumWorkers(numWorkers<1 ? 1 : numWorkers) {
+#ifndef WIN32
+    myBatchNumber = 0;
+    myRunning = 0;
+    myQuit = false;
+    pthread_mutex_init(&myLock, 0);
+    pthread_cond_init(&myBatchStarted, 0);
+    pthread_cond_init(&myBatchFinished, 0);
+    // the definitions must not move once the threads are started
+    myThreads.resize(myNumWorkers-1);
+    for (unsigned int i=0; i<myThreads.size(); ++i) {
+        myThreads[i].pool = this;
+        myThreads[i].index = i + 1;
+        if (pthread_create(&myThreads[i].thread, 0, &WorkerPool::threadMain, &myThreads[i])!=0) {
+            myThreads.resize(i);
+            stop();
+            throw ProcessError("Could not start worker thread.");
+        }
+    }
+#else
+    myNumWorkers = 1;
+#endif
+    myQueues.resize(myNumWorkers);
+}
+
+
+WorkerPool::~WorkerPool() throw() {
+    stop();
+}
+
+
+void
+WorkerPool::stop() throw() {
+#ifndef WIN32
+    pthread_mutex_lock(&myLock);
+    myQuit = true;
+    pthread_cond_broadcast(&myBatchStarted);
+    pthread_mutex_unlock(&myLock);
+    for (std::vector<ThreadDefinition>::iterator i=myThreads.begin(); i!=myThreads.end(); ++i) {
+        pthread_join((*i).thread, 0);
+    }
+    myThreads.clear();
+    pthread_cond_destroy(&myBatchFinished);
+    pthread_cond_destroy(&myBatchStarted);
+    pthread_mutex_destroy(&myLock);
+#endif
+}
+
+
+void
+WorkerPool::execute(const std::vector<Task*> &tasks) throw() {
+    if (myNumWorkers==1||tasks.size()<2) {
+        for (std::vector<Task*>::const_iterator i=tasks.begin(); i!=tasks.end(); ++i) {
+            (*i)->run();
+        }
+        return;
+    }
+#ifndef WIN32
+    pthread_mutex_lock(&myLock);
+    // split into contiguous blocks
+    const size_t blockSize = tasks.size() / myNumWorkers;
+    const size_t remainder = tasks.size() % myNumWorkers;
+    std::vector<Task*>::const_iterator task = tasks.begin();
+    for (unsigned int i=0; i<myNumWorkers; ++i) {
+        const size_t num = i<remainder ? blockSize + 1 : blockSize;
+        myQueues[i].insert(myQueues[i].end(), task, task + num);
+        task += num;
+    }
+    myRunning = myNumWorkers - 1;
+    ++myBatchNumber;
+    pthread_cond_broadcast(&myBatchStarted);
+    pthread_mutex_unlock(&myLock);
+    // take part in the work and wait for the others
+    work(0);
+    pthread_mutex_lock(&myLock);
+    while (myRunning>0) {
+        pthread_cond_wait(&myBatchFinished, &myLock);
+    }
+    pthread_mutex_unlock(&myLock);
+#endif
+}
+
+
+void
+WorkerPool::work(unsigned int index) throw() {
+    while (true) {
+#ifndef WIN32
+        pthread_mutex_lock(&myLock);
+#endif
+        Task *task = next(index);
+#ifndef WIN32
+        pthread_mutex_unlock(&myLock);
+#endif
+        if (task==0) {
+            return;
+        }
+        task->run();
+    }
+}
+
+
+WorkerPool::Task *
+WorkerPool::next(unsigned int index) throw() {
+    std::deque<Task*> &own = myQueues[index];
+    if (!own.empty()) {
+        Task *ret = own.front();
+        own.pop_front();
+        return ret;
+    }
+    for (unsigned int i=1; i<myNumWorkers; ++i) {
+        std::deque<Task*> &other = myQueues[(index+i)%myNumWorkers];
+        if (!other.empty()) {
+            Task *ret = other.back();
+            other.pop_back();
+            return ret;
+        }
+    }
+    return 0;
+}
+
+
+#ifndef WIN32
+void *
+WorkerPool::threadMain(void *arg) {
+    ThreadDefinition *def = static_cast<ThreadDefinition*>(arg);
+    WorkerPool *pool = def->pool;
+    unsigned int lastBatch = 0;
+    pthread_mutex_lock(&pool->myLock);
+    while (true) {
+        while (!pool->myQuit&&pool->myBatchNumber==lastBatch) {
+            pthread_cond_wait(&pool->myBatchStarted, &pool->myLock);
+        }
+        if (pool->myQuit) {
+            break;
+        }
+        lastBatch = pool->myBatchNumber;
+        pthread_mutex_unlock(&pool->myLock);
+        pool->work(def->index);
+        pthread_mutex_lock(&pool->myLock);
+        if (--pool->myRunning==0) {
+            pthread_cond_signal(&pool->myBatchFinished);
+        }
+    }
+    pthread_mutex_unlock(&pool->myLock);
+    return 0;
+}
+#endif
+
+
+
+/****************************************************************************/
+
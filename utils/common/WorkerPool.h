@@ -0,0 +1,192 @@
+/****************************************************************************/
+/// @file    WorkerPool.h
+/// @author  agent
+/// @date    Fri, 16 Oct 2026
+/// @version $Id: WorkerPool.h $
+///
+// A fixed set of threads which process batches of independent tasks
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef WorkerPool_h
+#define WorkerPool_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <vector>
+#include <deque>
+#include "UtilExceptions.h"
+
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class WorkerPool
+ * @brief A fixed set of threads which process batches of independent tasks
+ *
+ * A batch of tasks is given to "execute". The tasks are split into contiguous
+ *  blocks, one per worker, keeping neighbouring tasks on the same worker.
+ *  A worker which has finished its own block steals tasks from the end of
+ *  the other workers' blocks. The calling thread works as worker 0, and
+ *  "execute" returns after all tasks of the batch have been processed.
+ *
+ * The pool makes no assumption about the order in which tasks are run;
+ *  callers who need reproducible results must let the tasks write into
+ *  task-local storage only and merge it afterwards in a fixed order.
+ *
+ * Tasks must not throw. On WIN32, all tasks are run by the calling thread.
+ */
+class WorkerPool {
+public:
+    /**
+     * @class Task
+     * @brief A single unit of work
+     */
+    class Task {
+    public:
+        /// @brief Destructor
+        virtual ~Task() throw() { }
+
+        /// @brief Performs the work; called exactly once per batch
+        virtual void run() throw() = 0;
+
+    };
+
+
+public:
+    /** @brief Constructor
+     *
+     * Starts numWorkers-1 threads; the calling thread is the remaining worker.
+     *
+     * @param[in] numWorkers The number of workers to use
+     * @exception ProcessError If a thread could not be started
+     */
+    WorkerPool(unsigned int numWorkers) throw(ProcessError);
+
+
+    /// @brief Destructor; stops and joins the threads
+    ~WorkerPool() throw();
+
+
+    /** @brief Returns the number of workers including the calling thread
+     * @return The number of workers
+     */
+    unsigned int size() const throw() {
+        return myNumWorkers;
+    }
+
+
+    /** @brief Runs the given tasks and waits for their completion
+     * @param[in] tasks The tasks to run
+     */
+    void execute(const std::vector<Task*> &tasks) throw();
+
+
+private:
+    /** @brief Processes tasks until none are left
+     * @param[in] index The index of the working worker
+     */
+    void work(unsigned int index) throw();
+
+
+    /** @brief Returns the next task for the given worker
+     *
+     * Takes the first task of the worker's own queue or, if this is empty,
+     *  the last one of another worker's queue.
+     *
+     * @param[in] index The index of the asking worker
+     * @return The task to run, 0 if all queues are empty
+     */
+    Task *next(unsigned int index) throw();
+
+
+    /// @brief Stops and joins the started threads
+    void stop() throw();
+
+
+#ifndef WIN32
+    /// @brief The function run by the started threads
+    static void *threadMain(void *arg);
+
+
+    /**
+     * @struct ThreadDefinition
+     * @brief The information a started thread needs
+     */
+    struct ThreadDefinition {
+        /// @brief The pool the thread belongs to
+        WorkerPool *pool;
+        /// @brief The thread's worker index
+        unsigned int index;
+        /// @brief The thread handle
+        pthread_t thread;
+    };
+#endif
+
+
+private:
+    /// @brief The number of workers
+    unsigned int myNumWorkers;
+
+    /// @brief The tasks still to run, one queue per worker
+    std::vector<std::deque<Task*> > myQueues;
+
+#ifndef WIN32
+    /// @brief The started threads
+    std::vector<ThreadDefinition> myThreads;
+
+    /// @brief Guards the queues and the batch state
+    pthread_mutex_t myLock;
+
+    /// @brief Signals a new batch (or the end) to the threads
+    pthread_cond_t myBatchStarted;
+
+    /// @brief Signals the calling thread that all threads are done
+    pthread_cond_t myBatchFinished;
+
+    /// @brief Counts the batches; lets threads recognise a new one
+    unsigned int myBatchNumber;
+
+    /// @brief The number of started threads still working on the current batch
+    unsigned int myRunning;
+
+    /// @brief Whether the threads shall stop
+    bool myQuit;
+#endif
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    WorkerPool(const WorkerPool&);
+
+    /// @brief Invalidated assignment operator.
+    WorkerPool& operator=(const WorkerPool&);
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
@@ -87,13 +87,14 @@ operator>>(BinaryInputDevice &os, bool &b) throw() {
 
 BinaryInputDevice &
 operator>>(BinaryInputDevice &os, std::string &s) throw() {
-    unsigned int size;
+    unsigned int size = 0;
     os >> size;
-    if (size<BUF_MAX) {
-        os.myStream.read((char*) &os.myBuffer, sizeof(char)*size);
-        os.myBuffer[size] = 0;
-        s = std::string(os.myBuffer);
-        return os;
+    s = "";
+    while (size>0&&os.myStream.good()) {
+        const unsigned int chunk = size<BUF_MAX ? size : BUF_MAX;
+        os.myStream.read((char*) &os.myBuffer, sizeof(char)*chunk);
+        s.append(os.myBuffer, (size_t) os.myStream.gcount());
+        size -= chunk;
     }
     return os;
 }
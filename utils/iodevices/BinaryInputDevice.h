@@ -110,14 +110,13 @@ public:
     /** @brief Reads a string from the file (input operator)
      *
      * Reads the length of the string as an unsigned int, first.
-     *  Reads then the specified number of chars into "myBuffer".
-     * Please note that the buffer has a fixed size - longer strings
-     *  will cause an error.
+     *  Reads then the specified number of chars using "myBuffer"; strings
+     *  longer than the buffer are read piecewise. The string may contain
+     *  0-characters.
      *
      * @param[in, out] os The BinaryInputDevice to read the string from
      * @param[in] i The string to store the read value into
      * @return The used BinaryInputDevice for further processing
-     * @todo Use either a buffer with a flexible size or report an error if the buffer is too small!
      */
     friend BinaryInputDevice &operator>>(BinaryInputDevice &os, std::string &s) throw();
 
@@ -51,6 +51,7 @@
 // static member definitions
 // ===========================================================================
 OutputDevice::DeviceMap OutputDevice::myOutputDevices;
+std::string OutputDevice::myOutputDirectory;
 
 
 // ===========================================================================
@@ -78,7 +79,11 @@ OutputDevice::getDevice(const std::string &name,
             throw IOError("No port number given.");
         }
     } else {
-        dev = new OutputDevice_File(FileHelpers::checkForRelativity(name, base));
+        std::string fullName = FileHelpers::checkForRelativity(name, base);
+        if (myOutputDirectory!="") {
+            fullName = myOutputDirectory + "/" + fullName.substr(FileHelpers::getFilePath(fullName).length());
+        }
+        dev = new OutputDevice_File(fullName);
     }
     dev->setPrecision();
     dev->getOStream() << std::setiosflags(std::ios::fixed);
@@ -120,6 +125,23 @@ OutputDevice::closeAll() throw() {
 }
 
 
+void
+OutputDevice::flushAll() throw() {
+    for (DeviceMap::iterator i=myOutputDevices.begin(); i!=myOutputDevices.end(); ++i) {
+        i->second->flush();
+    }
+}
+
+
+void
+OutputDevice::redirectAll(const std::string &directory) throw(IOError) {
+    myOutputDirectory = directory;
+    for (DeviceMap::iterator i=myOutputDevices.begin(); i!=myOutputDevices.end(); ++i) {
+        i->second->redirect(directory);
+    }
+}
+
+
 
 // ===========================================================================
 // member method definitions
@@ -142,6 +164,16 @@ OutputDevice::close() throw() {
 }
 
 
+void
+OutputDevice::flush() throw() {
+    getOStream().flush();
+}
+
+
+void
+OutputDevice::redirect(const std::string &) throw(IOError) {}
+
+
 void
 OutputDevice::setPrecision(unsigned int precision) throw() {
     getOStream() << std::setprecision(precision);
@@ -121,6 +121,26 @@ public:
     /**  Closes all registered devices
      */
     static void closeAll() throw();
+
+
+    /** @brief Flushes all registered devices
+     *
+     * Has to be called before the process is forked, so that buffered
+     *  contents are not written by both processes.
+     */
+    static void flushAll() throw();
+
+
+    /** @brief Lets all file devices write into the given directory
+     *
+     * The contents written until the last call to flushAll are copied into
+     *  files of the same name within the directory and the devices continue
+     *  writing there. Devices built later on are placed into the directory, too.
+     *
+     * @param[in] directory The directory to write into
+     * @exception IOError If a file could not be built
+     */
+    static void redirectAll(const std::string &directory) throw(IOError);
     /// @}
 
 
@@ -230,6 +250,22 @@ protected:
     virtual std::ostream &getOStream() throw() = 0;
 
 
+    /** @brief Writes buffered contents
+     *
+     * Default implementation flushes the associated ostream.
+     */
+    virtual void flush() throw();
+
+
+    /** @brief Continues writing into the given directory
+     *
+     * Default implementation does nothing.
+     * @param[in] directory The directory to write into
+     * @exception IOError If the new output could not be built
+     */
+    virtual void redirect(const std::string &directory) throw(IOError);
+
+
     /** @brief Called after every write access.
      *
      * Default implementation does nothing.
@@ -246,6 +282,9 @@ private:
 
     /// @brief map from names to output devices
     static DeviceMap myOutputDevices;
+
+    /// @brief The directory new files are placed into ("" if not redirected)
+    static std::string myOutputDirectory;
     /// @}
 
 
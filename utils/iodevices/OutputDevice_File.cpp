@@ -28,6 +28,12 @@
 #endif
 
 #include <iostream>
+#include <vector>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+#include <utils/common/StdDefs.h>
+#include <utils/common/FileHelpers.h>
 #include "OutputDevice_File.h"
 
 #ifdef CHECK_MEMORY_LEAKS
@@ -35,11 +41,43 @@
 #endif // CHECK_MEMORY_LEAKS
 
 
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+size_t OutputDevice_File::myBufferSize = 0;
+unsigned int OutputDevice_File::myBufferNumber = 2;
+
+
 // ===========================================================================
 // method definitions
 // ===========================================================================
+#ifndef WIN32
+// ---------------------------------------------------------------------------
+// OutputDevice_File::WriteBuffer - methods
+// ---------------------------------------------------------------------------
+OutputDevice_File::WriteBuffer::int_type
+OutputDevice_File::WriteBuffer::overflow(int_type c) {
+    if (c!=traits_type::eof()) {
+        myDevice.handOver();
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+
+int
+OutputDevice_File::WriteBuffer::sync() {
+    return 0;
+}
+#endif
+
+
+// ---------------------------------------------------------------------------
+// OutputDevice_File - methods
+// ---------------------------------------------------------------------------
 OutputDevice_File::OutputDevice_File(const std::string &fullName) throw(IOError)
-        : myFileStream(0) {
+        : myFileStream(0), myFullName(fullName), myFlushedSize(0), myAsyncStream(0) {
 #ifdef WIN32
     if (fullName=="/dev/null") {
         myFileStream = new std::ofstream("NUL");
@@ -48,26 +86,220 @@ OutputDevice_File::OutputDevice_File(const std::string &fullName) throw(IOError)
         myFileStream = new std::ofstream("/dev/null");
 #endif
     } else {
-        myFileStream = new std::ofstream(fullName.c_str());
+        // binary outputs must not have their line ends converted
+        myFileStream = new std::ofstream(fullName.c_str(), std::ios::out|std::ios::binary);
     }
     if (!myFileStream->good()) {
         delete myFileStream;
         throw IOError("Could not build output file '" + fullName + "'.");
     }
+#ifndef WIN32
+    if (myBufferSize>0&&fullName!="nul"&&fullName!="NUL"&&fullName!="/dev/null") {
+        myBuffers.assign(myBufferNumber, std::vector<char>(myBufferSize));
+        myCurrentBuffer = 0;
+        for (unsigned int i=1; i<myBufferNumber; ++i) {
+            myFreeBuffers.push_back(i);
+        }
+        myWriteFailed = false;
+        try {
+            startWriter();
+        } catch (IOError &) {
+            delete myFileStream;
+            throw;
+        }
+        myWriteBuffer = new WriteBuffer(*this);
+        myWriteBuffer->setBuffer(&myBuffers[0][0], &myBuffers[0][0] + myBufferSize);
+        myAsyncStream = new std::ostream(myWriteBuffer);
+    }
+#endif
 }
 
 
 OutputDevice_File::~OutputDevice_File() throw() {
+#ifndef WIN32
+    if (myAsyncStream!=0) {
+        drain();
+        stopWriter();
+        delete myAsyncStream;
+        delete myWriteBuffer;
+    }
+#endif
     myFileStream->close();
     delete myFileStream;
 }
 
 
+void
+OutputDevice_File::setAsynchronous(size_t bufferSize, unsigned int bufferNumber) throw() {
+    myBufferSize = bufferSize;
+    myBufferNumber = MAX2(bufferNumber, (unsigned int) 2);
+}
+
+
+bool
+OutputDevice_File::ok() throw() {
+#ifndef WIN32
+    if (myAsyncStream!=0) {
+        pthread_mutex_lock(&myLock);
+        const bool failed = myWriteFailed;
+        pthread_mutex_unlock(&myLock);
+        return myAsyncStream->good() && !failed;
+    }
+#endif
+    return myFileStream->good();
+}
+
+
 std::ostream &
 OutputDevice_File::getOStream() throw() {
+    if (myAsyncStream!=0) {
+        return *myAsyncStream;
+    }
     return *myFileStream;
 }
 
 
+void
+OutputDevice_File::flush() throw() {
+#ifndef WIN32
+    if (myAsyncStream!=0) {
+        // the writer is idle afterwards
+        drain();
+    }
+#endif
+    myFileStream->flush();
+    myFlushedSize = (long) myFileStream->tellp();
+}
+
+
+void
+OutputDevice_File::redirect(const std::string &directory) throw(IOError) {
+    if (myFullName=="nul"||myFullName=="NUL"||myFullName=="/dev/null") {
+        return;
+    }
+#ifndef WIN32
+    // the writer thread is not copied into a forked process
+    const bool forked = myAsyncStream!=0 && myWriterProcess!=getpid();
+    if (myAsyncStream!=0 && !forked) {
+        drain();
+    }
+#endif
+    const std::string name = directory + "/" + myFullName.substr(FileHelpers::getFilePath(myFullName).length());
+    std::ofstream *strm = new std::ofstream(name.c_str(), std::ios::binary);
+    if (!strm->good()) {
+        delete strm;
+        throw IOError("Could not build output file '" + name + "'.");
+    }
+    // copy the contents written so far; the original may have grown meanwhile
+    std::ifstream written(myFullName.c_str(), std::ios::binary);
+    std::vector<char> buffer(65536);
+    long rest = myFlushedSize;
+    while (rest>0&&written.good()) {
+        written.read(&buffer[0], MIN2(rest, (long) buffer.size()));
+        strm->write(&buffer[0], written.gcount());
+        rest -= (long) written.gcount();
+    }
+    strm->copyfmt(*myFileStream);
+    delete myFileStream;
+    myFileStream = strm;
+    myFullName = name;
+#ifndef WIN32
+    if (forked) {
+        startWriter();
+    }
+#endif
+}
+
+
+#ifndef WIN32
+void
+OutputDevice_File::startWriter() throw(IOError) {
+    myWriting = false;
+    myQuit = false;
+    pthread_mutex_init(&myLock, 0);
+    pthread_cond_init(&myBufferFull, 0);
+    pthread_cond_init(&myBufferFree, 0);
+    if (pthread_create(&myWriter, 0, &OutputDevice_File::writerMain, this)!=0) {
+        pthread_cond_destroy(&myBufferFree);
+        pthread_cond_destroy(&myBufferFull);
+        pthread_mutex_destroy(&myLock);
+        throw IOError("Could not start the writer thread for '" + myFullName + "'.");
+    }
+    myWriterProcess = getpid();
+}
+
+
+void
+OutputDevice_File::stopWriter() throw() {
+    pthread_mutex_lock(&myLock);
+    myQuit = true;
+    pthread_cond_signal(&myBufferFull);
+    pthread_mutex_unlock(&myLock);
+    pthread_join(myWriter, 0);
+    pthread_cond_destroy(&myBufferFree);
+    pthread_cond_destroy(&myBufferFull);
+    pthread_mutex_destroy(&myLock);
+}
+
+
+void
+OutputDevice_File::handOver() throw() {
+    const size_t used = myWriteBuffer->getUsed();
+    if (used==0) {
+        return;
+    }
+    pthread_mutex_lock(&myLock);
+    myFullBuffers.push_back(std::make_pair(myCurrentBuffer, used));
+    pthread_cond_signal(&myBufferFull);
+    while (myFreeBuffers.empty()) {
+        pthread_cond_wait(&myBufferFree, &myLock);
+    }
+    myCurrentBuffer = myFreeBuffers.front();
+    myFreeBuffers.pop_front();
+    pthread_mutex_unlock(&myLock);
+    char *begin = &myBuffers[myCurrentBuffer][0];
+    myWriteBuffer->setBuffer(begin, begin + myBuffers[myCurrentBuffer].size());
+}
+
+
+void
+OutputDevice_File::drain() throw() {
+    handOver();
+    pthread_mutex_lock(&myLock);
+    while (!myFullBuffers.empty()||myWriting) {
+        pthread_cond_wait(&myBufferFree, &myLock);
+    }
+    pthread_mutex_unlock(&myLock);
+}
+
+
+void *
+OutputDevice_File::writerMain(void *arg) {
+    OutputDevice_File *device = static_cast<OutputDevice_File*>(arg);
+    pthread_mutex_lock(&device->myLock);
+    while (true) {
+        while (device->myFullBuffers.empty()&&!device->myQuit) {
+            pthread_cond_wait(&device->myBufferFull, &device->myLock);
+        }
+        if (device->myFullBuffers.empty()) {
+            break;
+        }
+        const std::pair<unsigned int, size_t> buffer = device->myFullBuffers.front();
+        device->myFullBuffers.pop_front();
+        device->myWriting = true;
+        pthread_mutex_unlock(&device->myLock);
+        device->myFileStream->write(&device->myBuffers[buffer.first][0], (std::streamsize) buffer.second);
+        pthread_mutex_lock(&device->myLock);
+        device->myWriting = false;
+        device->myWriteFailed |= !device->myFileStream->good();
+        device->myFreeBuffers.push_back(buffer.first);
+        pthread_cond_broadcast(&device->myBufferFree);
+    }
+    pthread_mutex_unlock(&device->myLock);
+    return 0;
+}
+#endif
+
+
 /****************************************************************************/
 
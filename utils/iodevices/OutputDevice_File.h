@@ -30,8 +30,17 @@
 #endif
 
 #include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <utility>
 #include "OutputDevice.h"
 
+#ifndef WIN32
+#include <pthread.h>
+#include <sys/types.h>
+#endif
+
 
 // ===========================================================================
 // class definitions
@@ -42,6 +51,15 @@
  *
  * Please note that the device gots responsible for the stream and deletes
  *  it (it should not be deleted elsewhere).
+ *
+ * If asynchronous writing is enabled (see setAsynchronous), the contents
+ *  are formatted into a fixed number of large buffers; a full buffer is
+ *  handed to a writer thread which writes it into the file while the
+ *  next buffer is filled. If no buffer is free, the writing thread waits
+ *  for the writer, so the memory used is bounded. Flushing the stream
+ *  (std::endl) does not write the buffer; "flush" writes all buffers and
+ *  waits for the writer, the destructor does so, too. On WIN32, the files
+ *  are always written synchronously.
  */
 class OutputDevice_File : public OutputDevice {
 public:
@@ -56,6 +74,19 @@ public:
     ~OutputDevice_File() throw();
 
 
+    /** @brief Sets whether files built later on are written asynchronously
+     * @param[in] bufferSize The size of the buffers in bytes, 0 for synchronous writing
+     * @param[in] bufferNumber The number of buffers per file (at least two are used)
+     */
+    static void setAsynchronous(size_t bufferSize, unsigned int bufferNumber) throw();
+
+
+    /** @brief Returns whether the device can be used
+     * @return Whether the stream is good and the writer did not fail
+     */
+    bool ok() throw();
+
+
 protected:
     /// @name Methods that override/implement OutputDevice-methods
     /// @{
@@ -64,13 +95,165 @@ protected:
      * @return The used stream
      */
     std::ostream &getOStream() throw();
+
+
+    /** @brief Flushes the stream and remembers the written size
+     */
+    void flush() throw();
+
+
+    /** @brief Continues writing into a file of the same name within the directory
+     *
+     * The contents written until the last flush are copied into the new file.
+     * @param[in] directory The directory to write into
+     * @exception IOError If the new file could not be built
+     */
+    void redirect(const std::string &directory) throw(IOError);
     /// @}
 
 
+private:
+#ifndef WIN32
+    /**
+     * @class WriteBuffer
+     * @brief The stream buffer formatting into the device's current buffer
+     */
+    class WriteBuffer : public std::streambuf {
+    public:
+        /** @brief Constructor
+         * @param[in] device The device to hand full buffers to
+         */
+        WriteBuffer(OutputDevice_File &device) throw()
+                : myDevice(device) {}
+
+
+        /** @brief Lets the stream write into the given memory
+         * @param[in] begin The begin of the buffer
+         * @param[in] end The end of the buffer
+         */
+        void setBuffer(char *begin, char *end) throw() {
+            setp(begin, end);
+        }
+
+
+        /** @brief Returns the number of bytes written into the current buffer
+         * @return The filled size of the buffer
+         */
+        size_t getUsed() const throw() {
+            return (size_t)(pptr() - pbase());
+        }
+
+
+    protected:
+        /// @brief Hands the full buffer over and continues with the next one
+        int_type overflow(int_type c);
+
+
+        /// @brief Does nothing; the buffers are written when full or when the device is flushed
+        int sync();
+
+
+    private:
+        /// @brief The device to hand full buffers to
+        OutputDevice_File &myDevice;
+
+    };
+
+
+    /** @brief Builds the buffers and starts the writer thread
+     * @exception IOError If the thread could not be started
+     */
+    void startWriter() throw(IOError);
+
+
+    /// @brief Stops the writer thread after it wrote all handed over buffers
+    void stopWriter() throw();
+
+
+    /** @brief Hands the current buffer to the writer and takes a free one
+     *
+     * Waits until a buffer is free.
+     */
+    void handOver() throw();
+
+
+    /// @brief Hands the current buffer to the writer and waits until all buffers are written
+    void drain() throw();
+
+
+    /// @brief The function run by the writer thread
+    static void *writerMain(void *arg);
+#endif
+
+
 private:
     /// The wrapped ofstream
     std::ofstream *myFileStream;
 
+    /// @brief The name of the written file
+    std::string myFullName;
+
+    /// @brief The number of bytes written until the last flush
+    long myFlushedSize;
+
+    /// @brief The stream formatting into the buffers (0 when writing synchronously)
+    std::ostream *myAsyncStream;
+
+#ifndef WIN32
+    /// @brief The stream buffer of myAsyncStream
+    WriteBuffer *myWriteBuffer;
+
+    /// @brief The buffers
+    std::vector<std::vector<char> > myBuffers;
+
+    /// @brief The buffers handed to the writer (index, filled size)
+    std::deque<std::pair<unsigned int, size_t> > myFullBuffers;
+
+    /// @brief The indices of the free buffers
+    std::deque<unsigned int> myFreeBuffers;
+
+    /// @brief The index of the buffer currently filled
+    unsigned int myCurrentBuffer;
+
+    /// @brief Whether the writer is writing a buffer
+    bool myWriting;
+
+    /// @brief Whether writing into the file failed
+    bool myWriteFailed;
+
+    /// @brief Whether the writer shall stop
+    bool myQuit;
+
+    /// @brief The writer thread
+    pthread_t myWriter;
+
+    /// @brief The process the writer thread was started within
+    pid_t myWriterProcess;
+
+    /// @brief The lock guarding the buffer queues
+    pthread_mutex_t myLock;
+
+    /// @brief Signalled when a buffer was handed to the writer
+    pthread_cond_t myBufferFull;
+
+    /// @brief Signalled when the writer wrote a buffer
+    pthread_cond_t myBufferFree;
+#endif
+
+    /// @brief The size of the buffers of files built later on (0 for synchronous writing)
+    static size_t myBufferSize;
+
+    /// @brief The number of buffers of files built later on
+    static unsigned int myBufferNumber;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    OutputDevice_File(const OutputDevice_File &src);
+
+    /// @brief Invalidated assignment operator.
+    OutputDevice_File &operator=(const OutputDevice_File &src);
+
 };
 
 
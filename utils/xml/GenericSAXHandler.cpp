@@ -34,6 +34,7 @@
 #include <utils/common/FileHelpers.h>
 #include "SUMOSAXAttributesImpl_Xerces.h"
 #include "XMLSubSys.h"
+#include "SAXBinaryCache.h"
 
 #ifdef CHECK_MEMORY_LEAKS
 #include <foreign/nvwa/debug_new.h>
@@ -45,7 +46,8 @@
 // ===========================================================================
 GenericSAXHandler::GenericSAXHandler(GenericSAXHandler::Tag *tags,
                                      GenericSAXHandler::Attr *attrs, const std::string &file) throw()
-        : myParentHandler(0), myParentIndicator(SUMO_TAG_NOTHING), myFileName(file) {
+        : myParentHandler(0), myParentIndicator(SUMO_TAG_NOTHING), myFileName(file),
+        myRecorder(0) {
     int i = 0;
     while (tags[i].key != SUMO_TAG_NOTHING) {
         myTagMap.insert(TagMap::value_type(tags[i].name, tags[i].key));
@@ -80,6 +82,12 @@ GenericSAXHandler::getFileName() const throw() {
 }
 
 
+void
+GenericSAXHandler::setRecorder(SAXBinaryCache *recorder) throw() {
+    myRecorder = recorder;
+}
+
+
 XMLCh*
 GenericSAXHandler::convert(const std::string &name) const throw() {
     size_t len = name.length();
@@ -107,8 +115,14 @@ GenericSAXHandler::startElement(const XMLCh* const /*uri*/,
         if (!FileHelpers::isAbsolute(file)) {
             file = FileHelpers::getConfigurationRelative(getFileName(), file);
         }
+        if (myRecorder!=0) {
+            myRecorder->recordInclude(file);
+        }
         XMLSubSys::runParser(*this, file);
     } else {
+        if (myRecorder!=0) {
+            myRecorder->recordStartElement(name, attrs);
+        }
         myStartElement(element, na);
     }
 }
@@ -136,6 +150,9 @@ GenericSAXHandler::endElement(const XMLCh* const /*uri*/,
         }
         buf[pos] = 0;
 
+        if (myRecorder!=0) {
+            myRecorder->recordCharacters(name, buf);
+        }
         // call user handler
         try {
             myCharacters(element, buf);
@@ -146,6 +163,9 @@ GenericSAXHandler::endElement(const XMLCh* const /*uri*/,
         delete[] buf;
     }
     if (element != SUMO_TAG_INCLUDE) {
+        if (myRecorder!=0) {
+            myRecorder->recordEndElement(name);
+        }
         myEndElement(element);
         if (myParentHandler && myParentIndicator == element) {
             XMLSubSys::setHandler(*myParentHandler);
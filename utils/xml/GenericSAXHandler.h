@@ -41,6 +41,12 @@
 #include "SUMOSAXAttributes.h"
 
 
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class SAXBinaryCache;
+
+
 // ===========================================================================
 // xerces 2.2 compatibility
 // ===========================================================================
@@ -76,6 +82,9 @@ using namespace XERCES_CPP_NAMESPACE;
  * Basically, GenericSAXHandler is not derived within SUMO directly, but via SUMOSAXHandler
  *  which knows all tags/attributes used by SUMO. It is still kept separate for
  *  an easier maintainability and later extensions.
+ *
+ * If a recorder is set, the parsed elements are additionally passed to it
+ *  (see SAXBinaryCache) which allows to replay them without parsing.
  */
 class GenericSAXHandler : public DefaultHandler {
 public:
@@ -195,6 +204,17 @@ public:
     const std::string &getFileName() const throw();
 
 
+    /**
+     * @brief Sets the cache which records the parsed elements
+     *
+     * Included files are recorded in place, the include elements themselves
+     *  are not recorded.
+     *
+     * @param[in] recorder The recording cache, 0 to stop recording
+     */
+    void setRecorder(SAXBinaryCache *recorder) throw();
+
+
 protected:
     /**
      * @brief Callback method for an opening tag to implement by derived classes
@@ -285,6 +305,13 @@ private:
     GenericSAXHandler* myParentHandler;
     SumoXMLTag myParentIndicator;
 
+    /// @brief The cache recording the parsed elements (if any)
+    SAXBinaryCache *myRecorder;
+
+
+    /// @brief The binary cache replays the elements using the callback methods
+    friend class SAXBinaryCache;
+
 
 };
 
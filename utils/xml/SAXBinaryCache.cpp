@@ -0,0 +1,450 @@
+/****************************************************************************/
+/// @file    SAXBinaryCache.cpp
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: SAXBinaryCache.cpp $
+///
+// Records parsed XML elements into a binary file and replays them
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <utils/common/TplConvert.h>
+#include <utils/common/FileHelpers.h>
+#include <utils/common/MsgHandler.h>
+#include "GenericSAXHandler.h"
+#include "SUMOSAXAttributesImpl_Binary.h"
+#include "XMLSubSys.h"
+#include "SAXBinaryCache.h"
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// static member definitions
+// ===========================================================================
+const char SAXBinaryCache::FORMAT_MAGIC[8] = { 'S', 'U', 'M', 'O', 'S', 'A', 'X', 'B' };
+const unsigned int SAXBinaryCache::FORMAT_VERSION = 2;
+
+
+// ===========================================================================
+// method definitions
+// ===========================================================================
+SAXBinaryCache::SAXBinaryCache(std::ostream &strm) throw()
+        : myStrm(strm), myDepth(0) {}
+
+
+SAXBinaryCache::~SAXBinaryCache() throw() {}
+
+
+bool
+SAXBinaryCache::runParser(GenericSAXHandler &handler, const std::string &file,
+                          const std::string &cacheFile) throw() {
+    unsigned int size, checksum;
+    if (!computeChecksum(file, size, checksum)) {
+        // let the parser report the problem
+        return XMLSubSys::runParser(handler, file);
+    }
+    // replay the cache if it matches the file and the files it includes
+    size_t headerSize = 0;
+    size_t cacheSize = 0;
+    const char *buffer = mapFile(cacheFile, cacheSize);
+    if (buffer!=0) {
+        if (checkHeader(buffer, cacheSize, size, checksum, headerSize)) {
+            std::string prevFile = handler.getFileName();
+            handler.setFileName(file);
+            try {
+                Replayer replayer(handler, cacheFile);
+                if (!replayer.replay(buffer+headerSize, buffer+cacheSize)) {
+                    throw ProcessError("The cache '" + cacheFile + "' is incomplete; please remove it.");
+                }
+            } catch (ProcessError &e) {
+                if (std::string(e.what())!=std::string("Process Error") && std::string(e.what())!=std::string("")) {
+                    MsgHandler::getErrorInstance()->inform(e.what());
+                }
+            } catch (...) {
+                MsgHandler::getErrorInstance()->inform("An error occured.");
+            }
+            handler.setFileName(prevFile);
+            unmapFile(buffer, cacheSize);
+            return !MsgHandler::getErrorInstance()->wasInformed();
+        }
+        unmapFile(buffer, cacheSize);
+    }
+    // parse the file and record the elements
+    //  the included files are known after parsing only, so the records are
+    //  written into a temporary file and appended to the header afterwards
+    const std::string recordFile = cacheFile + ".records";
+    std::ofstream strm(recordFile.c_str(), std::ios::out|std::ios::binary);
+    if (!strm.good()) {
+        MsgHandler::getWarningInstance()->inform("Could not write the cache '" + cacheFile + "'.");
+        return XMLSubSys::runParser(handler, file);
+    }
+    SAXBinaryCache recorder(strm);
+    handler.setRecorder(&recorder);
+    const bool ok = XMLSubSys::runParser(handler, file);
+    handler.setRecorder(0);
+    recorder.recordEndOfFile();
+    strm.close();
+    bool written = false;
+    const std::string tmpFile = cacheFile + ".tmp";
+    if (ok && strm.good()) {
+        std::ofstream out(tmpFile.c_str(), std::ios::out|std::ios::binary);
+        out.write(FORMAT_MAGIC, sizeof(FORMAT_MAGIC));
+        FileHelpers::writeUInt(out, FORMAT_VERSION);
+        FileHelpers::writeUInt(out, size);
+        FileHelpers::writeUInt(out, checksum);
+        const std::vector<std::string> &includes = recorder.getIncludes();
+        FileHelpers::writeUInt(out, (unsigned int) includes.size());
+        written = true;
+        for (std::vector<std::string>::const_iterator i=includes.begin(); i!=includes.end()&&written; ++i) {
+            unsigned int includeSize, includeChecksum;
+            written = computeChecksum(*i, includeSize, includeChecksum);
+            FileHelpers::writeUInt(out, (unsigned int) (*i).length());
+            out.write((*i).c_str(), (*i).length()+1);
+            FileHelpers::writeUInt(out, includeSize);
+            FileHelpers::writeUInt(out, includeChecksum);
+        }
+        std::ifstream records(recordFile.c_str(), std::ios::in|std::ios::binary);
+        if (written && records.good()) {
+            out << records.rdbuf();
+        }
+        records.close();
+        out.close();
+        written = written && records.good() && out.good();
+    }
+    std::remove(recordFile.c_str());
+    if (written) {
+        std::remove(cacheFile.c_str());
+        if (std::rename(tmpFile.c_str(), cacheFile.c_str())==0) {
+            return true;
+        }
+    }
+    std::remove(tmpFile.c_str());
+    if (ok) {
+        MsgHandler::getWarningInstance()->inform("Could not write the cache '" + cacheFile + "'.");
+    }
+    return ok;
+}
+
+
+void
+SAXBinaryCache::recordStartElement(const std::string &name, const Attributes &attrs) throw() {
+    const unsigned int tag = getNameIndex(name);
+    const unsigned int number = (unsigned int) attrs.getLength();
+    std::vector<unsigned int> names(number);
+    for (unsigned int i=0; i<number; ++i) {
+        names[i] = getNameIndex(TplConvert<XMLCh>::_2str(attrs.getQName(i)));
+    }
+    ++myDepth;
+    FileHelpers::writeByte(myStrm, RECORD_START);
+    FileHelpers::writeUInt(myStrm, tag);
+    FileHelpers::writeUInt(myStrm, number);
+    for (unsigned int i=0; i<number; ++i) {
+        FileHelpers::writeUInt(myStrm, names[i]);
+        writeString(TplConvert<XMLCh>::_2str(attrs.getValue(i)));
+    }
+}
+
+
+void
+SAXBinaryCache::recordCharacters(const std::string &name, const char *chars) throw() {
+    const unsigned int tag = getNameIndex(name);
+    FileHelpers::writeByte(myStrm, RECORD_CHARACTERS);
+    FileHelpers::writeUInt(myStrm, tag);
+    writeString(chars);
+}
+
+
+void
+SAXBinaryCache::recordEndElement(const std::string &name) throw() {
+    const unsigned int tag = getNameIndex(name);
+    --myDepth;
+    FileHelpers::writeByte(myStrm, RECORD_END);
+    FileHelpers::writeUInt(myStrm, tag);
+}
+
+
+void
+SAXBinaryCache::recordInclude(const std::string &file) throw() {
+    myIncludes.push_back(file);
+}
+
+
+void
+SAXBinaryCache::recordEndOfFile() throw() {
+    FileHelpers::writeByte(myStrm, RECORD_END_OF_FILE);
+}
+
+
+unsigned int
+SAXBinaryCache::getNameIndex(const std::string &name) throw() {
+    std::map<std::string, unsigned int>::const_iterator i = myNameIndices.find(name);
+    if (i!=myNameIndices.end()) {
+        return (*i).second;
+    }
+    const unsigned int index = (unsigned int) myNameIndices.size();
+    myNameIndices[name] = index;
+    FileHelpers::writeByte(myStrm, RECORD_NAME);
+    writeString(name);
+    return index;
+}
+
+
+void
+SAXBinaryCache::writeString(const std::string &value) throw() {
+    FileHelpers::writeUInt(myStrm, (unsigned int) value.length());
+    myStrm.write(value.c_str(), value.length()+1);
+}
+
+
+bool
+SAXBinaryCache::computeChecksum(const std::string &file, unsigned int &size,
+                                unsigned int &checksum) throw() {
+    std::ifstream strm(file.c_str(), std::ios::in|std::ios::binary);
+    if (!strm.good()) {
+        return false;
+    }
+    // FNV-1a
+    checksum = 2166136261u;
+    size = 0;
+    char buffer[65536];
+    while (strm.good()) {
+        strm.read(buffer, sizeof(buffer));
+        const std::streamsize read = strm.gcount();
+        for (std::streamsize i=0; i<read; ++i) {
+            checksum = (checksum ^ (unsigned char) buffer[i]) * 16777619u;
+        }
+        size += (unsigned int) read;
+    }
+    return strm.eof();
+}
+
+
+bool
+SAXBinaryCache::checkHeader(const char *buffer, size_t cacheSize,
+                            unsigned int size, unsigned int checksum,
+                            size_t &headerSize) throw() {
+    const char *pos = buffer;
+    const char *end = buffer + cacheSize;
+    unsigned int header[4];
+    if (cacheSize<sizeof(FORMAT_MAGIC)+sizeof(header)||memcmp(pos, FORMAT_MAGIC, sizeof(FORMAT_MAGIC))!=0) {
+        return false;
+    }
+    pos += sizeof(FORMAT_MAGIC);
+    memcpy(header, pos, sizeof(header));
+    pos += sizeof(header);
+    if (header[0]!=FORMAT_VERSION||header[1]!=size||header[2]!=checksum) {
+        return false;
+    }
+    for (unsigned int i=0; i<header[3]; ++i) {
+        unsigned int length;
+        if (pos+sizeof(unsigned int)>end) {
+            return false;
+        }
+        memcpy(&length, pos, sizeof(unsigned int));
+        pos += sizeof(unsigned int);
+        unsigned int values[2];
+        if (pos+length+1+sizeof(values)>end||pos[length]!=0) {
+            return false;
+        }
+        const std::string file(pos, length);
+        pos += length + 1;
+        memcpy(values, pos, sizeof(values));
+        pos += sizeof(values);
+        unsigned int includeSize, includeChecksum;
+        if (!computeChecksum(file, includeSize, includeChecksum)
+                ||includeSize!=values[0]||includeChecksum!=values[1]) {
+            return false;
+        }
+    }
+    headerSize = pos - buffer;
+    return true;
+}
+
+
+SAXBinaryCache::Replayer::Replayer(GenericSAXHandler &handler, const std::string &source) throw()
+        : myHandler(handler),
+        myCorruptMessage("The binary elements of '" + source + "' are corrupt.") {
+    for (std::map<SumoXMLAttr, std::string>::const_iterator i=handler.myPredefinedTagsMML.begin(); i!=handler.myPredefinedTagsMML.end(); ++i) {
+        myAttrKeys[(*i).second] = (*i).first;
+    }
+}
+
+
+SAXBinaryCache::Replayer::~Replayer() throw() {}
+
+
+bool
+SAXBinaryCache::Replayer::replay(const char *buffer, const char *end) throw(ProcessError) {
+    std::vector<SUMOSAXAttributesImpl_Binary::Attribute> attrs;
+    const char *pos = buffer;
+    while (pos<end) {
+        const unsigned char type = (unsigned char) *pos++;
+        if (type==RECORD_END_OF_FILE) {
+            return true;
+        }
+        unsigned int index = 0;
+        if (type!=RECORD_NAME) {
+            if (pos+sizeof(unsigned int)>end) {
+                throw ProcessError(myCorruptMessage);
+            }
+            memcpy(&index, pos, sizeof(unsigned int));
+            pos += sizeof(unsigned int);
+            if (index>=myNames.size()) {
+                throw ProcessError(myCorruptMessage);
+            }
+        }
+        switch (type) {
+        case RECORD_NAME: {
+            unsigned int length;
+            if (pos+sizeof(unsigned int)>end) {
+                throw ProcessError(myCorruptMessage);
+            }
+            memcpy(&length, pos, sizeof(unsigned int));
+            pos += sizeof(unsigned int);
+            if (pos+length>=end||pos[length]!=0) {
+                throw ProcessError(myCorruptMessage);
+            }
+            myNames.push_back(std::string(pos, length));
+            myTags.push_back(myHandler.convertTag(myNames.back()));
+            std::map<std::string, SumoXMLAttr>::const_iterator i = myAttrKeys.find(myNames.back());
+            myKeys.push_back(i!=myAttrKeys.end() ? (*i).second : SUMO_ATTR_NOTHING);
+            pos += length + 1;
+            break;
+        }
+        case RECORD_START: {
+            unsigned int number;
+            if (pos+sizeof(unsigned int)>end) {
+                throw ProcessError(myCorruptMessage);
+            }
+            memcpy(&number, pos, sizeof(unsigned int));
+            pos += sizeof(unsigned int);
+            attrs.clear();
+            for (unsigned int i=0; i<number; ++i) {
+                unsigned int values[2];
+                if (pos+sizeof(values)>end) {
+                    throw ProcessError(myCorruptMessage);
+                }
+                memcpy(values, pos, sizeof(values));
+                pos += sizeof(values);
+                if (values[0]>=myNames.size()||pos+values[1]>=end||pos[values[1]]!=0) {
+                    throw ProcessError(myCorruptMessage);
+                }
+                SUMOSAXAttributesImpl_Binary::Attribute attr;
+                attr.key = myKeys[values[0]];
+                attr.name = myNames[values[0]].c_str();
+                attr.value = pos;
+                attrs.push_back(attr);
+                pos += values[1] + 1;
+            }
+            SUMOSAXAttributesImpl_Binary na(attrs, myHandler.myPredefinedTagsMML);
+            myHandler.myStartElement(myTags[index], na);
+            break;
+        }
+        case RECORD_CHARACTERS: {
+            unsigned int length;
+            if (pos+sizeof(unsigned int)>end) {
+                throw ProcessError(myCorruptMessage);
+            }
+            memcpy(&length, pos, sizeof(unsigned int));
+            pos += sizeof(unsigned int);
+            if (pos+length>=end||pos[length]!=0) {
+                throw ProcessError(myCorruptMessage);
+            }
+            myHandler.myCharacters(myTags[index], std::string(pos, length));
+            pos += length + 1;
+            break;
+        }
+        case RECORD_END:
+            myHandler.myEndElement(myTags[index]);
+            break;
+        default:
+            throw ProcessError(myCorruptMessage);
+        }
+    }
+    return false;
+}
+
+
+const char *
+SAXBinaryCache::mapFile(const std::string &file, size_t &size) throw() {
+#ifdef WIN32
+    std::ifstream strm(file.c_str(), std::ios::in|std::ios::binary);
+    if (!strm.good()) {
+        return 0;
+    }
+    strm.seekg(0, std::ios::end);
+    size = (size_t) strm.tellg();
+    strm.seekg(0, std::ios::beg);
+    char *buffer = new char[size+1];
+    strm.read(buffer, size);
+    if (!strm.good()) {
+        delete[] buffer;
+        return 0;
+    }
+    return buffer;
+#else
+    const int fd = open(file.c_str(), O_RDONLY);
+    if (fd<0) {
+        return 0;
+    }
+    struct stat info;
+    if (fstat(fd, &info)!=0||info.st_size==0) {
+        close(fd);
+        return 0;
+    }
+    size = (size_t) info.st_size;
+    void *buffer = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (buffer==MAP_FAILED) {
+        return 0;
+    }
+    return (const char*) buffer;
+#endif
+}
+
+
+void
+SAXBinaryCache::unmapFile(const char *buffer, size_t size) throw() {
+#ifdef WIN32
+    delete[] buffer;
+#else
+    munmap((void*) buffer, size);
+#endif
+}
+
+
+
+/****************************************************************************/
+
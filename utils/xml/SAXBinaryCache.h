@@ -0,0 +1,332 @@
+/****************************************************************************/
+/// @file    SAXBinaryCache.h
+/// @author  agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: SAXBinaryCache.h $
+///
+// Records parsed XML elements into a binary file and replays them
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef SAXBinaryCache_h
+#define SAXBinaryCache_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <map>
+#include <deque>
+#include <vector>
+#include <ostream>
+#include <xercesc/sax2/Attributes.hpp>
+#include <utils/common/UtilExceptions.h>
+#include "SUMOXMLDefinitions.h"
+
+
+// ===========================================================================
+// xerces 2.2 compatibility
+// ===========================================================================
+#if defined(XERCES_HAS_CPP_NAMESPACE)
+using namespace XERCES_CPP_NAMESPACE;
+#endif
+
+
+// ===========================================================================
+// class declarations
+// ===========================================================================
+class GenericSAXHandler;
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SAXBinaryCache
+ * @brief Records parsed XML elements into a binary file and replays them
+ *
+ * Parsing large inputs (mainly the network) with Xerces dominates the
+ *  start-up. "runParser" therefore keeps a binary copy of the elements a
+ *  handler received: if the cache matches the XML file, the elements are
+ *  replayed into the handler's callbacks directly from the mapped cache
+ *  file; otherwise the XML file is parsed as usual and the cache is
+ *  (re)written on the fly.
+ *
+ * The cache starts with a magic number, the format version and the size
+ *  and checksum of the XML file it was built from, followed by the names,
+ *  sizes and checksums of all files this one includes; the cache is only
+ *  replayed if none of them has changed. The header is followed by a
+ *  sequence of records: the first occurence of a tag or attribute name
+ *  defines it, later records refer to names by their index. Strings are
+ *  stored 0-terminated so that the values can be used in place. Names are
+ *  resolved when replaying, so the cache stays valid if the enums in
+ *  SUMOXMLDefinitions change.
+ *
+ * The cache is written in the machine's byte order and is not meant to be
+ *  exchanged between machines; a cache of another version is rebuilt.
+ *
+ * The record stream may also be used in memory: a recorder may write into
+ *  any stream and a Replayer replays consecutive parts of the stream as
+ *  long as they are given in order (MSRouteLoader hands the elements
+ *  parsed by a loading thread over this way).
+ */
+class SAXBinaryCache {
+public:
+    /**
+     * @class Replayer
+     * @brief Replays recorded elements into a handler
+     *
+     * The names defined by the replayed records are kept, so a stream may be
+     *  replayed in parts.
+     */
+    class Replayer {
+    public:
+        /** @brief Constructor
+         * @param[in] handler The handler to assign the elements to
+         * @param[in] source The name of the stream's source (for error messages)
+         */
+        Replayer(GenericSAXHandler &handler, const std::string &source) throw();
+
+
+        /// @brief Destructor
+        ~Replayer() throw();
+
+
+        /** @brief Replays the records within the given buffer
+         *
+         * @param[in] buffer The begin of the records
+         * @param[in] end The end of the records
+         * @return Whether the end of the stream was reached
+         * @exception ProcessError If the records are corrupt or the handler fails
+         */
+        bool replay(const char *buffer, const char *end) throw(ProcessError);
+
+
+    private:
+        /// @brief The handler to assign the elements to
+        GenericSAXHandler &myHandler;
+
+        /// @brief The message to report on corrupt records
+        const std::string myCorruptMessage;
+
+        /// @brief The attribute ids by their names
+        std::map<std::string, SumoXMLAttr> myAttrKeys;
+
+        /// @brief The names defined so far (a deque keeps the strings in place)
+        std::deque<std::string> myNames;
+
+        /// @brief The elements belonging to the defined names
+        std::vector<SumoXMLTag> myTags;
+
+        /// @brief The attributes belonging to the defined names
+        std::vector<SumoXMLAttr> myKeys;
+
+
+    private:
+        /// @brief Invalidated copy constructor.
+        Replayer(const Replayer &src);
+
+        /// @brief Invalidated assignment operator.
+        Replayer &operator=(const Replayer &src);
+
+    };
+
+
+public:
+    /**
+     * @brief Runs the given handler on the given file using the given cache
+     *
+     * @param[in] handler The handler to assign the elements to
+     * @param[in] file The XML file to load
+     * @param[in] cacheFile The cache of the XML file
+     * @return Whether loading was successful
+     * @see XMLSubSys::runParser
+     */
+    static bool runParser(GenericSAXHandler &handler, const std::string &file,
+                          const std::string &cacheFile) throw();
+
+
+    /** @brief Constructor
+     * @param[in] strm The stream to record into
+     */
+    SAXBinaryCache(std::ostream &strm) throw();
+
+
+    /// @brief Destructor
+    ~SAXBinaryCache() throw();
+
+
+    /** @brief Returns the number of recorded elements which are not yet closed
+     * @return The current depth within the recorded document
+     */
+    unsigned int getDepth() const throw() {
+        return myDepth;
+    }
+
+
+    /** @brief Returns the files included by the recorded document
+     * @return The included files in the order they were read
+     */
+    const std::vector<std::string> &getIncludes() const throw() {
+        return myIncludes;
+    }
+
+
+    /// @name recording methods called by GenericSAXHandler
+    /// @{
+
+    /** @brief Records an opening tag
+     * @param[in] name The name of the element
+     * @param[in] attrs The element's attributes
+     */
+    void recordStartElement(const std::string &name, const Attributes &attrs) throw();
+
+
+    /** @brief Records the characters of an element
+     * @param[in] name The name of the element
+     * @param[in] chars The complete embedded character string
+     */
+    void recordCharacters(const std::string &name, const char *chars) throw();
+
+
+    /** @brief Records a closing tag
+     * @param[in] name The name of the element
+     */
+    void recordEndElement(const std::string &name) throw();
+
+
+    /** @brief Records that the given file is included at this place
+     *
+     * The included file's elements are recorded in place; the file itself is
+     *  only remembered so that the cache's header may describe it.
+     * @param[in] file The (resolved) name of the included file
+     */
+    void recordInclude(const std::string &file) throw();
+
+
+    /** @brief Closes the recorded stream
+     *
+     * A Replayer stops at this record and reports that the end was reached.
+     */
+    void recordEndOfFile() throw();
+    /// @}
+
+
+private:
+    /// @brief The types of records
+    enum RecordType {
+        /// @brief Closes the cache
+        RECORD_END_OF_FILE = 0,
+        /// @brief Defines the next tag or attribute name
+        RECORD_NAME,
+        /// @brief An opening tag with its attributes
+        RECORD_START,
+        /// @brief The characters of an element
+        RECORD_CHARACTERS,
+        /// @brief A closing tag
+        RECORD_END
+    };
+
+
+    /** @brief Returns the index of the given name, recording its definition if it is new
+     * @param[in] name The tag or attribute name
+     * @return The name's index
+     */
+    unsigned int getNameIndex(const std::string &name) throw();
+
+
+    /** @brief Writes a 0-terminated string
+     * @param[in] value The string to write
+     */
+    void writeString(const std::string &value) throw();
+
+
+    /** @brief Computes the size and the checksum of the given file
+     * @param[in] file The file to read
+     * @param[out] size The (truncated) size of the file
+     * @param[out] checksum The checksum of the file's contents
+     * @return Whether the file could be read
+     */
+    static bool computeChecksum(const std::string &file, unsigned int &size,
+                                unsigned int &checksum) throw();
+
+
+    /** @brief Checks whether the header of a mapped cache matches the current files
+     *
+     * @param[in] buffer The mapped cache
+     * @param[in] cacheSize The size of the mapped cache
+     * @param[in] size The size of the main XML file
+     * @param[in] checksum The checksum of the main XML file
+     * @param[out] headerSize The size of the header if it matches
+     * @return Whether the cache was built from the files as they are now
+     */
+    static bool checkHeader(const char *buffer, size_t cacheSize,
+                            unsigned int size, unsigned int checksum,
+                            size_t &headerSize) throw();
+
+
+    /** @brief Maps the given file into memory
+     * @param[in] file The file to map
+     * @param[out] size The size of the file
+     * @return The file's contents, 0 if it could not be mapped
+     */
+    static const char *mapFile(const std::string &file, size_t &size) throw();
+
+
+    /** @brief Releases a file mapped by "mapFile"
+     * @param[in] buffer The file's contents
+     * @param[in] size The size of the file
+     */
+    static void unmapFile(const char *buffer, size_t size) throw();
+
+
+private:
+    /// @brief The stream to record into
+    std::ostream &myStrm;
+
+    /// @brief The indices of the names recorded so far
+    std::map<std::string, unsigned int> myNameIndices;
+
+    /// @brief The number of recorded elements which are not yet closed
+    unsigned int myDepth;
+
+    /// @brief The files included by the recorded document
+    std::vector<std::string> myIncludes;
+
+    /// @brief The magic number the cache starts with
+    static const char FORMAT_MAGIC[8];
+
+    /// @brief The version of the format; caches of other versions are rebuilt
+    static const unsigned int FORMAT_VERSION;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    SAXBinaryCache(const SAXBinaryCache &src);
+
+    /// @brief Invalidated assignment operator.
+    SAXBinaryCache &operator=(const SAXBinaryCache &src);
+
+
+};
+
+
+#endif
+
+/****************************************************************************/
+
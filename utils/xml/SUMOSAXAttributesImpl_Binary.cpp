@@ -0,0 +1,160 @@
+/****************************************************************************/
+/// @file    SUMOSAXAttributesImpl_Binary.cpp
+/// @author  Daniel Krajzewicz, agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: SUMOSAXAttributesImpl_Binary.cpp $
+///
+// Encapsulated attributes replayed from a binary cache
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <cstring>
+#include "SUMOSAXAttributesImpl_Binary.h"
+#include <utils/common/TplConvert.h>
+#include <utils/common/TplConvertSec.h>
+
+#ifdef CHECK_MEMORY_LEAKS
+#include <foreign/nvwa/debug_new.h>
+#endif // CHECK_MEMORY_LEAKS
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+SUMOSAXAttributesImpl_Binary::SUMOSAXAttributesImpl_Binary(const std::vector<Attribute> &attrs,
+        const std::map<SumoXMLAttr, std::string> &predefinedTagsMML) throw()
+        : myAttrs(attrs), myPredefinedTagsMML(predefinedTagsMML) { }
+
+
+SUMOSAXAttributesImpl_Binary::~SUMOSAXAttributesImpl_Binary() throw() {
+}
+
+
+bool
+SUMOSAXAttributesImpl_Binary::hasAttribute(SumoXMLAttr id) const throw() {
+    return getAttributeValue(id)!=0;
+}
+
+
+bool
+SUMOSAXAttributesImpl_Binary::getBool(SumoXMLAttr id) const throw(EmptyData, BoolFormatException) {
+    return TplConvert<char>::_2bool(getAttributeValue(id));
+}
+
+
+bool
+SUMOSAXAttributesImpl_Binary::getBoolSecure(SumoXMLAttr id, bool val) const throw(EmptyData) {
+    return TplConvertSec<char>::_2boolSec(getAttributeValue(id), val);
+}
+
+
+int
+SUMOSAXAttributesImpl_Binary::getInt(SumoXMLAttr id) const throw(EmptyData, NumberFormatException) {
+    return TplConvert<char>::_2int(getAttributeValue(id));
+}
+
+
+int
+SUMOSAXAttributesImpl_Binary::getIntSecure(SumoXMLAttr id,
+        int def) const throw(EmptyData, NumberFormatException) {
+    return TplConvertSec<char>::_2intSec(getAttributeValue(id), def);
+}
+
+
+std::string
+SUMOSAXAttributesImpl_Binary::getString(SumoXMLAttr id) const throw(EmptyData) {
+    return TplConvert<char>::_2str(getAttributeValue(id));
+}
+
+
+std::string
+SUMOSAXAttributesImpl_Binary::getStringSecure(SumoXMLAttr id,
+        const std::string &str) const throw(EmptyData) {
+    return TplConvertSec<char>::_2strSec(getAttributeValue(id), str);
+}
+
+
+SUMOReal
+SUMOSAXAttributesImpl_Binary::getFloat(SumoXMLAttr id) const throw(EmptyData, NumberFormatException) {
+    return TplConvert<char>::_2SUMOReal(getAttributeValue(id));
+}
+
+
+SUMOReal
+SUMOSAXAttributesImpl_Binary::getFloatSecure(SumoXMLAttr id,
+        SUMOReal def) const throw(EmptyData, NumberFormatException) {
+    return TplConvertSec<char>::_2SUMORealSec(getAttributeValue(id), def);
+}
+
+
+const char *
+SUMOSAXAttributesImpl_Binary::getAttributeValue(SumoXMLAttr id) const throw() {
+    for (std::vector<Attribute>::const_iterator i=myAttrs.begin(); i!=myAttrs.end(); ++i) {
+        if ((*i).key==id) {
+            return (*i).value;
+        }
+    }
+    return 0;
+}
+
+
+const char *
+SUMOSAXAttributesImpl_Binary::getAttributeValue(const std::string &id) const throw() {
+    for (std::vector<Attribute>::const_iterator i=myAttrs.begin(); i!=myAttrs.end(); ++i) {
+        if (std::strcmp((*i).name, id.c_str())==0) {
+            return (*i).value;
+        }
+    }
+    return 0;
+}
+
+
+SUMOReal
+SUMOSAXAttributesImpl_Binary::getFloat(const std::string &id) const throw(EmptyData, NumberFormatException) {
+    return TplConvert<char>::_2SUMOReal(getAttributeValue(id));
+}
+
+
+bool
+SUMOSAXAttributesImpl_Binary::hasAttribute(const std::string &id) const throw() {
+    return getAttributeValue(id)!=0;
+}
+
+
+std::string
+SUMOSAXAttributesImpl_Binary::getStringSecure(const std::string &id,
+        const std::string &str) const throw() {
+    return TplConvertSec<char>::_2strSec(getAttributeValue(id), str);
+}
+
+
+std::string
+SUMOSAXAttributesImpl_Binary::getName(SumoXMLAttr attr) const throw() {
+    if (myPredefinedTagsMML.find(attr)==myPredefinedTagsMML.end()) {
+        return "?";
+    }
+    return myPredefinedTagsMML.find(attr)->second;
+}
+
+
+/****************************************************************************/
+
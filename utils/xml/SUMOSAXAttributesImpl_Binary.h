@@ -0,0 +1,257 @@
+/****************************************************************************/
+/// @file    SUMOSAXAttributesImpl_Binary.h
+/// @author  Daniel Krajzewicz, agent
+/// @date    Sat, 17 Oct 2026
+/// @version $Id: SUMOSAXAttributesImpl_Binary.h $
+///
+// Encapsulated attributes replayed from a binary cache
+/****************************************************************************/
+// SUMO, Simulation of Urban MObility; see http://sumo.sourceforge.net/
+// Copyright 2001-2010 DLR (http://www.dlr.de/) and contributors
+/****************************************************************************/
+//
+//   This program is free software; you can redistribute it and/or modify
+//   it under the terms of the GNU General Public License as published by
+//   the Free Software Foundation; either version 2 of the License, or
+//   (at your option) any later version.
+//
+/****************************************************************************/
+#ifndef SUMOSAXAttributesImpl_Binary_h
+#define SUMOSAXAttributesImpl_Binary_h
+
+
+// ===========================================================================
+// included modules
+// ===========================================================================
+#ifdef _MSC_VER
+#include <windows_config.h>
+#else
+#include <config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <map>
+#include "SUMOSAXAttributes.h"
+
+
+// ===========================================================================
+// class definitions
+// ===========================================================================
+/**
+ * @class SUMOSAXAttributesImpl_Binary
+ * @brief Encapsulated attributes replayed from a binary cache
+ *
+ * The attribute names and values are not copied; they point into the
+ *  cache's buffer which has to outlive the attributes. Elements have
+ *  only a few attributes, so they are searched linearly.
+ *
+ * @see SUMOSAXAttributes
+ * @see SAXBinaryCache
+ */
+class SUMOSAXAttributesImpl_Binary : public SUMOSAXAttributes {
+public:
+    /**
+     * @struct Attribute
+     * @brief A single attribute as stored within the cache
+     */
+    struct Attribute {
+        /// @brief The numerical representation of the attribute (SUMO_ATTR_NOTHING if not known)
+        SumoXMLAttr key;
+        /// @brief The 0-terminated name of the attribute
+        const char *name;
+        /// @brief The 0-terminated value of the attribute
+        const char *value;
+    };
+
+
+    /** @brief Constructor
+     *
+     * @param[in] attrs The encapsulated attributes
+     * @param[in] predefinedTagsMML Map of attribute ids to their (readable) string-representation
+     */
+    SUMOSAXAttributesImpl_Binary(const std::vector<Attribute> &attrs,
+                                 const std::map<SumoXMLAttr, std::string> &predefinedTagsMML) throw();
+
+
+    /// @brief Destructor
+    virtual ~SUMOSAXAttributesImpl_Binary() throw();
+
+
+
+    /// @name methods for retrieving attribute values
+    /// @{
+
+    /** @brief Returns the information whether the named (by its enum-value) attribute is within the current list
+     *
+     * @param[in] id The id of the searched attribute
+     * @return Whether the attribute is within the attributes
+     */
+    bool hasAttribute(SumoXMLAttr id) const throw();
+
+
+    /**
+     * @brief Returns the bool-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @return The attribute's value as a bool, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     * @exception BoolFormatException If the attribute value can not be parsed to a bool
+     */
+    bool getBool(SumoXMLAttr id) const throw(EmptyData, BoolFormatException);
+
+    /**
+     * @brief Returns the bool-value of the named (by its enum-value) attribute or the given value if the attribute is not known
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @param[in] def The default value to return if the attribute is not in attributes
+     * @return The attribute's value as a bool, if it could be read and parsed
+     * @exception EmptyData If the attribute value is an empty string
+     */
+    bool getBoolSecure(SumoXMLAttr id, bool def) const throw(EmptyData);
+
+
+    /**
+     * @brief Returns the int-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @return The attribute's value as an int, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     * @exception NumberFormatException If the attribute value can not be parsed to an int
+     */
+    int getInt(SumoXMLAttr id) const throw(EmptyData, NumberFormatException);
+
+    /**
+     * @brief Returns the int-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @param[in] def The default value to return if the attribute is not in attributes
+     * @return The attribute's value as an int, if it could be read and parsed
+     * @exception EmptyData If the attribute value is an empty string
+     * @exception NumberFormatException If the attribute value can not be parsed to an int
+     */
+    int getIntSecure(SumoXMLAttr id, int def) const throw(EmptyData, NumberFormatException);
+
+
+    /**
+     * @brief Returns the string-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @return The attribute's value as a string, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     */
+    std::string getString(SumoXMLAttr id) const throw(EmptyData);
+
+    /**
+     * @brief Returns the string-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @param[in] def The default value to return if the attribute is not in attributes
+     * @return The attribute's value as a string, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     */
+    std::string getStringSecure(SumoXMLAttr id,
+                                const std::string &def) const throw(EmptyData);
+
+
+    /**
+     * @brief Returns the SUMOReal-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @return The attribute's value as a float, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     * @exception NumberFormatException If the attribute value can not be parsed to an SUMOReal
+     */
+    SUMOReal getFloat(SumoXMLAttr id) const throw(EmptyData, NumberFormatException);
+
+    /**
+     * @brief Returns the SUMOReal-value of the named (by its enum-value) attribute
+     *
+     * @param[in] id The id of the attribute to return the value of
+     * @param[in] def The default value to return if the attribute is not in attributes
+     * @return The attribute's value as a float, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     * @exception NumberFormatException If the attribute value can not be parsed to an SUMOReal
+     */
+    SUMOReal getFloatSecure(SumoXMLAttr id, SUMOReal def) const throw(EmptyData, NumberFormatException);
+
+
+    /**
+     * @brief Returns the information whether the named attribute is within the current list
+     */
+    bool hasAttribute(const std::string &id) const throw();
+
+
+    /**
+     * @brief Returns the SUMOReal-value of the named attribute
+     *
+     * @param[in] id The name of the attribute to return the value of
+     * @return The attribute's value as a float, if it could be read and parsed
+     * @exception EmptyData If the attribute is not known or the attribute value is an empty string
+     * @exception NumberFormatException If the attribute value can not be parsed to an SUMOReal
+     */
+    SUMOReal getFloat(const std::string &id) const throw(EmptyData, NumberFormatException);
+
+
+    /**
+     * @brief Returns the string-value of the named attribute
+     *
+     * @param[in] id The name of the attribute to return the value of
+     * @param[in] def The default value to return if the attribute is not in attributes
+     * @return The attribute's value as a string, if it could be read and parsed
+     */
+    std::string getStringSecure(const std::string &id,
+                                const std::string &def) const throw();
+    //}
+
+
+    /** @brief Converts the given attribute id into a man readable string
+     *
+     * Returns a "?" if the attribute is not known.
+     *
+     * @param[in] attr The id of the attribute to return the name of
+     * @return The name of the described attribute
+     */
+    std::string getName(SumoXMLAttr attr) const throw();
+
+
+private:
+    /** @brief Returns the value of the attribute with the given id
+     *
+     * @param[in] id The id of the attribute to retrieve the value of
+     * @return The attribute's value, 0 if it is not within the attributes
+     */
+    const char *getAttributeValue(SumoXMLAttr id) const throw();
+
+
+    /** @brief Returns the value of the attribute with the given name
+     *
+     * @param[in] id The name of the attribute to retrieve the value of
+     * @return The attribute's value, 0 if it is not within the attributes
+     */
+    const char *getAttributeValue(const std::string &id) const throw();
+
+
+private:
+    /// @brief The encapsulated attributes
+    const std::vector<Attribute> &myAttrs;
+
+    /// @brief Map of attribute ids to their (readable) string-representation
+    const std::map<SumoXMLAttr, std::string> &myPredefinedTagsMML;
+
+
+private:
+    /// @brief Invalidated copy constructor.
+    SUMOSAXAttributesImpl_Binary(const SUMOSAXAttributesImpl_Binary &src);
+
+    /// @brief Invalidated assignment operator.
+    SUMOSAXAttributesImpl_Binary &operator=(const SUMOSAXAttributesImpl_Binary &src);
+
+
+};
+
+
+#endif
+
+/****************************************************************************/
+